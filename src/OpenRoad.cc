@@ -84,6 +84,7 @@
 #include "triton_route/MakeTritonRoute.h"
 #include "utl/Logger.h"
 #include "utl/MakeLogger.h"
+#include "utl/MappedFileHandler.h"
 #include "utl/ScopedTemporaryFile.h"
 
 namespace sta {
@@ -314,6 +315,7 @@ void OpenRoad::readDef(const char* filename,
   if (continue_on_errors) {
     def_reader.continueOnErrors();
   }
+  def_reader.setThreads(threads_);
   dbBlock* block = nullptr;
   if (child) {
     auto parent = db_->getChip()->getBlock();
@@ -362,6 +364,7 @@ void OpenRoad::writeDef(const char* filename, const string& version)
     if (block) {
       odb::defout def_writer(logger_);
       def_writer.setVersion(stringToDefVersion(version));
+      def_writer.setThreads(threads_);
       def_writer.writeBlock(block, filename);
     }
   }
@@ -437,20 +440,18 @@ void OpenRoad::writeCdl(const char* outFilename,
   }
 }
 
-void OpenRoad::readDb(const char* filename)
+void OpenRoad::readDb(const char* filename, const bool lazy)
 {
   if (db_->getChip() && db_->getChip()->getBlock()) {
     logger_->error(
         ORD, 47, "You can't load a new db file as the db is already populated");
   }
 
-  std::ifstream stream;
-  stream.exceptions(std::ifstream::failbit | std::ifstream::badbit
-                    | std::ios::eofbit);
-  stream.open(filename, std::ios::binary);
+  // Map the file and decode it straight from memory.
+  utl::MappedFileHandler file(filename);
 
   try {
-    db_->read(stream);
+    db_->read(file.data(), file.size(), threads_, lazy);
   } catch (const std::ios_base::failure& f) {
     logger_->error(ORD, 54, "odb file {} is invalid: {}", filename, f.what());
   }
@@ -464,7 +465,7 @@ void OpenRoad::writeDb(const char* filename)
 {
   utl::StreamHandler stream_handler(filename, true);
 
-  db_->write(stream_handler.getStream());
+  db_->write(stream_handler.getStream(), threads_);
 }
 
 void OpenRoad::diffDbs(const char* filename1,
@@ -54,6 +54,7 @@
 #include <vector>
 
 #include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
 
 namespace utl {
 class Logger;
@@ -85,6 +86,7 @@ struct Pixel;
 
 class DplObserver;
 class Grid;
+class OpendpDbCbk;
 class GridInfo;
 class Padding;
 class PixelPt;
@@ -137,9 +139,19 @@ class Opendp
   void detailedPlacement(int max_displacement_x,
                          int max_displacement_y,
                          const std::string& report_file_name = std::string(""),
-                         bool disallow_one_site_gaps = false);
+                         bool disallow_one_site_gaps = false,
+                         bool row_bands = false,
+                         int threads = 1);
   void reportLegalizationStats() const;
 
+  // Incremental legalization. startIncremental builds the cells and
+  // grid once and keeps them in sync with instance creation, moves and
+  // deletion through db callbacks. legalizeIncremental only places the
+  // instances added or moved since the previous call.
+  void startIncremental();
+  void legalizeIncremental();
+  void endIncremental();
+
   void setPaddingGlobal(int left, int right);
   void setPadding(dbMaster* master, int left, int right);
   void setPadding(dbInst* inst, int left, int right);
@@ -182,6 +194,8 @@ class Opendp
 
   friend class OpendpTest_IsPlaced_Test;
   friend class Graphics;
+  friend class OpendpDbCbk;
+  void setMaxDisplacement(int max_displacement_x, int max_displacement_y);
   void findDisplacementStats();
   DbuPt pointOffMacro(const Cell& cell);
   void convertDbToCell(dbInst* db_inst, Cell& cell);
@@ -198,6 +212,7 @@ class Opendp
   void makeGroups();
   bool isMultiRow(const Cell* cell) const;
   void updateDbInstLocations();
+  void updateDbInstLocation(Cell& cell);
 
   void makeMaster(Master* master, dbMaster* db_master);
 
@@ -211,6 +226,12 @@ class Opendp
   static bool isInside(const Rect& cell, const Rect& box);
   bool isInside(const Cell* cell, const Rect& rect) const;
   PixelPt diamondSearch(const Cell* cell, GridX x, GridY y) const;
+  // Search restricted to bin rows in [row_min, row_max].
+  PixelPt diamondSearch(const Cell* cell,
+                        GridX x,
+                        GridY y,
+                        GridY row_min,
+                        GridY row_max) const;
   void diamondSearchSide(const Cell* cell,
                          GridX x,
                          GridY y,
@@ -229,6 +250,7 @@ class Opendp
                           GridY y,
                           GridX x_end,
                           GridY y_end) const;
+  bool pixelsUnoccupied(const Cell* cell, GridX x, GridY y) const;
   bool checkPixels(const Cell* cell,
                    GridX x,
                    GridY y,
@@ -255,6 +277,8 @@ class Opendp
   void prePlace();
   void prePlaceGroups();
   void place();
+  void placeRowBands(const vector<Cell*>& sorted_cells);
+  void placeIncremental(vector<Cell*>& cells);
   void placeGroups2();
   void brickPlace1(const Group* group);
   void brickPlace2(const Group* group);
@@ -345,6 +369,13 @@ class Opendp
                           std::vector<IRDrop>& ir_drops);
   void prepareDecapAndGaps();
 
+  // Incremental legalization
+  bool paintCellLocation(Cell* cell);
+  void incrInstCreate(dbInst* db_inst);
+  void incrInstDestroy(dbInst* db_inst);
+  void incrInstMove(dbInst* db_inst);
+  void incrMakeMaster(dbMaster* db_master);
+
   Logger* logger_ = nullptr;
   dbDatabase* db_ = nullptr;
   dbBlock* block_ = nullptr;
@@ -360,6 +391,8 @@ class Opendp
   int max_displacement_x_ = 0;  // sites
   int max_displacement_y_ = 0;  // sites
   bool disallow_one_site_gaps_ = false;
+  bool row_bands_ = false;
+  int threads_ = 1;
   vector<Cell*> placement_failures_;
 
   // 3D pixel grid
@@ -384,6 +417,15 @@ class Opendp
   int64_t displacement_sum_ = 0;
   int64_t displacement_max_ = 0;
 
+  // Incremental legalization.
+  std::unique_ptr<OpendpDbCbk> db_cbk_;
+  // Cells for instances created during the session.
+  vector<std::unique_ptr<Cell>> incr_cells_;
+  set<Cell*> dirty_cells_;
+  bool incremental_ = false;
+  // Set while writing locations back to ignore our own move callbacks.
+  bool updating_db_ = false;
+
   std::unique_ptr<DplObserver> debug_observer_;
   std::unique_ptr<Cell> dummy_cell_;
 
@@ -392,6 +434,24 @@ class Opendp
   static constexpr double group_refine_percent_ = .05;
   static constexpr double refine_percent_ = .02;
   static constexpr int rand_seed_ = 777;
+  // Parallel row band legalization.
+  static constexpr int band_rows_ = 32;
+  static constexpr int band_halo_rows_ = 1;
+};
+
+// Forwards instance changes to the incremental legalization session.
+class OpendpDbCbk : public odb::dbBlockCallBackObj
+{
+ public:
+  explicit OpendpDbCbk(Opendp* opendp);
+  void inDbInstCreate(dbInst* db_inst) override;
+  void inDbInstCreate(dbInst* db_inst, odb::dbRegion* region) override;
+  void inDbInstDestroy(dbInst* db_inst) override;
+  void inDbPostMoveInst(dbInst* db_inst) override;
+  void inDbInstSwapMasterAfter(dbInst* db_inst) override;
+
+ private:
+  Opendp* opendp_;
 };
 
 int divRound(int dividend, int divisor);
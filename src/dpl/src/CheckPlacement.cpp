@@ -350,7 +350,8 @@ bool Opendp::checkInRows(const Cell& cell) const
           || !pixel->is_valid) {
         return false;
       }
-      if (pixel->site != cell.getSite()) {
+      if (grid_->gridSite(grid_info.second.getGridIndex(), y)
+          != cell.getSite()) {
         return false;
       }
     }
@@ -328,34 +328,22 @@ void Grid::initGrid(dbDatabase* db,
 
   // Make pixel grid
   if (pixels_.empty()) {
-    resize(getInfoMap().size());
-    for (auto& [gmk, grid_info] : getInfoMap()) {
-      resize(grid_info.getGridIndex(), grid_info.getRowCount());
-    }
+    pixels_.resize(getInfoMap().size());
+    row_sites_.resize(getInfoMap().size());
   }
 
   for (auto& [gmk, grid_info] : getInfoMap()) {
     const GridY layer_row_count = grid_info.getRowCount();
     const GridX layer_row_site_count = grid_info.getSiteCount();
     const int index = grid_info.getGridIndex();
-    resize(index, layer_row_count);
-    for (GridY j{0}; j < layer_row_count; j++) {
-      resize(index, j, layer_row_site_count);
-      const auto& grid_sites = grid_info.getSites();
-      dbSite* row_site = nullptr;
-      if (!grid_sites.empty()) {
-        row_site = grid_sites[j.v % grid_sites.size()].site;
-      }
-
-      for (GridX k{0}; k < layer_row_site_count; k++) {
-        Pixel& pixel = pixels_[index][j.v][k.v];
-        pixel.cell = nullptr;
-        pixel.group = nullptr;
-        pixel.util = 0.0;
-        pixel.is_valid = false;
-        pixel.is_hopeless = false;
-        pixel.site = nullptr;
-        pixel.site = row_site;
+    pixels_[index].assign(
+        static_cast<size_t>(layer_row_count.v) * layer_row_site_count.v,
+        Pixel());
+    row_sites_[index].assign(layer_row_count.v, nullptr);
+    const auto& grid_sites = grid_info.getSites();
+    if (!grid_sites.empty()) {
+      for (GridY j{0}; j < layer_row_count; j++) {
+        row_sites_[index][j.v] = grid_sites[j.v % grid_sites.size()].site;
       }
     }
   }
@@ -446,8 +434,7 @@ void Grid::initGrid(dbDatabase* db,
     for (const auto& rect : rects) {
       for (int y = gtl::yl(rect); y < gtl::yh(rect); y++) {
         for (int x = gtl::xl(rect); x < gtl::xh(rect); x++) {
-          Pixel& pixel = pixels_[h_index][y][x];
-          pixel.is_hopeless = true;
+          pixel(h_index, GridY{y}, GridX{x}).is_hopeless = true;
         }
       }
     }
@@ -462,7 +449,8 @@ Pixel* Grid::gridPixel(int grid_idx, GridX grid_x, GridY grid_y) const
   const GridInfo* grid_info = grid_info_vector_[grid_idx];
   if (grid_x >= 0 && grid_x < grid_info->getSiteCount() && grid_y >= 0
       && grid_y < grid_info->getRowCount()) {
-    return const_cast<Pixel*>(&pixels_[grid_idx][grid_y.v][grid_x.v]);
+    return const_cast<Pixel*>(
+        &pixels_[grid_idx][pixelIndex(grid_idx, grid_y, grid_x)]);
   }
   return nullptr;
 }
@@ -61,15 +61,16 @@ struct DbuPoint
   DbuY y;
 };
 
+// Kept small because the grid has one per site. The site is the same for
+// every pixel in a row so it lives in Grid::gridSite.
 struct Pixel
 {
   Cell* cell = nullptr;
   Group* group = nullptr;
-  double util = 0.0;
+  float util = 0.0;
   dbOrientType orient_;
   bool is_valid = false;     // false for dummy cells
   bool is_hopeless = false;  // too far from sites for diamond search
-  dbSite* site = nullptr;    // site that this pixel is
 };
 
 // Return value for grid searches.
@@ -184,16 +185,22 @@ class Grid
                          bool start) const;
 
   Pixel* gridPixel(int grid_idx, GridX x, GridY y) const;
-  Pixel& pixel(int g, GridY y, GridX x) { return pixels_[g][y.v][x.v]; }
+  Pixel& pixel(int g, GridY y, GridX x)
+  {
+    return pixels_[g][pixelIndex(g, y, x)];
+  }
   const Pixel& pixel(int g, GridY y, GridX x) const
   {
-    return pixels_[g][y.v][x.v];
+    return pixels_[g][pixelIndex(g, y, x)];
   }
+  // Site of the pixels in row y of grid g.
+  dbSite* gridSite(int g, GridY y) const { return row_sites_[g][y.v]; }
 
-  void resize(int size) { pixels_.resize(size); }
-  void resize(int g, GridY size) { pixels_[g].resize(size.v); }
-  void resize(int g, GridY y, GridX size) { pixels_[g][y.v].resize(size.v); }
-  void clear() { pixels_.clear(); }
+  void clear()
+  {
+    pixels_.clear();
+    row_sites_.clear();
+  }
 
   GridInfo& infoMap(const GridMapKey& key) { return grid_info_map_.at(key); }
   const GridInfo& infoMap(const GridMapKey& key) const
@@ -225,11 +232,18 @@ class Grid
   void addInfoMap(const GridMapKey& key, const GridInfo& info);
   void visitDbRows(dbBlock* block,
                    const std::function<void(odb::dbRow*)>& func) const;
+  size_t pixelIndex(int g, GridY y, GridX x) const
+  {
+    return static_cast<size_t>(y.v) * grid_info_vector_[g]->getSiteCount().v
+           + x.v;
+  }
 
   Logger* logger_ = nullptr;
   dbBlock* block_ = nullptr;
   std::shared_ptr<Padding> padding_;
-  std::vector<std::vector<std::vector<Pixel>>> pixels_;
+  // One row major block of pixels per grid layer.
+  std::vector<std::vector<Pixel>> pixels_;
+  std::vector<std::vector<dbSite*>> row_sites_;
   std::vector<const GridInfo*> grid_info_vector_;
   map<GridMapKey, GridInfo> grid_info_map_;
   std::unordered_map<dbSite*, dbSite*> hybrid_parent_;  // child -> parent
@@ -0,0 +1,257 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "Grid.h"
+#include "Objects.h"
+#include "dpl/Opendp.h"
+#include "utl/Logger.h"
+
+namespace dpl {
+
+using std::vector;
+
+using utl::DPL;
+
+void Opendp::startIncremental()
+{
+  importDb();
+  setMaxDisplacement(0, 0);
+  placement_failures_.clear();
+  initGrid();
+  setFixedGridCells();
+  groupInitPixels2();
+  groupInitPixels();
+  if (!groups_.empty()) {
+    groupAssignCellRegions();
+  }
+  // Keep cells that are already legal where they are.
+  for (Cell& cell : cells_) {
+    if (!cell.isFixed() && !paintCellLocation(&cell)) {
+      dirty_cells_.insert(&cell);
+    }
+  }
+  db_cbk_->addOwner(block_);
+  incremental_ = true;
+  debugPrint(logger_,
+             DPL,
+             "incremental",
+             1,
+             "{} of {} cells need legalization",
+             dirty_cells_.size(),
+             cells_.size());
+}
+
+void Opendp::legalizeIncremental()
+{
+  if (!incremental_) {
+    logger_->error(DPL, 58, "Incremental legalization has not been started.");
+  }
+  vector<Cell*> cells(dirty_cells_.begin(), dirty_cells_.end());
+  dirty_cells_.clear();
+  placement_failures_.clear();
+  placeIncremental(cells);
+
+  // Retry the failures on the next call.
+  dirty_cells_.insert(placement_failures_.begin(), placement_failures_.end());
+  if (!dirty_cells_.empty()) {
+    logger_->warn(DPL,
+                  57,
+                  "Incremental legalization failed on {} instances.",
+                  dirty_cells_.size());
+  }
+
+  // shiftMove can move neighbors of the dirty cells so check every cell.
+  // Only the ones that changed are written to the db.
+  updating_db_ = true;
+  for (Cell& cell : cells_) {
+    if (cell.db_inst_) {
+      updateDbInstLocation(cell);
+    }
+  }
+  for (auto& cell : incr_cells_) {
+    if (cell->db_inst_) {
+      updateDbInstLocation(*cell);
+    }
+  }
+  updating_db_ = false;
+  // Failed neighbors moved by shiftMove can be dirty without being in cells.
+  const int legalized_count
+      = std::count_if(cells.begin(), cells.end(), [this](Cell* cell) {
+          return dirty_cells_.find(cell) == dirty_cells_.end();
+        });
+  debugPrint(logger_,
+             DPL,
+             "incremental",
+             1,
+             "Legalized {} cells",
+             legalized_count);
+}
+
+void Opendp::endIncremental()
+{
+  db_cbk_->removeOwner();
+  dirty_cells_.clear();
+  incremental_ = false;
+}
+
+// Paint cell at its current location if that location is legal.
+bool Opendp::paintCellLocation(Cell* cell)
+{
+  if (!grid_->cellFitsInCore(cell)) {
+    return false;
+  }
+  const DbuX x = cell->x_;
+  const DbuY y = cell->y_;
+  const GridX grid_x = grid_->gridPaddedX(cell);
+  const GridY grid_y = grid_->gridY(cell);
+  // Off site or off row cells do not map back to the same location.
+  grid_->setGridPaddedLoc(cell, grid_x, grid_y);
+  if (cell->x_ != x || cell->y_ != y
+      || !checkPixels(cell,
+                      grid_x,
+                      grid_y,
+                      grid_x + grid_->gridPaddedWidth(cell),
+                      grid_y + grid_->gridHeight(cell))) {
+    cell->x_ = x;
+    cell->y_ = y;
+    return false;
+  }
+  grid_->paintPixel(cell, grid_x, grid_y);
+  return true;
+}
+
+void Opendp::incrInstCreate(dbInst* db_inst)
+{
+  dbMaster* db_master = db_inst->getMaster();
+  if (!db_master->isCoreAutoPlaceable()) {
+    return;
+  }
+  incrMakeMaster(db_master);
+  incr_cells_.push_back(std::make_unique<Cell>());
+  Cell* cell = incr_cells_.back().get();
+  convertDbToCell(db_inst, *cell);
+  db_inst_map_[db_inst] = cell;
+  if (cell->isFixed()) {
+    cell->is_placed_ = true;
+    grid_->visitCellPixels(
+        *cell, true, [&](Pixel* pixel) { setGridCell(*cell, pixel); });
+  } else {
+    dirty_cells_.insert(cell);
+  }
+}
+
+void Opendp::incrInstDestroy(dbInst* db_inst)
+{
+  auto itr = db_inst_map_.find(db_inst);
+  if (itr == db_inst_map_.end()) {
+    return;
+  }
+  Cell* cell = itr->second;
+  if (cell->isFixed()) {
+    grid_->visitCellPixels(*cell, true, [](Pixel* pixel) {
+      pixel->cell = nullptr;
+      pixel->util = 0.0;
+    });
+  } else {
+    grid_->erasePixel(cell);
+  }
+  dirty_cells_.erase(cell);
+  db_inst_map_.erase(itr);
+  // The cell may live in cells_ so keep it but drop the dead instance.
+  cell->db_inst_ = nullptr;
+}
+
+void Opendp::incrInstMove(dbInst* db_inst)
+{
+  if (updating_db_) {
+    return;
+  }
+  auto itr = db_inst_map_.find(db_inst);
+  if (itr == db_inst_map_.end()) {
+    return;
+  }
+  Cell* cell = itr->second;
+  // Fixed instances are not expected to move during a session.
+  if (cell->isFixed()) {
+    return;
+  }
+  grid_->erasePixel(cell);
+  // A master swap can bring in a master the session has not seen.
+  incrMakeMaster(db_inst->getMaster());
+  convertDbToCell(db_inst, *cell);
+  dirty_cells_.insert(cell);
+}
+
+void Opendp::incrMakeMaster(dbMaster* db_master)
+{
+  if (db_master_map_.find(db_master) == db_master_map_.end()) {
+    makeMaster(&db_master_map_[db_master], db_master);
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+OpendpDbCbk::OpendpDbCbk(Opendp* opendp) : opendp_(opendp)
+{
+}
+
+void OpendpDbCbk::inDbInstCreate(dbInst* db_inst)
+{
+  opendp_->incrInstCreate(db_inst);
+}
+
+void OpendpDbCbk::inDbInstCreate(dbInst* db_inst, odb::dbRegion* region)
+{
+  opendp_->incrInstCreate(db_inst);
+}
+
+void OpendpDbCbk::inDbInstDestroy(dbInst* db_inst)
+{
+  opendp_->incrInstDestroy(db_inst);
+}
+
+void OpendpDbCbk::inDbPostMoveInst(dbInst* db_inst)
+{
+  opendp_->incrInstMove(db_inst);
+}
+
+void OpendpDbCbk::inDbInstSwapMasterAfter(dbInst* db_inst)
+{
+  opendp_->incrInstMove(db_inst);
+}
+
+}  // namespace dpl
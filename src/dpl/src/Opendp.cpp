@@ -80,6 +80,7 @@ Opendp::Opendp()
 {
   dummy_cell_ = std::make_unique<Cell>();
   dummy_cell_->is_placed_ = true;
+  db_cbk_ = std::make_unique<OpendpDbCbk>(this);
 }
 
 Opendp::~Opendp() = default;
@@ -116,7 +117,9 @@ void Opendp::setDebug(std::unique_ptr<DplObserver>& observer)
 void Opendp::detailedPlacement(const int max_displacement_x,
                                const int max_displacement_y,
                                const std::string& report_file_name,
-                               const bool disallow_one_site_gaps)
+                               const bool disallow_one_site_gaps,
+                               const bool row_bands,
+                               const int threads)
 {
   importDb();
 
@@ -124,15 +127,10 @@ void Opendp::detailedPlacement(const int max_displacement_x,
     logger_->warn(DPL, 37, "Use remove_fillers before detailed placement.");
   }
 
-  if (max_displacement_x == 0 || max_displacement_y == 0) {
-    // defaults
-    max_displacement_x_ = 500;
-    max_displacement_y_ = 100;
-  } else {
-    max_displacement_x_ = max_displacement_x;
-    max_displacement_y_ = max_displacement_y;
-  }
+  setMaxDisplacement(max_displacement_x, max_displacement_y);
   disallow_one_site_gaps_ = disallow_one_site_gaps;
+  row_bands_ = row_bands;
+  threads_ = threads;
   if (!have_one_site_cells_) {
     // If 1-site fill cell is not detected && no disallow_one_site_gaps flag:
     // warn the user then continue as normal
@@ -166,22 +164,40 @@ void Opendp::detailedPlacement(const int max_displacement_x,
   }
 }
 
+void Opendp::setMaxDisplacement(const int max_displacement_x,
+                                const int max_displacement_y)
+{
+  if (max_displacement_x == 0 || max_displacement_y == 0) {
+    // defaults
+    max_displacement_x_ = 500;
+    max_displacement_y_ = 100;
+  } else {
+    max_displacement_x_ = max_displacement_x;
+    max_displacement_y_ = max_displacement_y;
+  }
+}
+
 void Opendp::updateDbInstLocations()
 {
   for (Cell& cell : cells_) {
-    if (!cell.isFixed() && cell.isStdCell()) {
-      dbInst* db_inst_ = cell.db_inst_;
-      // Only move the instance if necessary to avoid triggering callbacks.
-      if (db_inst_->getOrient() != cell.orient_) {
-        db_inst_->setOrient(cell.orient_);
-      }
-      const DbuX x = grid_->getCore().xMin() + cell.x_;
-      const DbuY y = grid_->getCore().yMin() + cell.y_;
-      int inst_x, inst_y;
-      db_inst_->getLocation(inst_x, inst_y);
-      if (x != inst_x || y != inst_y) {
-        db_inst_->setLocation(x.v, y.v);
-      }
+    updateDbInstLocation(cell);
+  }
+}
+
+void Opendp::updateDbInstLocation(Cell& cell)
+{
+  if (!cell.isFixed() && cell.isStdCell()) {
+    dbInst* db_inst_ = cell.db_inst_;
+    // Only move the instance if necessary to avoid triggering callbacks.
+    if (db_inst_->getOrient() != cell.orient_) {
+      db_inst_->setOrient(cell.orient_);
+    }
+    const DbuX x = grid_->getCore().xMin() + cell.x_;
+    const DbuY y = grid_->getCore().yMin() + cell.y_;
+    int inst_x, inst_y;
+    db_inst_->getLocation(inst_x, inst_y);
+    if (x != inst_x || y != inst_y) {
+      db_inst_->setLocation(x.v, y.v);
     }
   }
 }
@@ -98,9 +98,11 @@ void
 detailed_placement_cmd(int max_displacment_x,
                        int max_displacment_y,
                        bool disallow_one_site_gaps,
+                       bool row_bands,
                        const char* report_file_name){
   dpl::Opendp *opendp = ord::OpenRoad::openRoad()->getOpendp();
-  opendp->detailedPlacement(max_displacment_x, max_displacment_y, std::string(report_file_name), disallow_one_site_gaps);
+  const int threads = ord::OpenRoad::openRoad()->getThreadCount();
+  opendp->detailedPlacement(max_displacment_x, max_displacment_y, std::string(report_file_name), disallow_one_site_gaps, row_bands, threads);
 }
 
 void
@@ -117,6 +119,27 @@ check_placement_cmd(bool verbose, bool disallow_one_site_gaps, const char* repor
   opendp->checkPlacement(verbose, disallow_one_site_gaps, std::string(report_file_name));
 }
 
+void
+start_incremental()
+{
+  dpl::Opendp *opendp = ord::OpenRoad::openRoad()->getOpendp();
+  opendp->startIncremental();
+}
+
+void
+legalize_incremental()
+{
+  dpl::Opendp *opendp = ord::OpenRoad::openRoad()->getOpendp();
+  opendp->legalizeIncremental();
+}
+
+void
+end_incremental()
+{
+  dpl::Opendp *opendp = ord::OpenRoad::openRoad()->getOpendp();
+  opendp->endIncremental();
+}
+
 
 void
 set_padding_global(int left,
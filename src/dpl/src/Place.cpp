@@ -49,6 +49,7 @@
 #include "Padding.h"
 #include "dpl/Opendp.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 // #define ODP_DEBUG
 
@@ -343,8 +344,11 @@ void Opendp::place()
       }
     }
   }
+  if (row_bands_ && !debug_observer_ && grid_->getInfoMap().size() == 1) {
+    placeRowBands(sorted_cells);
+  }
   for (Cell* cell : sorted_cells) {
-    if (!isMultiRow(cell)) {
+    if (!isMultiRow(cell) && !cell->is_placed_) {
       if (!mapMove(cell)) {
         shiftMove(cell);
       }
@@ -352,6 +356,115 @@ void Opendp::place()
   }
 }
 
+// Split the rows into bands of band_rows_ and legalize the single row
+// cells of each band concurrently. The search for a cell is confined to
+// the interior of its band so no two bands read or paint the same pixels
+// (the one site gap check looks one row above and below, which the halo
+// rows absorb). Cells targeting a halo row, or that do not fit inside
+// their band, are left unplaced for the serial pass in place() which
+// resolves them against the whole grid with the usual checks.
+void Opendp::placeRowBands(const vector<Cell*>& sorted_cells)
+{
+  const GridInfo& grid_info = grid_->getInfoMap().begin()->second;
+  const int row_count = grid_info.getRowCount().v;
+  const int band_count = divCeil(row_count, band_rows_);
+  if (band_count < 2) {
+    return;
+  }
+
+  vector<vector<std::pair<Cell*, GridPt>>> band_cells(band_count);
+  for (Cell* cell : sorted_cells) {
+    if (isMultiRow(cell) || cell->is_placed_) {
+      continue;
+    }
+    const GridPt grid_pt = legalGridPt(cell, true);
+    const int band = grid_pt.y.v / band_rows_;
+    const int band_row = grid_pt.y.v % band_rows_;
+    const bool first = band == 0;
+    const bool last = band == band_count - 1;
+    if ((first || band_row >= band_halo_rows_)
+        && (last || band_row < band_rows_ - band_halo_rows_)) {
+      band_cells[band].emplace_back(cell, grid_pt);
+    }
+  }
+
+  // Nothing is logged from the workers. Cells whose pixels are already
+  // taken are collected and reported once the bands are done.
+  vector<vector<Cell*>> band_failures(band_count);
+  utl::ThreadException exception;
+  int placed_count = 0;
+#pragma omp parallel for num_threads(threads_) schedule(dynamic, 1) \
+    reduction(+ : placed_count)
+  for (int band = 0; band < band_count; band++) {
+    try {
+      const int band_begin = band * band_rows_;
+      const int band_end = std::min(band_begin + band_rows_, row_count);
+      const GridY row_min{band == 0 ? band_begin
+                                    : band_begin + band_halo_rows_};
+      // Exclusive upper row bound, like the row count diamondSearch
+      // defaults to.
+      const GridY row_max{band == band_count - 1
+                              ? band_end
+                              : band_end - band_halo_rows_};
+      for (auto& [cell, grid_pt] : band_cells[band]) {
+        const PixelPt pixel_pt
+            = diamondSearch(cell, grid_pt.x, grid_pt.y, row_min, row_max);
+        if (!pixel_pt.pixel) {
+          continue;
+        }
+        if (!pixelsUnoccupied(cell, pixel_pt.x, pixel_pt.y)) {
+          band_failures[band].push_back(cell);
+          continue;
+        }
+        grid_->paintPixel(cell, pixel_pt.x, pixel_pt.y);
+        placed_count++;
+      }
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+
+  int failure_count = 0;
+  const Cell* failed_cell = nullptr;
+  for (const vector<Cell*>& failures : band_failures) {
+    if (!failures.empty() && failed_cell == nullptr) {
+      failed_cell = failures.front();
+    }
+    failure_count += failures.size();
+  }
+  if (failed_cell) {
+    logger_->error(DPL,
+                   59,
+                   "Cannot paint grid with cell {} and {} other cells in row "
+                   "bands because it is already occupied.",
+                   failed_cell->name(),
+                   failure_count - 1);
+  }
+  debugPrint(logger_,
+             DPL,
+             "place",
+             1,
+             "Placed {} cells in {} row bands",
+             placed_count,
+             band_count);
+}
+
+void Opendp::placeIncremental(vector<Cell*>& cells)
+{
+  sort(cells.begin(), cells.end(), CellPlaceOrderLess(grid_->getCore()));
+  // Place multi-row instances first.
+  for (const bool multi_row : {true, false}) {
+    for (Cell* cell : cells) {
+      if (isMultiRow(cell) == multi_row && !cell->is_placed_) {
+        if (!mapMove(cell)) {
+          shiftMove(cell);
+        }
+      }
+    }
+  }
+}
+
 void Opendp::placeGroups2()
 {
   for (Group& group : groups_) {
@@ -587,7 +700,7 @@ bool Opendp::mapMove(Cell* cell, const GridPt& grid_pt)
              cell->y_,
              pixel_pt.x,
              pixel_pt.y,
-             pixel_pt.pixel->site->getName());
+             cell->getSite()->getName());
   if (pixel_pt.pixel) {
     grid_->paintPixel(cell, pixel_pt.x, pixel_pt.y);
     if (debug_observer_) {
@@ -709,6 +822,16 @@ int Opendp::distChange(const Cell* cell, const DbuX x, const DbuY y) const
 PixelPt Opendp::diamondSearch(const Cell* cell,
                               const GridX x,
                               const GridY y) const
+{
+  const auto& grid_info = grid_->infoMap(grid_->getGridMapKey(cell));
+  return diamondSearch(cell, x, y, GridY{0}, grid_info.getRowCount());
+}
+
+PixelPt Opendp::diamondSearch(const Cell* cell,
+                              const GridX x,
+                              const GridY y,
+                              const GridY row_min,
+                              const GridY row_max) const
 {
   // Diamond search limits.
   GridX x_min = x - max_displacement_x_;
@@ -747,9 +870,9 @@ PixelPt Opendp::diamondSearch(const Cell* cell,
 
   // Clip diamond limits to grid bounds.
   x_min = max(GridX{0}, x_min);
-  y_min = max(GridY{0}, y_min);
+  y_min = max(row_min, y_min);
   x_max = min(grid_info.getSiteCount(), x_max);
-  y_max = min(grid_info.getRowCount(), y_max);
+  y_max = min(row_max, y_max);
   debugPrint(logger_,
              DPL,
              "place",
@@ -981,6 +1104,25 @@ bool Opendp::checkRegionOverlap(const Cell* cell,
 }
 
 // Check all pixels are empty.
+// Non-logging version of the occupancy check in Grid::paintPixel.
+bool Opendp::pixelsUnoccupied(const Cell* cell,
+                              const GridX x,
+                              const GridY y) const
+{
+  const int layer = grid_->getRowInfo(cell).second.getGridIndex();
+  const GridX x_end = x + grid_->gridPaddedWidth(cell);
+  const GridY y_end = y + grid_->gridHeight(cell);
+  for (GridY y1 = y; y1 < y_end; y1++) {
+    for (GridX x1 = x; x1 < x_end; x1++) {
+      const Pixel* pixel = grid_->gridPixel(layer, x1, y1);
+      if (pixel == nullptr || pixel->cell) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 bool Opendp::checkPixels(const Cell* cell,
                          const GridX x,
                          const GridY y,
@@ -998,15 +1140,22 @@ bool Opendp::checkPixels(const Cell* cell,
   const auto cell_site = cell->getSite();
   const int layer = row_info.second.getGridIndex();
   for (GridY y1 = y; y1 < y_end; y1++) {
+    const dbSite* row_site = nullptr;
     for (GridX x1 = x; x1 < x_end; x1++) {
       const Pixel* pixel = grid_->gridPixel(layer, x1, y1);
-      if (pixel == nullptr || pixel->cell || !pixel->is_valid
+      if (pixel == nullptr) {
+        return false;
+      }
+      if (row_site == nullptr) {
+        row_site = grid_->gridSite(layer, y1);
+      }
+      if (pixel->cell || !pixel->is_valid
           || (cell->inGroup() && pixel->group != cell->group_)
           || (!cell->inGroup() && pixel->group)
-          || (pixel->site != nullptr && pixel->site != cell_site)) {
+          || (row_site != nullptr && row_site != cell_site)) {
         return false;
       }
-      if (pixel->site == nullptr) {
+      if (row_site == nullptr) {
         logger_->error(DPL, 1599, "Pixel site is null");
       }
     }
@@ -73,6 +73,9 @@ void Opendp::importDb()
 
 void Opendp::importClear()
 {
+  // The cells of an incremental session are about to be rebuilt.
+  endIncremental();
+  incr_cells_.clear();
   db_master_map_.clear();
   cells_.clear();
   groups_.clear();
@@ -0,0 +1,48 @@
+# incremental legalization after an instance move, a master swap and an
+# instance create and destroy
+source "helpers.tcl"
+read_lef Nangate45/Nangate45.lef
+read_def gcd_replace.def
+detailed_placement
+
+proc overlaps { inst1 inst2 } {
+  set box1 [$inst1 getBBox]
+  set box2 [$inst2 getBBox]
+  return [expr [$box1 xMin] < [$box2 xMax] && [$box2 xMin] < [$box1 xMax] \
+            && [$box1 yMin] < [$box2 yMax] && [$box2 yMin] < [$box1 yMax]]
+}
+
+set block [ord::get_db_block]
+set inst1 [$block findInst _278_]
+set inst2 [$block findInst _280_]
+
+# Move an instance off site on top of another one.
+dpl::start_incremental
+set box2 [$inst2 getBBox]
+$inst1 setLocation [expr [$box2 xMin] + 10] [$box2 yMin]
+dpl::legalize_incremental
+dpl::end_incremental
+check_placement
+puts "moved instance overlaps: [overlaps $inst1 $inst2]"
+
+# Swap in a wider master.
+dpl::start_incremental
+set inst3 [$block findInst _281_]
+$inst3 swapMaster [[ord::get_db] findMaster INV_X16]
+dpl::legalize_incremental
+dpl::end_incremental
+check_placement
+puts "swapped master: [[$inst3 getMaster] getName]"
+
+# Create an instance on top of another one and destroy a third.
+dpl::start_incremental
+set inst4 [odb::dbInst_create $block [[ord::get_db] findMaster BUF_X1] new_buf]
+set box2 [$inst2 getBBox]
+$inst4 setPlacementStatus PLACED
+$inst4 setLocation [$box2 xMin] [$box2 yMin]
+odb::dbInst_destroy [$block findInst _282_]
+dpl::legalize_incremental
+dpl::end_incremental
+check_placement
+puts "created instance overlaps: [overlaps $inst4 $inst2]"
+puts "destroyed instance found: [expr { [$block findInst _282_] != "NULL" }]"
@@ -31,6 +31,7 @@ record_tests {
   hybrid_cells
   hybrid_cells2
   ibex
+  incremental1
   max_disp1
   mirror1
   mirror2
@@ -52,6 +53,7 @@ record_tests {
   regions2
   regions3
   report_failures
+  row_bands
   simple01
   simple02
   simple03
@@ -0,0 +1,40 @@
+# detailed_placement -row_bands legality and thread count independence
+source "helpers.tcl"
+read_lef Nangate45/Nangate45.lef
+read_def aes_cipher_top_replace.def
+
+set block [ord::get_db_block]
+set init_locs {}
+foreach inst [$block getInsts] {
+  set box [$inst getBBox]
+  lappend init_locs [list [$box xMin] [$box yMin] [$inst getPlacementStatus]]
+}
+
+proc place_row_bands { threads } {
+  global block init_locs
+  foreach inst [$block getInsts] loc $init_locs {
+    lassign $loc x y status
+    $inst setLocation $x $y
+    $inst setPlacementStatus $status
+  }
+  set_thread_count $threads
+  # The command without the legalization report.
+  dpl::detailed_placement_cmd 0 0 0 1 ""
+  check_placement
+  set locs {}
+  foreach inst [$block getInsts] {
+    set box [$inst getBBox]
+    lappend locs [list [$box xMin] [$box yMin] [$inst getOrient]]
+  }
+  return $locs
+}
+
+set locs1 [place_row_bands 1]
+set locs4 [place_row_bands 4]
+set diff_count 0
+foreach loc1 $locs1 loc4 $locs4 {
+  if { $loc1 != $loc4 } {
+    incr diff_count
+  }
+}
+puts "instances placed differently with 1 and 4 threads: $diff_count"
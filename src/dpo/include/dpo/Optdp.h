@@ -79,7 +79,9 @@ class Optdp
   void improvePlacement(int seed,
                         int max_displacement_x,
                         int max_displacement_y,
-                        bool disallow_one_site_gaps = false);
+                        bool disallow_one_site_gaps = false,
+                        bool parallel_reorder = false,
+                        int threads = 1);
 
  private:
   void import();
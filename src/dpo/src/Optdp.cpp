@@ -94,7 +94,9 @@ void Optdp::init(odb::dbDatabase* db, utl::Logger* logger, dpl::Opendp* opendp)
 void Optdp::improvePlacement(const int seed,
                              const int max_displacement_x,
                              const int max_displacement_y,
-                             const bool disallow_one_site_gaps)
+                             const bool disallow_one_site_gaps,
+                             const bool parallel_reorder,
+                             const int threads)
 {
   logger_->report("Detailed placement improvement.");
 
@@ -116,6 +118,8 @@ void Optdp::improvePlacement(const int seed,
   mgr.setSeed(seed);
   mgr.setMaxDisplacement(max_displacement_x, max_displacement_y);
   mgr.setDisallowOneSiteGaps(disallow_one_site_gaps);
+  mgr.setParallelReorder(parallel_reorder);
+  mgr.setNumThreads(threads);
 
   // Legalization.  Doesn't particularly do much.  It only
   // populates the data structures required for detailed
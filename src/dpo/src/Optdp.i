@@ -46,11 +46,17 @@
   void improve_placement_cmd(int seed,
                              int max_displacement_x,
                              int max_displacement_y,
-                             bool disallow_one_site_gaps)
+                             bool disallow_one_site_gaps,
+                             bool parallel_reorder)
   {
     dpo::Optdp* optdp = ord::OpenRoad::openRoad()->getOptdp();
-    optdp->improvePlacement(
-        seed, max_displacement_x, max_displacement_y, disallow_one_site_gaps);
+    const int threads = ord::OpenRoad::openRoad()->getThreadCount();
+    optdp->improvePlacement(seed,
+                            max_displacement_x,
+                            max_displacement_y,
+                            disallow_one_site_gaps,
+                            parallel_reorder,
+                            threads);
   }
 
   }  // namespace dpo
@@ -34,17 +34,20 @@ sta::define_cmd_args "improve_placement" {\
     [-random_seed seed]\
     [-max_displacement disp|{disp_x disp_y}]\
     [-disallow_one_site_gaps]\
+    [-parallel_reorder]\
 }
 
 proc improve_placement { args } {
   sta::parse_key_args "improve_placement" args \
-    keys {-random_seed -max_displacement} flags {-disallow_one_site_gaps}
+    keys {-random_seed -max_displacement} \
+    flags {-disallow_one_site_gaps -parallel_reorder}
 
   if { [ord::get_db_block] == "NULL" } {
     utl::error DPO 2 "No design block found."
   }
 
   set disallow_one_site_gaps [info exists flags(-disallow_one_site_gaps)]
+  set parallel_reorder [info exists flags(-parallel_reorder)]
   set seed 1
   if { [info exists keys(-random_seed)] } {
     set seed $keys(-random_seed)
@@ -69,7 +72,8 @@ proc improve_placement { args } {
   }
 
   sta::check_argc_eq0 "improve_placement" $args
-  dpo::improve_placement_cmd $seed $max_displacement_x $max_displacement_y $disallow_one_site_gaps
+  dpo::improve_placement_cmd $seed $max_displacement_x $max_displacement_y \
+    $disallow_one_site_gaps $parallel_reorder
 }
 
 namespace eval dpo {
@@ -41,6 +41,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 // Includes.
 ////////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -99,6 +100,10 @@ class DetailedMgr
   int getMaxDisplacementX() const { return maxDispX_; }
   int getMaxDisplacementY() const { return maxDispY_; }
   bool getDisallowOneSiteGaps() const { return disallowOneSiteGaps_; }
+  void setNumThreads(int threads) { numThreads_ = std::max(1, threads); }
+  int getNumThreads() const { return numThreads_; }
+  void setParallelReorder(bool parallel) { parallelReorder_ = parallel; }
+  bool getParallelReorder() const { return parallelReorder_; }
   double measureMaximumDisplacement(double& maxX,
                                     double& maxY,
                                     int& violatedX,
@@ -362,6 +367,8 @@ class DetailedMgr
   int maxDispX_;
   int maxDispY_;
   bool disallowOneSiteGaps_;
+  int numThreads_ = 1;
+  bool parallelReorder_ = false;
   std::vector<Node*> fixedCells_;  // Fixed; filler, macros, temporary, etc.
 
   // Blockages and segments.
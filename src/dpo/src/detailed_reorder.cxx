@@ -34,6 +34,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "detailed_reorder.h"
 
+#include <omp.h>
+
 #include <boost/tokenizer.hpp>
 
 #include "architecture.h"
@@ -131,61 +133,158 @@ void DetailedReorderer::run(DetailedMgr* mgrPtr,
 ///////////////////////////////////////////////////////////////////////////////
 void DetailedReorderer::reorder()
 {
-  traversal_ = 0;
-  edgeMask_.resize(network_->getNumEdges());
-  std::fill(edgeMask_.begin(), edgeMask_.end(), traversal_);
+  if (mgrPtr_->getParallelReorder()) {
+    reorderWindowed(mgrPtr_->getNumThreads());
+    return;
+  }
+
+  edgeMask_.traversal = 0;
+  edgeMask_.mask.assign(network_->getNumEdges(), edgeMask_.traversal);
 
   // Loop over each segment; find single height cells and reorder.
   for (int s = 0; s < mgrPtr_->getNumSegments(); s++) {
-    DetailedSeg* segPtr = mgrPtr_->getSegment(s);
-    const int segId = segPtr->getSegId();
-    const int rowId = segPtr->getRowId();
+    reorderSegment(s, edgeMask_);
+  }
+}
 
-    const std::vector<Node*>& nodes = mgrPtr_->getCellsInSeg(segId);
-    if (nodes.size() < 2) {
-      continue;
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+void DetailedReorderer::reorderWindowed(const int threads)
+{
+  // Segments of the same color share no nets, so the windows in them
+  // neither move the same cells nor see each other's moves in cost().
+  // Colors run one after another; the segments of a color run
+  // concurrently. The pass hpwl is recomputed by run() afterwards.
+  std::vector<std::vector<int>> colors;
+  colorSegments(colors);
+
+  std::vector<EdgeMask> edgeMasks(threads);
+  for (EdgeMask& edgeMask : edgeMasks) {
+    edgeMask.mask.assign(network_->getNumEdges(), edgeMask.traversal);
+  }
+  for (const std::vector<int>& segs : colors) {
+#pragma omp parallel for num_threads(threads) schedule(dynamic, 1)
+    for (int i = 0; i < (int) segs.size(); i++) {
+      reorderSegment(segs[i], edgeMasks[omp_get_thread_num()]);
     }
-    mgrPtr_->sortCellsInSeg(segId);
+  }
+}
 
-    int j = 0;
-    const int n = (int) nodes.size();
-    while (j < n) {
-      while (j < n && arch_->isMultiHeightCell(nodes[j])) {
-        ++j;
-      }
-      const int jstrt = j;
-      while (j < n && arch_->isSingleHeightCell(nodes[j])) {
-        ++j;
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+void DetailedReorderer::colorSegments(
+    std::vector<std::vector<int>>& colors) const
+{
+  // Greedy coloring of the graph with an arc between two segments when
+  // a net considered by cost() has a single height cell in both.
+  const int numSegs = mgrPtr_->getNumSegments();
+  std::vector<std::vector<int>> edgeSegs(network_->getNumEdges());
+  std::vector<std::vector<int>> segEdges(numSegs);
+  for (int s = 0; s < numSegs; s++) {
+    const int segId = mgrPtr_->getSegment(s)->getSegId();
+    for (const Node* ndi : mgrPtr_->getCellsInSeg(segId)) {
+      if (!arch_->isSingleHeightCell(ndi)) {
+        continue;
       }
-      const int jstop = j - 1;
-
-      // Single height cells in [jstrt,jstop].
-      for (int i = jstrt; i + windowSize_ <= jstop; ++i) {
-        int istrt = i;
-        const int istop = std::min(jstop, istrt + windowSize_ - 1);
-        if (istop == jstop) {
-          istrt = std::max(jstrt, istop - windowSize_ + 1);
+      for (int pi = 0; pi < ndi->getNumPins(); pi++) {
+        const Edge* edi = ndi->getPins()[pi]->getEdge();
+        const int npins = edi->getNumPins();
+        if (npins <= 1 || npins >= skipNetsLargerThanThis_) {
+          continue;
         }
-
-        const Node* nextPtr = (istop != n - 1) ? nodes[istop + 1] : nullptr;
-        int rightLimit = segPtr->getMaxX();
-        if (nextPtr != nullptr) {
-          int leftPadding, rightPadding;
-          arch_->getCellPadding(nextPtr, leftPadding, rightPadding);
-          rightLimit = std::min(
-              (int) std::floor(nextPtr->getLeft() - leftPadding), rightLimit);
+        std::vector<int>& segs = edgeSegs[edi->getId()];
+        if (segs.empty() || segs.back() != s) {
+          segs.push_back(s);
+          segEdges[s].push_back(edi->getId());
         }
-        const Node* prevPtr = (istrt != 0) ? nodes[istrt - 1] : nullptr;
-        int leftLimit = segPtr->getMinX();
-        if (prevPtr != nullptr) {
-          int leftPadding, rightPadding;
-          arch_->getCellPadding(prevPtr, leftPadding, rightPadding);
-          leftLimit = std::max(
-              (int) std::ceil(prevPtr->getRight() + rightPadding), leftLimit);
+      }
+    }
+  }
+
+  colors.clear();
+  std::vector<int> segColor(numSegs, -1);
+  // Last segment that found each color taken by a neighbor.
+  std::vector<int> colorUsedBy;
+  for (int s = 0; s < numSegs; s++) {
+    for (const int e : segEdges[s]) {
+      for (const int t : edgeSegs[e]) {
+        if (segColor[t] != -1) {
+          colorUsedBy[segColor[t]] = s;
         }
+      }
+    }
+    int c = 0;
+    while (c < (int) colorUsedBy.size() && colorUsedBy[c] == s) {
+      ++c;
+    }
+    if (c == (int) colorUsedBy.size()) {
+      colorUsedBy.push_back(-1);
+      colors.emplace_back();
+    }
+    segColor[s] = c;
+    colors[c].push_back(s);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+void DetailedReorderer::reorderSegment(const int s, EdgeMask& edgeMask)
+{
+  DetailedSeg* segPtr = mgrPtr_->getSegment(s);
+  const int segId = segPtr->getSegId();
+  const int rowId = segPtr->getRowId();
+
+  const std::vector<Node*>& nodes = mgrPtr_->getCellsInSeg(segId);
+  if (nodes.size() < 2) {
+    return;
+  }
+  mgrPtr_->sortCellsInSeg(segId);
+
+  int j = 0;
+  const int n = (int) nodes.size();
+  while (j < n) {
+    while (j < n && arch_->isMultiHeightCell(nodes[j])) {
+      ++j;
+    }
+    const int jstrt = j;
+    while (j < n && arch_->isSingleHeightCell(nodes[j])) {
+      ++j;
+    }
+    const int jstop = j - 1;
+
+    // Single height cells in [jstrt,jstop].
+    for (int i = jstrt; i + windowSize_ <= jstop; ++i) {
+      int istrt = i;
+      const int istop = std::min(jstop, istrt + windowSize_ - 1);
+      if (istop == jstop) {
+        istrt = std::max(jstrt, istop - windowSize_ + 1);
+      }
 
-        reorder(nodes, istrt, istop, leftLimit, rightLimit, segId, rowId);
+      const Node* nextPtr = (istop != n - 1) ? nodes[istop + 1] : nullptr;
+      int rightLimit = segPtr->getMaxX();
+      if (nextPtr != nullptr) {
+        int leftPadding, rightPadding;
+        arch_->getCellPadding(nextPtr, leftPadding, rightPadding);
+        rightLimit = std::min(
+            (int) std::floor(nextPtr->getLeft() - leftPadding), rightLimit);
       }
+      const Node* prevPtr = (istrt != 0) ? nodes[istrt - 1] : nullptr;
+      int leftLimit = segPtr->getMinX();
+      if (prevPtr != nullptr) {
+        int leftPadding, rightPadding;
+        arch_->getCellPadding(prevPtr, leftPadding, rightPadding);
+        leftLimit = std::max(
+            (int) std::ceil(prevPtr->getRight() + rightPadding), leftLimit);
+      }
+
+      reorder(nodes,
+              istrt,
+              istop,
+              leftLimit,
+              rightLimit,
+              segId,
+              rowId,
+              edgeMask);
     }
   }
 }
@@ -198,7 +297,8 @@ void DetailedReorderer::reorder(const std::vector<Node*>& nodes,
                                 const int leftLimit,
                                 const int rightLimit,
                                 const int segId,
-                                const int rowId)
+                                const int rowId,
+                                EdgeMask& edgeMask)
 {
   const int size = jstop - jstrt + 1;
 
@@ -262,7 +362,7 @@ void DetailedReorderer::reorder(const std::vector<Node*>& nodes,
   // might be different.  So, just consider the first permutation
   // like all the others.
 
-  double bestCost = cost(nodes, jstrt, jstop);
+  double bestCost = cost(nodes, jstrt, jstop, edgeMask);
   const double origCost = bestCost;
 
   std::vector<int> bestPosn(size, 0);  // Current positions.
@@ -291,7 +391,7 @@ void DetailedReorderer::reorder(const std::vector<Node*>& nodes,
       }
     }
     if (dispOkay) {
-      const double currCost = cost(nodes, jstrt, jstop);
+      const double currCost = cost(nodes, jstrt, jstop, edgeMask);
       if (currCost < bestCost) {
         bestPosn = currPosn;
         bestCost = currCost;
@@ -349,7 +449,7 @@ void DetailedReorderer::reorder(const std::vector<Node*>& nodes,
       // interval.  However, we might have shifted something.
       if (shifted) {
         // Recost.  The shifting might have changed the cost.
-        const double lastCost = cost(nodes, jstrt, jstop);
+        const double lastCost = cost(nodes, jstrt, jstop, edgeMask);
         if (lastCost >= origCost) {
           failed = true;
         }
@@ -371,11 +471,12 @@ void DetailedReorderer::reorder(const std::vector<Node*>& nodes,
 ////////////////////////////////////////////////////////////////////////////////
 double DetailedReorderer::cost(const std::vector<Node*>& nodes,
                                const int istrt,
-                               const int istop)
+                               const int istop,
+                               EdgeMask& edgeMask) const
 {
   // Compute hpwl for the specified sequence of cells.
 
-  ++traversal_;
+  ++edgeMask.traversal;
 
   double cost = 0.;
   for (int i = istrt; i <= istop; i++) {
@@ -390,10 +491,10 @@ double DetailedReorderer::cost(const std::vector<Node*>& nodes,
       if (npins <= 1 || npins >= skipNetsLargerThanThis_) {
         continue;
       }
-      if (edgeMask_[edi->getId()] == traversal_) {
+      if (edgeMask.mask[edi->getId()] == edgeMask.traversal) {
         continue;
       }
-      edgeMask_[edi->getId()] = traversal_;
+      edgeMask.mask[edi->getId()] = edgeMask.traversal;
 
       double xmin = std::numeric_limits<double>::max();
       double xmax = -std::numeric_limits<double>::max();
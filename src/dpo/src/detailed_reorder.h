@@ -52,15 +52,29 @@ class DetailedReorderer
   void run(DetailedMgr* mgrPtr, const std::vector<std::string>& args);
 
  private:
+  // Marks the nets already counted by cost(); one per thread.
+  struct EdgeMask
+  {
+    std::vector<int> mask;
+    int traversal = 0;
+  };
+
   void reorder();
+  void reorderWindowed(int threads);
+  void colorSegments(std::vector<std::vector<int>>& colors) const;
+  void reorderSegment(int s, EdgeMask& edgeMask);
   void reorder(const std::vector<Node*>& nodes,
                int jstrt,
                int jstop,
                int leftLimit,
                int rightLimit,
                int segId,
-               int rowId);
-  double cost(const std::vector<Node*>& nodes, int istrt, int istop);
+               int rowId,
+               EdgeMask& edgeMask);
+  double cost(const std::vector<Node*>& nodes,
+              int istrt,
+              int istop,
+              EdgeMask& edgeMask) const;
 
   // Standard stuff.
   Architecture* arch_;
@@ -71,8 +85,7 @@ class DetailedReorderer
 
   // Other.
   int skipNetsLargerThanThis_ = 100;
-  std::vector<int> edgeMask_;
-  int traversal_ = 0;
+  EdgeMask edgeMask_;
   int windowSize_ = 3;
 };
 
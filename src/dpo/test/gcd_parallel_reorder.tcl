@@ -0,0 +1,41 @@
+# improve_placement -parallel_reorder legality and thread count independence
+source "helpers.tcl"
+read_lef Nangate45/Nangate45.lef
+read_def gcd.def
+
+set block [ord::get_db_block]
+set init_locs {}
+foreach inst [$block getInsts] {
+  set box [$inst getBBox]
+  lappend init_locs [list [$box xMin] [$box yMin] [$inst getOrient]]
+}
+
+proc improve_parallel_reorder { threads } {
+  global block init_locs
+  foreach inst [$block getInsts] loc $init_locs {
+    lassign $loc x y orient
+    $inst setLocation $x $y
+    $inst setOrient $orient
+  }
+  set_thread_count $threads
+  improve_placement -parallel_reorder
+  check_placement
+  set locs {}
+  foreach inst [$block getInsts] {
+    set box [$inst getBBox]
+    lappend locs [list [$box xMin] [$box yMin] [$inst getOrient]]
+  }
+  return $locs
+}
+
+set locs1 [improve_parallel_reorder 1]
+set locs4 [improve_parallel_reorder 4]
+foreach inst [$block getInsts] loc1 $locs1 loc4 $locs4 {
+  if { $loc1 != $loc4 } {
+    puts "[$inst getName] placed at $loc1 with 1 thread and $loc4 with 4"
+    exit 1
+  }
+}
+
+puts "pass"
+exit
@@ -8,3 +8,7 @@ record_tests {
     regions1
     regions2
 }
+
+record_pass_fail_tests {
+    gcd_parallel_reorder
+}
@@ -99,6 +99,8 @@ struct ParamStruct
   int minAccessPoints = -1;
   bool saveGuideUpdates = false;
   std::string repairPDNLayerName;
+  bool dynamicSchedulingDR = false;
+  bool radixWavefrontDR = false;
 };
 
 class TritonRoute
@@ -166,6 +168,20 @@ class TritonRoute
   // for debugging and not general usage.
   std::string runDRWorker(const std::string& workerStr, FlexDRViaData* viaData);
   void debugSingleWorker(const std::string& dumpDir, const std::string& drcRpt);
+  void setRadixWavefront(bool on);
+  // Restores the design and globals a worker was dumped with by
+  // detailed_route_debug -dump_dr.
+  void loadWorkerDump(const std::string& dumpDir, const std::string& workerDir);
+  // Replays dumped workers without committing their results and writes
+  // per worker routing time and maze expansions to jsonFile.  Up to
+  // numThreads workers dumped from the same design state are routed
+  // concurrently.  The memory reported for a worker is the change in the
+  // resident size of the whole process while it ran, which includes the
+  // workers running beside it; use one thread to measure single workers.
+  void benchmarkWorkers(const std::string& dumpDir,
+                        const std::vector<std::string>& workerDirs,
+                        int numThreads,
+                        const std::string& jsonFile);
   void updateGlobals(const char* file_name);
   void resetDb(const char* file_name);
   void clearDesign();
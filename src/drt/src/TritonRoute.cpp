@@ -28,12 +28,15 @@
 
 #include "triton_route/TritonRoute.h"
 
+#include <algorithm>
 #include <boost/asio/post.hpp>
 #include <boost/bind/bind.hpp>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 
 #include "DesignCallBack.h"
+#include "db/infra/frTime.h"
 #include "db/tech/frTechObject.h"
 #include "distributed/PinAccessJobDescription.h"
 #include "distributed/RoutingCallBack.h"
@@ -57,6 +60,7 @@
 #include "sta/StaMain.hh"
 #include "stt/SteinerTreeBuilder.h"
 #include "ta/FlexTA.h"
+#include "utl/exception.h"
 
 namespace sta {
 // Tcl files encoded into strings.
@@ -227,6 +231,209 @@ std::string TritonRoute::runDRWorker(const std::string& workerStr,
   return result;
 }
 
+void TritonRoute::setRadixWavefront(bool on)
+{
+  RADIX_WAVEFRONT = on;
+}
+
+// Overrides set by detailed_route_worker_debug
+static void applyDebugWorkerParams(FlexDRWorker* worker,
+                                   const frDebugSettings* debug)
+{
+  if (debug->mazeEndIter != -1) {
+    worker->setMazeEndIter(debug->mazeEndIter);
+  }
+  if (debug->markerCost != -1) {
+    worker->setMarkerCost(debug->markerCost);
+  }
+  if (debug->drcCost != -1) {
+    worker->setDrcCost(debug->drcCost);
+  }
+  if (debug->fixedShapeCost != -1) {
+    worker->setFixedShapeCost(debug->fixedShapeCost);
+  }
+  if (debug->markerDecay != -1) {
+    worker->setMarkerDecay(debug->markerDecay);
+  }
+  if (debug->ripupMode != -1) {
+    worker->setRipupMode(getMode(debug->ripupMode));
+  }
+  if (debug->followGuide != -1) {
+    worker->setFollowGuide((debug->followGuide == 1));
+  }
+}
+
+void TritonRoute::loadWorkerDump(const std::string& dumpDir,
+                                 const std::string& workerDir)
+{
+  updateGlobals(fmt::format("{}/init_globals.bin", dumpDir).c_str());
+  resetDb(fmt::format("{}/design.odb", dumpDir).c_str());
+  updateGlobals(
+      fmt::format("{}/{}/globals.bin", dumpDir, workerDir).c_str());
+  updateDesign(fmt::format("{}/{}/updates.bin", dumpDir, workerDir));
+  updateGlobals(
+      fmt::format("{}/{}/worker_globals.bin", dumpDir, workerDir).c_str());
+}
+
+namespace {
+
+std::string readFile(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+}
+
+// Workers dumped from the same design state with the same globals (e.g.
+// from one batch) can be routed concurrently against one restored design.
+bool sameWorkerSnapshot(const std::string& dumpDir,
+                        const std::string& workerDir1,
+                        const std::string& workerDir2)
+{
+  for (const char* file :
+       {"globals.bin", "updates.bin", "worker_globals.bin"}) {
+    if (readFile(fmt::format("{}/{}/{}", dumpDir, workerDir1, file))
+        != readFile(fmt::format("{}/{}/{}", dumpDir, workerDir2, file))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string jsonString(const std::string& str)
+{
+  std::string quoted = "\"";
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        quoted += "\\\"";
+        break;
+      case '\\':
+        quoted += "\\\\";
+        break;
+      case '\n':
+        quoted += "\\n";
+        break;
+      case '\t':
+        quoted += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          quoted += fmt::format("\\u{:04x}", static_cast<int>(c));
+        } else {
+          quoted += c;
+        }
+    }
+  }
+  return quoted + "\"";
+}
+
+}  // namespace
+
+void TritonRoute::benchmarkWorkers(const std::string& dumpDir,
+                                   const std::vector<std::string>& workerDirs,
+                                   int numThreads,
+                                   const std::string& jsonFile)
+{
+  std::ofstream json(jsonFile);
+  if (!json.good()) {
+    logger_->error(DRT, 618, "Unable to open {} for writing.", jsonFile);
+  }
+  numThreads = std::max(numThreads, 1);
+  json << "{\n"
+       << fmt::format("  \"dump_dir\": {},\n", jsonString(dumpDir))
+       << fmt::format("  \"threads\": {},\n", numThreads)
+       << fmt::format("  \"wavefront\": \"{}\",\n",
+                      RADIX_WAVEFRONT ? "radix" : "binary_heap")
+       << "  \"workers\": [";
+
+  struct Result
+  {
+    double routeTime = 0;
+    uint64_t expansions = 0;
+    int initMarkers = 0;
+    int bestMarkers = 0;
+    // process-wide, so it includes the concurrently routed workers
+    int64_t processRssDelta = 0;
+  };
+  double totalTime = 0;
+  for (size_t begin = 0; begin < workerDirs.size();) {
+    // Route up to numThreads workers that share a snapshot side by side.
+    size_t end = begin + 1;
+    while (end < workerDirs.size() && end - begin < (size_t) numThreads
+           && sameWorkerSnapshot(dumpDir, workerDirs[begin], workerDirs[end])) {
+      end++;
+    }
+    loadWorkerDump(dumpDir, workerDirs[begin]);
+    {
+      io::Writer writer(this, logger_);
+      writer.updateTrackAssignment(db_->getChip()->getBlock());
+    }
+
+    // Workers are routed against the restored, read-only design; their
+    // results are not committed.
+    std::vector<Result> results(end - begin);
+    utl::ThreadException exception;
+#pragma omp parallel for num_threads(end - begin) schedule(static)
+    for (size_t i = begin; i < end; i++) {
+      try {
+        const std::string workerPath
+            = fmt::format("{}/{}", dumpDir, workerDirs[i]);
+        const int64_t rssBefore = getCurrentRSS();
+        FlexDRViaData viaData;
+        std::ifstream viaDataFile(fmt::format("{}/viadata.bin", workerPath),
+                                  std::ios::binary);
+        frIArchive ar(viaDataFile);
+        ar >> viaData;
+        auto worker
+            = FlexDRWorker::load(readFile(workerPath + "/worker.bin"),
+                                 logger_,
+                                 design_.get(),
+                                 nullptr);
+        applyDebugWorkerParams(worker.get(), debug_.get());
+        worker->setSharedVolume(shared_volume_);
+        worker->setDebugSettings(debug_.get());
+        worker->setViaData(&viaData);
+        worker->reloadedMain();
+        Result& result = results[i - begin];
+        result.routeTime = worker->getRouteTime();
+        result.expansions = worker->getGridGraph().getNumExpansions();
+        result.initMarkers = worker->getInitNumMarkers();
+        result.bestMarkers = worker->getBestNumMarkers();
+        result.processRssDelta = (int64_t) getCurrentRSS() - rssBefore;
+      } catch (...) {
+        exception.capture();
+      }
+    }
+    exception.rethrow();
+
+    for (size_t i = begin; i < end; i++) {
+      const Result& result = results[i - begin];
+      totalTime += result.routeTime;
+      json << (i == 0 ? "\n" : ",\n") << "    {"
+           << fmt::format("\"worker\": {}, ", jsonString(workerDirs[i]))
+           << fmt::format("\"route_time_s\": {:.6f}, ", result.routeTime)
+           << fmt::format("\"maze_expansions\": {}, ", result.expansions)
+           << fmt::format("\"init_markers\": {}, ", result.initMarkers)
+           << fmt::format("\"final_markers\": {}, ", result.bestMarkers)
+           << fmt::format("\"process_rss_delta_mb\": {:.1f}, ",
+                          result.processRssDelta / (1024.0 * 1024.0))
+           << fmt::format("\"concurrent_workers\": {}", end - begin)
+           << "}";
+      logger_->report("{:<30} {:>10.3f}s {:>12} expansions",
+                      workerDirs[i],
+                      result.routeTime,
+                      result.expansions);
+    }
+    begin = end;
+  }
+  json << (workerDirs.empty() ? "],\n" : "\n  ],\n")
+       << fmt::format("  \"total_route_time_s\": {:.6f},\n", totalTime)
+       << fmt::format("  \"peak_rss_mb\": {}\n",
+                      getPeakRSS() / (1024 * 1024))
+       << "}\n";
+}
+
 void TritonRoute::debugSingleWorker(const std::string& dumpDir,
                                     const std::string& drcRpt)
 {
@@ -252,34 +459,25 @@ void TritonRoute::debugSingleWorker(const std::string& dumpDir,
   workerFile.close();
   auto worker
       = FlexDRWorker::load(workerStr, logger_, design_.get(), graphics_.get());
-  if (debug_->mazeEndIter != -1) {
-    worker->setMazeEndIter(debug_->mazeEndIter);
-  }
-  if (debug_->markerCost != -1) {
-    worker->setMarkerCost(debug_->markerCost);
-  }
-  if (debug_->drcCost != -1) {
-    worker->setDrcCost(debug_->drcCost);
-  }
-  if (debug_->fixedShapeCost != -1) {
-    worker->setFixedShapeCost(debug_->fixedShapeCost);
-  }
-  if (debug_->markerDecay != -1) {
-    worker->setMarkerDecay(debug_->markerDecay);
-  }
-  if (debug_->ripupMode != -1) {
-    worker->setRipupMode(getMode(debug_->ripupMode));
-  }
-  if (debug_->followGuide != -1) {
-    worker->setFollowGuide((debug_->followGuide == 1));
-  }
+  applyDebugWorkerParams(worker.get(), debug_.get());
   worker->setSharedVolume(shared_volume_);
   worker->setDebugSettings(debug_.get());
   worker->setViaData(&viaData);
   if (graphics_) {
     graphics_->startIter(worker->getDRIter());
   }
+  const auto start = std::chrono::steady_clock::now();
   std::string result = worker->reloadedMain();
+  const std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+  debugPrint(logger_,
+             utl::DRT,
+             "replay",
+             1,
+             "Worker {} routed in {:.3f}s ({} wavefront).",
+             dumpDir,
+             elapsed.count(),
+             RADIX_WAVEFRONT ? "radix" : "binary heap");
   bool updated = worker->end(design_.get());
   debugPrint(logger_,
              utl::DRT,
@@ -1345,6 +1543,8 @@ void TritonRoute::setParams(const ParamStruct& params)
   }
   SAVE_GUIDE_UPDATES = params.saveGuideUpdates;
   REPAIR_PDN_LAYER_NAME = params.repairPDNLayerName;
+  DYNAMIC_SCHEDULING_DR = params.dynamicSchedulingDR;
+  RADIX_WAVEFRONT = params.radixWavefrontDR;
 }
 
 void TritonRoute::addWorkerResults(
@@ -36,6 +36,7 @@
 %{
 
 #include <cstring>
+#include <sstream>
 #include "ord/OpenRoad.hh"
 #include "triton_route/TritonRoute.h"
 #include "utl/Logger.h"
@@ -95,7 +96,9 @@ void detailed_route_cmd(const char* outputMazeFile,
                         int minAccessPoints,
                         bool saveGuideUpdates,
                         const char* repairPDNLayerName,
-                        int drcReportIterStep)
+                        int drcReportIterStep,
+                        bool dynamicSchedulingDR,
+                        bool radixWavefrontDR)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
   std::optional<int> drcReportIterStepOpt;
@@ -122,7 +125,9 @@ void detailed_route_cmd(const char* outputMazeFile,
                     singleStepDR,
                     minAccessPoints,
                     saveGuideUpdates,
-                    repairPDNLayerName});
+                    repairPDNLayerName,
+                    dynamicSchedulingDR,
+                    radixWavefrontDR});
   router->main();
   router->setDistributed(false);
 }
@@ -200,18 +205,35 @@ set_worker_debug_params(int maze_end_iter,
 }
 
 void
-run_worker_cmd(const char* dump_dir, const char* worker_dir, const char* drc_rpt)
+run_worker_cmd(const char* dump_dir,
+               const char* worker_dir,
+               const char* drc_rpt,
+               bool radix_wavefront)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
-  router->updateGlobals(fmt::format("{}/init_globals.bin", dump_dir).c_str());
-  router->resetDb(fmt::format("{}/design.odb", dump_dir).c_str());
-  router->updateGlobals(fmt::format("{}/{}/globals.bin", dump_dir, worker_dir).c_str());
-  router->updateDesign(fmt::format("{}/{}/updates.bin", dump_dir, worker_dir).c_str());
-  router->updateGlobals(fmt::format("{}/{}/worker_globals.bin", dump_dir, worker_dir).c_str());
-  
+  router->setRadixWavefront(radix_wavefront);
+  router->loadWorkerDump(dump_dir, worker_dir);
   router->debugSingleWorker(fmt::format("{}/{}", dump_dir, worker_dir), drc_rpt);
 }
 
+void
+benchmark_workers_cmd(const char* dump_dir,
+                      const char* worker_dirs,
+                      int threads,
+                      const char* json_file,
+                      bool radix_wavefront)
+{
+  auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
+  std::vector<std::string> dirs;
+  std::istringstream stream(worker_dirs);
+  std::string dir;
+  while (stream >> dir) {
+    dirs.push_back(dir);
+  }
+  router->setRadixWavefront(radix_wavefront);
+  router->benchmarkWorkers(dump_dir, dirs, threads, json_file);
+}
+
 void detailed_route_step_drt(int size,
                              int offset,
                              int mazeEndIter,
@@ -58,6 +58,8 @@ sta::define_cmd_args "detailed_route" {
     [-no_pin_access]
     [-min_access_points count]
     [-save_guide_updates]
+    [-dynamic_scheduling]
+    [-radix_wavefront]
     [-repair_pdn_vias layer]
     [-single_step_dr]
 }
@@ -70,7 +72,8 @@ proc detailed_route { args } {
       -top_routing_layer -verbose -remote_host -remote_port -shared_volume \
       -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step} \
     flags {-disable_via_gen -distributed -clean_patches -no_pin_access \
-           -single_step_dr -save_guide_updates}
+           -single_step_dr -save_guide_updates -dynamic_scheduling \
+           -radix_wavefront}
   sta::check_argc_eq0 "detailed_route" $args
 
   set enable_via_gen [expr ![info exists flags(-disable_via_gen)]]
@@ -80,6 +83,8 @@ proc detailed_route { args } {
   # development.  It is not listed in the help string intentionally.
   set single_step_dr [expr [info exists flags(-single_step_dr)]]
   set save_guide_updates [expr [info exists flags(-save_guide_updates)]]
+  set dynamic_scheduling [expr [info exists flags(-dynamic_scheduling)]]
+  set radix_wavefront [expr [info exists flags(-radix_wavefront)]]
 
   if { [info exists keys(-repair_pdn_vias)] } {
     set repair_pdn_vias $keys(-repair_pdn_vias)
@@ -197,7 +202,8 @@ proc detailed_route { args } {
     $via_in_pin_bottom_layer $via_in_pin_top_layer \
     $or_seed $or_k $bottom_routing_layer $top_routing_layer $verbose \
     $clean_patches $no_pin_access $single_step_dr $min_access_points \
-    $save_guide_updates $repair_pdn_vias $drc_report_iter_step
+    $save_guide_updates $repair_pdn_vias $drc_report_iter_step \
+    $dynamic_scheduling $radix_wavefront
 }
 
 proc detailed_route_num_drvs { args } {
@@ -363,12 +369,13 @@ sta::define_cmd_args "detailed_route_run_worker" {
     [-dump_dir dir]
     [-worker_dir dir]
     [-drc_rpt drc]
+    [-radix_wavefront]
 };# checker off
 
 proc detailed_route_run_worker { args } {
   sta::parse_key_args "detailed_route_run_worker" args \
     keys {-dump_dir -worker_dir -drc_rpt} \
-    flags {};# checker off
+    flags {-radix_wavefront};# checker off
   sta::check_argc_eq0 "detailed_route_run_worker" $args
   if { [info exists keys(-dump_dir)] } {
     set dump_dir $keys(-dump_dir)
@@ -387,7 +394,53 @@ proc detailed_route_run_worker { args } {
   } else {
     set drc_rpt ""
   }
-  drt::run_worker_cmd $dump_dir $worker_dir $drc_rpt
+  set radix_wavefront [expr [info exists flags(-radix_wavefront)]]
+  drt::run_worker_cmd $dump_dir $worker_dir $drc_rpt $radix_wavefront
+}
+
+sta::define_cmd_args "detailed_route_benchmark_workers" {
+    [-dump_dir dir]
+    [-worker_dirs dirs]
+    [-threads count]
+    [-output_json file]
+    [-radix_wavefront]
+};# checker off
+
+proc detailed_route_benchmark_workers { args } {
+  sta::parse_key_args "detailed_route_benchmark_workers" args \
+    keys {-dump_dir -worker_dirs -threads -output_json} \
+    flags {-radix_wavefront};# checker off
+  sta::check_argc_eq0 "detailed_route_benchmark_workers" $args
+  if { [info exists keys(-dump_dir)] } {
+    set dump_dir $keys(-dump_dir)
+  } else {
+    utl::error DRT 556 "-dump_dir is required for detailed_route_benchmark_workers command"
+  }
+
+  if { [info exists keys(-worker_dirs)] } {
+    set worker_dirs $keys(-worker_dirs)
+  } else {
+    set worker_dirs {}
+    foreach path [lsort [glob -nocomplain -type d $dump_dir/worker*]] {
+      lappend worker_dirs [file tail $path]
+    }
+  }
+
+  if { [info exists keys(-threads)] } {
+    set threads $keys(-threads)
+    sta::check_positive_integer "-threads" $threads
+  } else {
+    set threads 1
+  }
+
+  if { [info exists keys(-output_json)] } {
+    set output_json $keys(-output_json)
+  } else {
+    set output_json $dump_dir/benchmark.json
+  }
+  set radix_wavefront [expr [info exists flags(-radix_wavefront)]]
+  drt::benchmark_workers_cmd $dump_dir $worker_dirs $threads $output_json \
+    $radix_wavefront
 }
 
 sta::define_cmd_args "detailed_route_worker_debug" {
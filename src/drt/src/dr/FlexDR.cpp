@@ -35,9 +35,11 @@
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/io/ios_state.hpp>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 
@@ -50,6 +52,7 @@
 #include "dst/BalancerJobDescription.h"
 #include "dst/Distributed.h"
 #include "frProfileTask.h"
+#include "frRTree.h"
 #include "gc/FlexGC.h"
 #include "io/io.h"
 #include "ord/OpenRoad.hh"
@@ -140,7 +143,11 @@ std::string FlexDRWorker::reloadedMain()
              "Init number of markers {}",
              getInitNumMarkers());
   if (!skipRouting_) {
+    const auto start = std::chrono::steady_clock::now();
     route_queue();
+    const std::chrono::duration<double> elapsed
+        = std::chrono::steady_clock::now() - start;
+    routeTime_ = elapsed.count();
   }
   setGCWorker(nullptr);
   cleanup();
@@ -214,6 +221,12 @@ int FlexDRWorker::main(frDesign* design)
                     routeBox_.xMax() * micronPerDBU,
                     routeBox_.yMax() * micronPerDBU);
   }
+  // Only the init phase reads the shared design.  The routing phase works
+  // on the worker's private copy, so other workers may commit meanwhile.
+  std::shared_lock<std::shared_mutex> design_lock;
+  if (design_mutex_) {
+    design_lock = std::shared_lock<std::shared_mutex>(*design_mutex_);
+  }
   initMarkers(design);
   if (getDRIter() && getInitNumMarkers() == 0 && !needRecheck_) {
     skipRouting_ = true;
@@ -265,6 +278,9 @@ int FlexDRWorker::main(frDesign* design)
   if (!skipRouting_) {
     init(design);
   }
+  if (design_lock.owns_lock()) {
+    design_lock.unlock();
+  }
   high_resolution_clock::time_point t1 = high_resolution_clock::now();
   if (!skipRouting_) {
     route_queue();
@@ -556,18 +572,200 @@ void FlexDR::getBatchInfo(int& batchStepX, int& batchStepY)
   batchStepY = 2;
 }
 
+Rect FlexDR::getWorkerRouteBox(int x_offset, int y_offset, int size) const
+{
+  auto gCellPatterns = getDesign()->getTopBlock()->getGCellPatterns();
+  auto& xgp = gCellPatterns.at(0);
+  auto& ygp = gCellPatterns.at(1);
+  Rect routeBox1
+      = getDesign()->getTopBlock()->getGCellBox(Point(x_offset, y_offset));
+  const int max_i = std::min((int) xgp.getCount() - 1, x_offset + size - 1);
+  const int max_j = std::min((int) ygp.getCount(), y_offset + size - 1);
+  Rect routeBox2 = getDesign()->getTopBlock()->getGCellBox(Point(max_i, max_j));
+  return Rect(
+      routeBox1.xMin(), routeBox1.yMin(), routeBox2.xMax(), routeBox2.yMax());
+}
+
+bool FlexDR::isCleanRegion(const Rect& routeBox) const
+{
+  Rect drcBox;
+  routeBox.bloat(DRCSAFEDIST, drcBox);
+  std::vector<frMarker*> result;
+  getRegionQuery()->queryMarker(drcBox, result);
+  return result.empty();
+}
+
+std::unique_ptr<FlexDRWorker> FlexDR::createWorker(int x_offset,
+                                                   int y_offset,
+                                                   const Rect& routeBox,
+                                                   const SearchRepairArgs& args,
+                                                   int iter)
+{
+  auto gCellPatterns = getDesign()->getTopBlock()->getGCellPatterns();
+  auto& xgp = gCellPatterns.at(0);
+  auto& ygp = gCellPatterns.at(1);
+  const int max_i
+      = std::min((int) xgp.getCount() - 1, x_offset + args.size - 1);
+  const int max_j = std::min((int) ygp.getCount(), y_offset + args.size - 1);
+  auto worker = std::make_unique<FlexDRWorker>(&via_data_, design_, logger_);
+  Rect extBox;
+  Rect drcBox;
+  routeBox.bloat(MTSAFEDIST, extBox);
+  routeBox.bloat(DRCSAFEDIST, drcBox);
+  worker->setRouteBox(routeBox);
+  worker->setExtBox(extBox);
+  worker->setDrcBox(drcBox);
+  worker->setGCellBox(Rect(x_offset, y_offset, max_i, max_j));
+  worker->setMazeEndIter(args.mazeEndIter);
+  worker->setDRIter(iter);
+  worker->setDebugSettings(router_->getDebugSettings());
+  if (dist_on_) {
+    worker->setDistributed(dist_, dist_ip_, dist_port_, dist_dir_);
+  }
+  if (!iter) {
+    // set boundary pin
+    auto bp = initDR_mergeBoundaryPin(x_offset, y_offset, args.size, routeBox);
+    worker->setDRIter(0, bp);
+  }
+  worker->setRipupMode(args.ripupMode);
+  worker->setFollowGuide(args.followGuide);
+  // TODO: only pass to relevant workers
+  worker->setGraphics(graphics_.get());
+  worker->setCost(args.workerDRCCost,
+                  args.workerMarkerCost,
+                  args.workerFixedShapeCost,
+                  args.workerMarkerDecay);
+  return worker;
+}
+
+// Runs the workers without batch barriers.  A worker is dispatched as soon
+// as no worker whose extBox overlaps its own is running; among the ready
+// workers the lowest priority value (the checkerboard batch) goes first so
+// the order stays close to the batched one.  Each worker commits its result
+// under an exclusive design lock as soon as it finishes.  makeWorker may
+// return nullptr for tiles that need no routing; their count is returned.
+int FlexDR::processWorkersDynamic(
+    const std::vector<Rect>& extBoxes,
+    const std::vector<int>& priorities,
+    const std::function<std::unique_ptr<FlexDRWorker>(int)>& makeWorker,
+    const std::function<void()>& workerDone)
+{
+  ProfileTask profile("DR:dynamic");
+  const int numWorkers = extBoxes.size();
+  if (numWorkers == 0) {
+    return 0;
+  }
+
+  // conflict graph from actual worker region overlap
+  std::vector<std::vector<int>> conflicts(numWorkers);
+  {
+    RTree<int> extBoxTree;
+    for (int i = 0; i < numWorkers; i++) {
+      extBoxTree.insert(std::make_pair(extBoxes[i], i));
+    }
+    std::vector<std::pair<Rect, int>> result;
+    for (int i = 0; i < numWorkers; i++) {
+      result.clear();
+      extBoxTree.query(bgi::intersects(extBoxes[i]),
+                       std::back_inserter(result));
+      for (const auto& [box, j] : result) {
+        if (j != i) {
+          conflicts[i].push_back(j);
+        }
+      }
+    }
+  }
+
+  enum class WorkerState
+  {
+    PENDING,
+    RUNNING,
+    DONE
+  };
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::vector<WorkerState> states(numWorkers, WorkerState::PENDING);
+  // number of running workers overlapping each worker
+  std::vector<int> numBlockers(numWorkers, 0);
+  std::set<std::pair<int, int>> ready;
+  for (int i = 0; i < numWorkers; i++) {
+    ready.emplace(priorities[i], i);
+  }
+  int remaining = numWorkers;
+  int numSkipped = 0;
+  bool abort = false;
+
+  ThreadException exception;
+#pragma omp parallel
+  {
+    while (true) {
+      int idx;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock,
+                  [&] { return abort || remaining == 0 || !ready.empty(); });
+        if (abort || ready.empty()) {
+          break;
+        }
+        idx = ready.begin()->second;
+        ready.erase(ready.begin());
+        states[idx] = WorkerState::RUNNING;
+        for (int j : conflicts[idx]) {
+          if (numBlockers[j]++ == 0 && states[j] == WorkerState::PENDING) {
+            ready.erase({priorities[j], j});
+          }
+        }
+      }
+      try {
+        std::unique_ptr<FlexDRWorker> worker;
+        {
+          std::shared_lock<std::shared_mutex> design_lock(design_mutex_);
+          worker = makeWorker(idx);
+        }
+        if (worker) {
+          worker->setDesignMutex(&design_mutex_);
+          worker->main(getDesign());
+        }
+        std::unique_lock<std::shared_mutex> design_lock(design_mutex_);
+        if (!worker) {
+          numSkipped++;
+        } else {
+          if (worker->end(getDesign())) {
+            numWorkUnits_ += 1;
+          }
+          if (worker->isCongested()) {
+            increaseClipsize_ = true;
+          }
+        }
+        workerDone();
+      } catch (...) {
+        exception.capture();
+        std::unique_lock<std::mutex> lock(mutex);
+        abort = true;
+      }
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        states[idx] = WorkerState::DONE;
+        remaining--;
+        for (int j : conflicts[idx]) {
+          if (--numBlockers[j] == 0 && states[j] == WorkerState::PENDING) {
+            ready.emplace(priorities[j], j);
+          }
+        }
+      }
+      cond.notify_all();
+    }
+  }
+  exception.rethrow();
+  return numSkipped;
+}
+
 void FlexDR::searchRepair(const SearchRepairArgs& args)
 {
   const int iter = iter_++;
   const int size = args.size;
   const int offset = args.offset;
-  const int mazeEndIter = args.mazeEndIter;
-  const frUInt4 workerDRCCost = args.workerDRCCost;
-  const frUInt4 workerMarkerCost = args.workerMarkerCost;
-  const frUInt4 workerFixedShapeCost = args.workerFixedShapeCost;
-  const float workerMarkerDecay = args.workerMarkerDecay;
   const RipUpMode ripupMode = args.ripupMode;
-  const bool followGuide = args.followGuide;
 
   std::string profile_name("DR:searchRepair");
   profile_name += std::to_string(iter);
@@ -608,82 +806,101 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
   int prev_perc = 0;
   bool isExceed = false;
 
-  std::vector<std::unique_ptr<FlexDRWorker>> uworkers;
   int batchStepX, batchStepY;
 
   getBatchInfo(batchStepX, batchStepY);
 
-  std::vector<std::vector<std::vector<std::unique_ptr<FlexDRWorker>>>> workers(
-      batchStepX * batchStepY);
+  // worker tiles (lower-left gcell) grouped by checkerboard batch
+  std::vector<std::vector<Point>> batchTiles(batchStepX * batchStepY);
+  // dynamic scheduling replaces the checkerboard barriers; the batch index
+  // is kept only as the dispatch priority
+  const bool dynamicSched = DYNAMIC_SCHEDULING_DR && !dist_on_ && !graphics_;
+  std::vector<Point> dynamicTiles;
+  std::vector<int> dynamicPriorities;
 
   int xIdx = 0, yIdx = 0;
   for (int i = offset; i < (int) xgp.getCount(); i += size) {
     for (int j = offset; j < (int) ygp.getCount(); j += size) {
-      auto worker
-          = std::make_unique<FlexDRWorker>(&via_data_, design_, logger_);
-      Rect routeBox1 = getDesign()->getTopBlock()->getGCellBox(Point(i, j));
-      const int max_i = std::min((int) xgp.getCount() - 1, i + size - 1);
-      const int max_j = std::min((int) ygp.getCount(), j + size - 1);
-      Rect routeBox2
-          = getDesign()->getTopBlock()->getGCellBox(Point(max_i, max_j));
-      Rect routeBox(routeBox1.xMin(),
-                    routeBox1.yMin(),
-                    routeBox2.xMax(),
-                    routeBox2.yMax());
-      Rect extBox;
-      Rect drcBox;
-      routeBox.bloat(MTSAFEDIST, extBox);
-      routeBox.bloat(DRCSAFEDIST, drcBox);
-      worker->setRouteBox(routeBox);
-      worker->setExtBox(extBox);
-      worker->setDrcBox(drcBox);
-      worker->setGCellBox(Rect(i, j, max_i, max_j));
-      worker->setMazeEndIter(mazeEndIter);
-      worker->setDRIter(iter);
-      worker->setDebugSettings(router_->getDebugSettings());
-      if (dist_on_) {
-        worker->setDistributed(dist_, dist_ip_, dist_port_, dist_dir_);
-      }
-      if (!iter) {
-        // if (routeBox.xMin() == 441000 && routeBox.yMin() == 816100) {
-        //   std::cout << "@@@ debug: " << i << " " << j << std::endl;
-        // }
-        // set boundary pin
-        auto bp = initDR_mergeBoundaryPin(i, j, size, routeBox);
-        worker->setDRIter(0, bp);
-      }
-      worker->setRipupMode(ripupMode);
-      worker->setFollowGuide(followGuide);
-      // TODO: only pass to relevant workers
-      worker->setGraphics(graphics_.get());
-      worker->setCost(workerDRCCost,
-                      workerMarkerCost,
-                      workerFixedShapeCost,
-                      workerMarkerDecay);
-
       int batchIdx = (xIdx % batchStepX) * batchStepY + yIdx % batchStepY;
-      if (workers[batchIdx].empty()
-          || (!dist_on_
-              && (int) workers[batchIdx].back().size() >= BATCHSIZE)) {
-        workers[batchIdx].push_back(
-            std::vector<std::unique_ptr<FlexDRWorker>>());
+      if (dynamicSched) {
+        dynamicTiles.emplace_back(i, j);
+        dynamicPriorities.push_back(batchIdx);
+      } else {
+        batchTiles[batchIdx].emplace_back(i, j);
       }
-      workers[batchIdx].back().push_back(std::move(worker));
-
       yIdx++;
     }
     yIdx = 0;
     xIdx++;
   }
 
+  // Workers are only instantiated right before they run.  After the first
+  // iterations a worker without markers in its drcBox would skip routing
+  // anyway, so such clean tiles are not instantiated at all.  The check is
+  // made once the overlapping tiles of earlier batches have been committed.
+  auto makeWorker = [&](const Point& tile) -> std::unique_ptr<FlexDRWorker> {
+    const Rect routeBox = getWorkerRouteBox(tile.x(), tile.y(), size);
+    if (iter > 1 && isCleanRegion(routeBox)) {
+      return nullptr;
+    }
+    return createWorker(tile.x(), tile.y(), routeBox, args, iter);
+  };
+
   omp_set_num_threads(MAX_THREADS);
   int version = 0;
+  int numSkipped = 0;
   increaseClipsize_ = false;
   numWorkUnits_ = 0;
+  auto workerDone = [&]() {
+    cnt++;
+    if (VERBOSE > 0) {
+      if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1 && prev_perc < 90) {
+        if (prev_perc == 0 && t.isExceed(0)) {
+          isExceed = true;
+        }
+        prev_perc += 10;
+        if (isExceed) {
+          logger_->report("    Completing {}% with {} violations.",
+                          prev_perc,
+                          getDesign()->getTopBlock()->getNumMarkers());
+          logger_->report("    {}.", t);
+        }
+      }
+    }
+  };
+  if (dynamicSched) {
+    std::vector<Rect> extBoxes;
+    extBoxes.reserve(dynamicTiles.size());
+    for (const Point& tile : dynamicTiles) {
+      Rect extBox;
+      getWorkerRouteBox(tile.x(), tile.y(), size).bloat(MTSAFEDIST, extBox);
+      extBoxes.push_back(extBox);
+    }
+    numSkipped = processWorkersDynamic(
+        extBoxes,
+        dynamicPriorities,
+        [&](int idx) { return makeWorker(dynamicTiles[idx]); },
+        workerDone);
+  }
   // parallel execution
-  for (auto& workerBatch : workers) {
+  for (auto& tiles : batchTiles) {
     ProfileTask profile("DR:checkerboard");
-    for (auto& workersInBatch : workerBatch) {
+    for (auto tileIt = tiles.begin(); tileIt != tiles.end();) {
+      std::vector<std::unique_ptr<FlexDRWorker>> workersInBatch;
+      for (; tileIt != tiles.end()
+             && (dist_on_ || (int) workersInBatch.size() < BATCHSIZE);
+           ++tileIt) {
+        auto worker = makeWorker(*tileIt);
+        if (worker) {
+          workersInBatch.push_back(std::move(worker));
+        } else {
+          numSkipped++;
+          workerDone();
+        }
+      }
+      if (workersInBatch.empty()) {
+        continue;
+      }
       {
         const std::string batch_name = std::string("DR:batch<")
                                        + std::to_string(workersInBatch.size())
@@ -712,25 +929,7 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
                 workersInBatch[i]->main(getDesign());
               }
 #pragma omp critical
-              {
-                cnt++;
-                if (VERBOSE > 0) {
-                  if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1
-                      && prev_perc < 90) {
-                    if (prev_perc == 0 && t.isExceed(0)) {
-                      isExceed = true;
-                    }
-                    prev_perc += 10;
-                    if (isExceed) {
-                      logger_->report(
-                          "    Completing {}% with {} violations.",
-                          prev_perc,
-                          getDesign()->getTopBlock()->getNumMarkers());
-                      logger_->report("    {}.", t);
-                    }
-                  }
-                }
-              }
+              workerDone();
             } catch (...) {
               exception.capture();
             }
@@ -817,6 +1016,13 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
              "Number of work units = {}.",
              numWorkUnits_);
   if (VERBOSE > 0) {
+    if (numSkipped > 0) {
+      logger_->info(DRT,
+                    200,
+                    "  Skipped {} of {} workers without markers.",
+                    numSkipped,
+                    tot);
+    }
     logger_->info(DRT,
                   199,
                   "  Number of violations = {}.",
@@ -33,7 +33,9 @@
 #include <boost/polygon/polygon.hpp>
 #include <boost/serialization/export.hpp>
 #include <deque>
+#include <functional>
 #include <memory>
+#include <shared_mutex>
 
 #include "db/drObj/drMarker.h"
 #include "db/drObj/drNet.h"
@@ -42,6 +44,7 @@
 #include "dr/FlexWavefront.h"
 #include "dst/JobMessage.h"
 #include "frDesign.h"
+#include "frRTree.h"
 #include "gc/FlexGC.h"
 
 using Rectangle = boost::polygon::rectangle_data<int>;
@@ -160,6 +163,8 @@ class FlexDR
   bool increaseClipsize_;
   float clipSizeInc_;
   int iter_;
+  // guards the design while workers are scheduled dynamically
+  std::shared_mutex design_mutex_;
 
   // others
   void initFromTA();
@@ -167,6 +172,18 @@ class FlexDR
   void getBatchInfo(int& batchStepX, int& batchStepY);
 
   void init_halfViaEncArea();
+  Rect getWorkerRouteBox(int x_offset, int y_offset, int size) const;
+  bool isCleanRegion(const Rect& routeBox) const;
+  std::unique_ptr<FlexDRWorker> createWorker(int x_offset,
+                                             int y_offset,
+                                             const Rect& routeBox,
+                                             const SearchRepairArgs& args,
+                                             int iter);
+  int processWorkersDynamic(
+      const std::vector<Rect>& extBoxes,
+      const std::vector<int>& priorities,
+      const std::function<std::unique_ptr<FlexDRWorker>(int)>& makeWorker,
+      const std::function<void()>& workerDone);
 
   void removeGCell2BoundaryPin();
   std::map<frNet*, std::set<std::pair<Point, frLayerNum>>, frBlockObjectComp>
@@ -349,6 +366,9 @@ class FlexDRWorker
     gridGraph_.setGraphics(in);
   }
   void setViaData(FlexDRViaData* viaData) { via_data_ = viaData; }
+  // When set, the design is only read while holding a shared lock on this
+  // mutex so that other workers may commit their results concurrently.
+  void setDesignMutex(std::shared_mutex* in) { design_mutex_ = in; }
   // getters
   frTechObject* getTech() const { return design_->getTech(); }
   void getRouteBox(Rect& boxIn) const { boxIn = routeBox_; }
@@ -384,6 +404,8 @@ class FlexDRWorker
   const FlexDRWorkerRegionQuery& getWorkerRegionQuery() const { return rq_; }
   FlexDRWorkerRegionQuery& getWorkerRegionQuery() { return rq_; }
   int getInitNumMarkers() const { return initNumMarkers_; }
+  // Seconds spent in route_queue by the last reloadedMain.
+  double getRouteTime() const { return routeTime_; }
   int getNumMarkers() const { return markers_.size(); }
   int getBestNumMarkers() const { return bestMarkers_.size(); }
   FlexGCWorker* getGCWorker() { return gcWorker_.get(); }
@@ -466,6 +488,7 @@ class FlexDRWorker
   FlexDRGraphics* graphics_ = nullptr;  // owned by FlexDR
   frDebugSettings* debugSettings_ = nullptr;
   FlexDRViaData* via_data_ = nullptr;
+  std::shared_mutex* design_mutex_ = nullptr;  // owned by FlexDR
   Rect routeBox_;
   Rect extBox_;
   Rect drcBox_;
@@ -486,6 +509,7 @@ class FlexDRWorker
       boundaryPin_;
   int pinCnt_ = 0;
   int initNumMarkers_ = 0;
+  double routeTime_ = 0;
   std::map<FlexMazeIdx, drAccessPattern*> apSVia_;
   std::set<FlexMazeIdx> planarHistoryMarkers_;
   std::set<FlexMazeIdx> viaHistoryMarkers_;
@@ -499,6 +523,9 @@ class FlexDRWorker
   std::vector<frMarker> bestMarkers_;
   FlexDRWorkerRegionQuery rq_;
   std::vector<frNonDefaultRule*> ndrs_;
+  // instTerm and bTerm shapes in the extBox by layer, copied from the design
+  // during init so routing never queries the shared region query
+  std::vector<RTree<frBlockObject*>> termShapes_;
 
   // persistent gc worker
   std::unique_ptr<FlexGCWorker> gcWorker_;
@@ -684,6 +711,7 @@ class FlexDRWorker
   void initNets_boundaryArea();
 
   void initGridGraph(const frDesign* design);
+  void initTermShapes(const frDesign* design);
   void initTrackCoords(
       std::map<frCoord, std::map<frLayerNum, frTrackPattern*>>& xMap,
       std::map<frCoord, std::map<frLayerNum, frTrackPattern*>>& yMap);
@@ -3660,6 +3660,25 @@ void FlexDRWorker::initMarkers(const frDesign* design)
   }
 }
 
+void FlexDRWorker::initTermShapes(const frDesign* design)
+{
+  const int numLayers = getTech()->getLayers().size();
+  termShapes_.clear();
+  termShapes_.resize(numLayers);
+  frRegionQuery::Objects<frBlockObject> result;
+  for (frLayerNum lNum = 0; lNum < numLayers; lNum++) {
+    result.clear();
+    design->getRegionQuery()->query(getExtBox(), lNum, result);
+    std::vector<std::pair<Rect, frBlockObject*>> terms;
+    for (auto& [box, obj] : result) {
+      if (obj->typeId() == frcInstTerm || obj->typeId() == frcBTerm) {
+        terms.emplace_back(box, obj);
+      }
+    }
+    termShapes_[lNum] = RTree<frBlockObject*>(terms.begin(), terms.end());
+  }
+}
+
 void FlexDRWorker::init(const frDesign* design)
 {
   initNets(design);
@@ -3670,6 +3689,7 @@ void FlexDRWorker::init(const frDesign* design)
     return;
   }
   initGridGraph(design);
+  initTermShapes(design);
   initMazeIdx();
   std::unique_ptr<FlexGCWorker> gcWorker
       = std::make_unique<FlexGCWorker>(design->getTech(), logger_, this);
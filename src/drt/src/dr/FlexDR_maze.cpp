@@ -2958,9 +2958,9 @@ void FlexDRWorker::checkPathSegStyle(drPathSeg* ps,
 
 bool FlexDRWorker::hasAccessPoint(const Point& pt, frLayerNum lNum, frNet* net)
 {
-  frRegionQuery::Objects<frBlockObject> result;
+  std::vector<std::pair<Rect, frBlockObject*>> result;
   Rect bx(pt.x(), pt.y(), pt.x(), pt.y());
-  design_->getRegionQuery()->query(bx, lNum, result);
+  termShapes_.at(lNum).query(bgi::intersects(bx), std::back_inserter(result));
   for (auto& rqObj : result) {
     switch (rqObj.second->typeId()) {
       case frcInstTerm: {
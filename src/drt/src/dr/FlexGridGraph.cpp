@@ -72,20 +72,14 @@ void FlexGridGraph::initGrids(
 
   nodes_.clear();
   nodes_.resize(capacity, Node());
-  // new
-  prevDirs_.clear();
-  srcs_.clear();
-  dsts_.clear();
-
-  prevDirs_.resize(capacity * 3, false);
-  srcs_.resize(capacity, false);
-  dsts_.resize(capacity, false);
-  guides_.clear();
-  if (followGuide) {
-    guides_.resize(capacity, false);
-  } else {
-    guides_.resize(capacity, true);
+  if (!followGuide) {
+    for (auto& node : nodes_) {
+      node.hasGuide = true;
+    }
   }
+  srcNodes_.clear();
+  dstNodes_.clear();
+  visitedNodes_.clear();
 }
 
 bool FlexGridGraph::outOfDieVia(frMIdx x,
@@ -450,17 +444,26 @@ void FlexGridGraph::resetStatus()
 
 void FlexGridGraph::resetSrc()
 {
-  srcs_.assign(srcs_.size(), false);
+  for (frMIdx idx : srcNodes_) {
+    nodes_[idx].isSrc = false;
+  }
+  srcNodes_.clear();
 }
 
 void FlexGridGraph::resetDst()
 {
-  dsts_.assign(dsts_.size(), false);
+  for (frMIdx idx : dstNodes_) {
+    nodes_[idx].isDst = false;
+  }
+  dstNodes_.clear();
 }
 
 void FlexGridGraph::resetPrevNodeDir()
 {
-  prevDirs_.assign(prevDirs_.size(), false);
+  for (frMIdx idx : visitedNodes_) {
+    nodes_[idx].prevAstarNodeDir = (frUInt4) frDirEnum::UNKNOWN;
+  }
+  visitedNodes_.clear();
 }
 
 // print the grid graph with edge and vertex for debug purpose
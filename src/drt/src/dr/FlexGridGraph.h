@@ -752,16 +752,16 @@ class FlexGridGraph
   }
 
   // unsafe access, no idx check
-  void setSrc(frMIdx x, frMIdx y, frMIdx z) { srcs_[getIdx(x, y, z)] = true; }
+  void setSrc(frMIdx x, frMIdx y, frMIdx z) { setSrcNode(getIdx(x, y, z)); }
   void setSrc(const FlexMazeIdx& mi)
   {
-    srcs_[getIdx(mi.x(), mi.y(), mi.z())] = true;
+    setSrcNode(getIdx(mi.x(), mi.y(), mi.z()));
   }
   // unsafe access, no idx check
-  void setDst(frMIdx x, frMIdx y, frMIdx z) { dsts_[getIdx(x, y, z)] = true; }
+  void setDst(frMIdx x, frMIdx y, frMIdx z) { setDstNode(getIdx(x, y, z)); }
   void setDst(const FlexMazeIdx& mi)
   {
-    dsts_[getIdx(mi.x(), mi.y(), mi.z())] = true;
+    setDstNode(getIdx(mi.x(), mi.y(), mi.z()));
   }
   // unsafe access
   void setSVia(frMIdx x, frMIdx y, frMIdx z)
@@ -810,20 +810,20 @@ class FlexGridGraph
   // unsafe access, no idx check
   void resetSrc(frMIdx x, frMIdx y, frMIdx z)
   {
-    srcs_[getIdx(x, y, z)] = false;
+    nodes_[getIdx(x, y, z)].isSrc = false;
   }
   void resetSrc(const FlexMazeIdx& mi)
   {
-    srcs_[getIdx(mi.x(), mi.y(), mi.z())] = false;
+    nodes_[getIdx(mi.x(), mi.y(), mi.z())].isSrc = false;
   }
   // unsafe access, no idx check
   void resetDst(frMIdx x, frMIdx y, frMIdx z)
   {
-    dsts_[getIdx(x, y, z)] = false;
+    nodes_[getIdx(x, y, z)].isDst = false;
   }
   void resetDst(const FlexMazeIdx& mi)
   {
-    dsts_[getIdx(mi.x(), mi.y(), mi.z())] = false;
+    nodes_[getIdx(mi.x(), mi.y(), mi.z())].isDst = false;
   }
   void resetGridCost(frMIdx x, frMIdx y, frMIdx z, frDirEnum dir)
   {
@@ -848,59 +848,16 @@ class FlexGridGraph
   bool hasGuide(frMIdx x, frMIdx y, frMIdx z, frDirEnum dir) const
   {
     reverse(x, y, z, dir);
-    auto idx = getIdx(x, y, z);
-    return guides_[idx];
+    return nodes_[getIdx(x, y, z)].hasGuide;
   }
   // must be safe access because idx1 and idx2 may be invalid
   void setGuide(frMIdx x1, frMIdx y1, frMIdx x2, frMIdx y2, frMIdx z)
   {
-    if (x2 < x1 || y2 < y1) {
-      return;
-    }
-    switch (getZDir(z)) {
-      case dbTechLayerDir::HORIZONTAL:
-        for (int i = y1; i <= y2; i++) {
-          auto idx1 = getIdx(x1, i, z);
-          auto idx2 = getIdx(x2, i, z);
-          std::fill(guides_.begin() + idx1, guides_.begin() + idx2 + 1, 1);
-        }
-        break;
-      case dbTechLayerDir::VERTICAL:
-        for (int i = x1; i <= x2; i++) {
-          auto idx1 = getIdx(i, y1, z);
-          auto idx2 = getIdx(i, y2, z);
-          std::fill(guides_.begin() + idx1, guides_.begin() + idx2 + 1, 1);
-        }
-        break;
-      case dbTechLayerDir::NONE:
-        std::cout << "Error: Invalid preferred direction on layer " << z << ".";
-        break;
-    }
+    setGuideRange(x1, y1, x2, y2, z, true);
   }
   void resetGuide(frMIdx x1, frMIdx y1, frMIdx x2, frMIdx y2, frMIdx z)
   {
-    if (x2 < x1 || y2 < y1) {
-      return;
-    }
-    switch (getZDir(z)) {
-      case dbTechLayerDir::HORIZONTAL:
-        for (int i = y1; i <= y2; i++) {
-          auto idx1 = getIdx(x1, i, z);
-          auto idx2 = getIdx(x2, i, z);
-          std::fill(guides_.begin() + idx1, guides_.begin() + idx2 + 1, 0);
-        }
-        break;
-      case dbTechLayerDir::VERTICAL:
-        for (int i = x1; i <= x2; i++) {
-          auto idx1 = getIdx(i, y1, z);
-          auto idx2 = getIdx(i, y2, z);
-          std::fill(guides_.begin() + idx1, guides_.begin() + idx2 + 1, 0);
-        }
-        break;
-      case dbTechLayerDir::NONE:
-        std::cout << "Error: Invalid preferred direction on layer " << z << ".";
-        break;
-    }
+    setGuideRange(x1, y1, x2, y2, z, false);
   }
   void setGraphics(FlexDRGraphics* g) { graphics_ = g; }
 
@@ -938,6 +895,8 @@ class FlexGridGraph
               FlexMazeIdx& ccMazeIdx2,
               const Point& centerPt,
               std::map<FlexMazeIdx, frBox3D*>& mazeIdx2TaperBox);
+  // number of grids expanded by search() over the life of the graph
+  uint64_t getNumExpansions() const { return numExpansions_; }
   void setCost(frUInt4 drcCostIn,
                frUInt4 markerCostIn,
                frUInt4 FixedShapeCostIn)
@@ -957,12 +916,12 @@ class FlexGridGraph
   {
     nodes_.clear();
     nodes_.shrink_to_fit();
-    srcs_.clear();
-    srcs_.shrink_to_fit();
-    dsts_.clear();
-    dsts_.shrink_to_fit();
-    guides_.clear();
-    guides_.shrink_to_fit();
+    srcNodes_.clear();
+    srcNodes_.shrink_to_fit();
+    dstNodes_.clear();
+    dstNodes_.shrink_to_fit();
+    visitedNodes_.clear();
+    visitedNodes_.shrink_to_fit();
     xCoords_.clear();
     xCoords_.shrink_to_fit();
     yCoords_.clear();
@@ -1061,15 +1020,22 @@ class FlexGridGraph
     frUInt4 fixedShapeCostPlanarHorzNDR : cost_bits;
     // Byte 13
     frUInt4 fixedShapeCostPlanarVertNDR : cost_bits;
+    // Byte 14: maze search state, kept in the node so that an expansion
+    // touches a single record
+    frUInt4 prevAstarNodeDir : 3;
+    frUInt4 isSrc : 1;
+    frUInt4 isDst : 1;
+    frUInt4 hasGuide : 1;
   };
 #ifndef DEBUG_DRT_UNDERFLOW
   static_assert(sizeof(Node) == 16);
 #endif
   frVector<Node> nodes_;
-  std::vector<bool> prevDirs_;
-  std::vector<bool> srcs_;
-  std::vector<bool> dsts_;
-  std::vector<bool> guides_;
+  // nodes whose src/dst/prevAstarNodeDir may be set; the resets only walk
+  // these instead of the whole graph
+  std::vector<frMIdx> srcNodes_;
+  std::vector<frMIdx> dstNodes_;
+  std::vector<frMIdx> visitedNodes_;
   frVector<frCoord> xCoords_;
   frVector<frCoord> yCoords_;
   frVector<frLayerNum> zCoords_;
@@ -1081,6 +1047,7 @@ class FlexGridGraph
   frUInt4 ggFixedShapeCost_;
   // temporary variables
   FlexWavefront wavefront_;
+  uint64_t numExpansions_ = 0;
   const std::vector<std::pair<frCoord, frCoord>>* halfViaEncArea_
       = nullptr;  // std::pair<layer1area, layer2area>
   // ndr related
@@ -1093,38 +1060,88 @@ class FlexGridGraph
   // unsafe access, no idx check
   void setPrevAstarNodeDir(frMIdx x, frMIdx y, frMIdx z, frDirEnum dir)
   {
-    auto baseIdx = 3 * getIdx(x, y, z);
-    prevDirs_[baseIdx] = ((uint16_t) dir >> 2) & 1;
-    prevDirs_[baseIdx + 1] = ((uint16_t) dir >> 1) & 1;
-    prevDirs_[baseIdx + 2] = ((uint16_t) dir) & 1;
+    const frMIdx idx = getIdx(x, y, z);
+    Node& node = nodes_[idx];
+    if (node.prevAstarNodeDir == (frUInt4) frDirEnum::UNKNOWN) {
+      visitedNodes_.push_back(idx);
+    }
+    node.prevAstarNodeDir = (frUInt4) dir;
   }
 
   // unsafe access, no check
   frDirEnum getPrevAstarNodeDir(const FlexMazeIdx& idx) const
   {
-    auto baseIdx = 3 * getIdx(idx.x(), idx.y(), idx.z());
-    return (frDirEnum) (((uint16_t) (prevDirs_[baseIdx]) << 2)
-                        + ((uint16_t) (prevDirs_[baseIdx + 1]) << 1)
-                        + ((uint16_t) (prevDirs_[baseIdx + 2]) << 0));
+    return (frDirEnum) nodes_[getIdx(idx.x(), idx.y(), idx.z())]
+        .prevAstarNodeDir;
   }
 
   // unsafe access, no check
   bool isSrc(frMIdx x, frMIdx y, frMIdx z) const
   {
-    return srcs_[getIdx(x, y, z)];
+    return nodes_[getIdx(x, y, z)].isSrc;
   }
   // unsafe access, no check
   bool isDst(frMIdx x, frMIdx y, frMIdx z) const
   {
-    return dsts_[getIdx(x, y, z)];
+    return nodes_[getIdx(x, y, z)].isDst;
   }
   bool isDst(frMIdx x, frMIdx y, frMIdx z, frDirEnum dir) const
   {
     getNextGrid(x, y, z, dir);
-    bool b = dsts_[getIdx(x, y, z)];
+    bool b = nodes_[getIdx(x, y, z)].isDst;
     getPrevGrid(x, y, z, dir);
     return b;
   }
+  void setSrcNode(frMIdx idx)
+  {
+    Node& node = nodes_[idx];
+    if (!node.isSrc) {
+      node.isSrc = true;
+      srcNodes_.push_back(idx);
+    }
+  }
+  void setDstNode(frMIdx idx)
+  {
+    Node& node = nodes_[idx];
+    if (!node.isDst) {
+      node.isDst = true;
+      dstNodes_.push_back(idx);
+    }
+  }
+  void setGuideRange(frMIdx x1,
+                     frMIdx y1,
+                     frMIdx x2,
+                     frMIdx y2,
+                     frMIdx z,
+                     bool hasGuide)
+  {
+    if (x2 < x1 || y2 < y1) {
+      return;
+    }
+    switch (getZDir(z)) {
+      case dbTechLayerDir::HORIZONTAL:
+        for (int i = y1; i <= y2; i++) {
+          auto idx1 = getIdx(x1, i, z);
+          auto idx2 = getIdx(x2, i, z);
+          for (auto idx = idx1; idx <= idx2; idx++) {
+            nodes_[idx].hasGuide = hasGuide;
+          }
+        }
+        break;
+      case dbTechLayerDir::VERTICAL:
+        for (int i = x1; i <= x2; i++) {
+          auto idx1 = getIdx(i, y1, z);
+          auto idx2 = getIdx(i, y2, z);
+          for (auto idx = idx1; idx <= idx2; idx++) {
+            nodes_[idx].hasGuide = hasGuide;
+          }
+        }
+        break;
+      case dbTechLayerDir::NONE:
+        std::cout << "Error: Invalid preferred direction on layer " << z << ".";
+        break;
+    }
+  }
 
   // internal getters
   frMIdx getIdx(frMIdx xIdx, frMIdx yIdx, frMIdx zIdx) const
@@ -1314,10 +1331,9 @@ class FlexGridGraph
     }
     (ar) & drWorker_;
     (ar) & nodes_;
-    (ar) & prevDirs_;
-    (ar) & srcs_;
-    (ar) & dsts_;
-    (ar) & guides_;
+    (ar) & srcNodes_;
+    (ar) & dstNodes_;
+    (ar) & visitedNodes_;
     (ar) & xCoords_;
     (ar) & yCoords_;
     (ar) & zCoords_;
@@ -721,6 +721,7 @@ bool FlexGridGraph::search(std::vector<FlexMazeIdx>& connComps,
         != frDirEnum::UNKNOWN) {
       continue;
     }
+    numExpansions_++;
     if (graphics_) {
       graphics_->searchNode(this, currGrid);
     }
@@ -28,9 +28,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <bitset>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "dr/FlexMazeTypes.h"
 #include "frBaseTypes.h"
@@ -84,6 +89,7 @@ class FlexWavefrontGrid
   frMIdx z() const { return zIdx_; }
   frCost getPathCost() const { return pathCost_; }
   frCost getCost() const { return cost_; }
+  frCoord getDist() const { return dist_; }
   const std::bitset<WAVEFRONTBITSIZE>& getBackTraceBuffer() const
   {
     return backTraceBuffer_;
@@ -150,18 +156,210 @@ class myPriorityQueue : public std::priority_queue<FlexWavefrontGrid>
   }
 };
 
+// Radix heap over the integral wavefront cost.  The heap only moves compact
+// keys around; the grids themselves stay in a slot pool.  Keys that are not
+// monotone (cost below the last popped cost, possible with an inconsistent
+// estimate) go to a small fallback heap that is always drained first.
+// Grids of equal cost are ordered like FlexWavefrontGrid::operator<.
+class FlexWavefrontRadixHeap
+{
+ public:
+  bool empty() const { return size_ == 0; }
+  unsigned int size() const { return size_; }
+  const FlexWavefrontGrid& top() const
+  {
+    if (!late_.empty()) {
+      return pool_[late_.front().slot];
+    }
+    return pool_[buckets_[0].front().slot];
+  }
+  void push(const FlexWavefrontGrid& in)
+  {
+    uint32_t slot;
+    if (freeSlots_.empty()) {
+      slot = pool_.size();
+      pool_.push_back(in);
+    } else {
+      slot = freeSlots_.back();
+      freeSlots_.pop_back();
+      pool_[slot] = in;
+    }
+    const Key key{in.getCost(), in.getDist(), in.z(), in.getPathCost(), slot};
+    if (size_ == 0) {
+      last_ = key.cost;
+    }
+    if (key.cost < last_) {
+      late_.push_back(key);
+      std::push_heap(late_.begin(), late_.end(), lowerPriority);
+    } else {
+      insert(key);
+    }
+    size_++;
+  }
+  void pop()
+  {
+    Key key;
+    if (!late_.empty()) {
+      std::pop_heap(late_.begin(), late_.end(), lowerPriority);
+      key = late_.back();
+      late_.pop_back();
+    } else {
+      auto& bucket = buckets_[0];
+      std::pop_heap(bucket.begin(), bucket.end(), lowerPriority);
+      key = bucket.back();
+      bucket.pop_back();
+    }
+    freeSlots_.push_back(key.slot);
+    size_--;
+    if (buckets_[0].empty()) {
+      refill();
+    }
+  }
+  void cleanup()
+  {
+    for (auto& bucket : buckets_) {
+      bucket.clear();
+    }
+    late_.clear();
+    pool_.clear();
+    freeSlots_.clear();
+    last_ = 0;
+    size_ = 0;
+  }
+  void fit()
+  {
+    cleanup();
+    for (auto& bucket : buckets_) {
+      bucket.shrink_to_fit();
+    }
+    late_.shrink_to_fit();
+    pool_.shrink_to_fit();
+    freeSlots_.shrink_to_fit();
+  }
+
+ private:
+  struct Key
+  {
+    frCost cost;
+    frCoord dist;
+    frMIdx z;
+    frCost pathCost;
+    uint32_t slot;
+  };
+  static constexpr int kNumBuckets = std::numeric_limits<frCost>::digits + 1;
+
+  // same order as FlexWavefrontGrid::operator<
+  static bool lowerPriority(const Key& a, const Key& b)
+  {
+    if (a.cost != b.cost) {
+      return a.cost > b.cost;
+    }
+    if (a.dist != b.dist) {
+      return a.dist > b.dist;
+    }
+    if (a.z != b.z) {
+      return a.z < b.z;
+    }
+    return a.pathCost < b.pathCost;
+  }
+  // bucket i > 0 holds the keys whose highest bit differing from last_ is
+  // bit i - 1; bucket 0 holds the keys equal to last_ as a heap
+  int getBucketIdx(frCost cost) const
+  {
+    const frCost diff = cost ^ last_;
+    return diff == 0 ? 0 : std::numeric_limits<frCost>::digits
+                               - __builtin_clz(diff);
+  }
+  void insert(const Key& key)
+  {
+    const int idx = getBucketIdx(key.cost);
+    auto& bucket = buckets_[idx];
+    bucket.push_back(key);
+    if (idx == 0) {
+      std::push_heap(bucket.begin(), bucket.end(), lowerPriority);
+    }
+  }
+  // Make bucket 0 non-empty again by redistributing the first non-empty
+  // bucket around its minimum cost.
+  void refill()
+  {
+    int idx = 1;
+    while (idx < kNumBuckets && buckets_[idx].empty()) {
+      idx++;
+    }
+    if (idx == kNumBuckets) {
+      return;
+    }
+    std::vector<Key> keys;
+    keys.swap(buckets_[idx]);
+    last_ = std::min_element(keys.begin(),
+                             keys.end(),
+                             [](const Key& a, const Key& b) {
+                               return a.cost < b.cost;
+                             })
+                ->cost;
+    for (const Key& key : keys) {
+      insert(key);
+    }
+    // hand the storage back so the bucket does not reallocate
+    keys.clear();
+    buckets_[idx].swap(keys);
+  }
+
+  std::array<std::vector<Key>, kNumBuckets> buckets_;
+  std::vector<Key> late_;
+  std::vector<FlexWavefrontGrid> pool_;
+  std::vector<uint32_t> freeSlots_;
+  frCost last_ = 0;
+  unsigned int size_ = 0;
+};
+
 class FlexWavefront
 {
  public:
-  bool empty() const { return wavefrontPQ_.empty(); }
-  const FlexWavefrontGrid& top() const { return wavefrontPQ_.top(); }
-  void pop() { wavefrontPQ_.pop(); }
-  void push(const FlexWavefrontGrid& in) { wavefrontPQ_.push(in); }
-  unsigned int size() const { return wavefrontPQ_.size(); }
-  void cleanup() { wavefrontPQ_.cleanup(); }
-  void fit() { wavefrontPQ_.fit(); }
+  bool empty() const
+  {
+    return useRadixHeap_ ? radixHeap_.empty() : wavefrontPQ_.empty();
+  }
+  const FlexWavefrontGrid& top() const
+  {
+    return useRadixHeap_ ? radixHeap_.top() : wavefrontPQ_.top();
+  }
+  void pop()
+  {
+    if (useRadixHeap_) {
+      radixHeap_.pop();
+    } else {
+      wavefrontPQ_.pop();
+    }
+  }
+  void push(const FlexWavefrontGrid& in)
+  {
+    if (useRadixHeap_) {
+      radixHeap_.push(in);
+    } else {
+      wavefrontPQ_.push(in);
+    }
+  }
+  unsigned int size() const
+  {
+    return useRadixHeap_ ? radixHeap_.size() : wavefrontPQ_.size();
+  }
+  void cleanup()
+  {
+    wavefrontPQ_.cleanup();
+    radixHeap_.cleanup();
+  }
+  void fit()
+  {
+    wavefrontPQ_.fit();
+    radixHeap_.fit();
+  }
 
  private:
+  // selected once per wavefront so a search never mixes both queues
+  bool useRadixHeap_ = RADIX_WAVEFRONT;
   myPriorityQueue wavefrontPQ_;
+  FlexWavefrontRadixHeap radixHeap_;
 };
 }  // namespace drt
@@ -73,6 +73,8 @@ extern bool CLEAN_PATCHES;
 extern bool DO_PA;
 extern bool SINGLE_STEP_DR;
 extern bool SAVE_GUIDE_UPDATES;
+extern bool DYNAMIC_SCHEDULING_DR;
+extern bool RADIX_WAVEFRONT;
 extern std::string VIAINPIN_BOTTOMLAYER_NAME;
 extern std::string VIAINPIN_TOPLAYER_NAME;
 extern frLayerNum VIAINPIN_BOTTOMLAYERNUM;
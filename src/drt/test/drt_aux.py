@@ -31,7 +31,9 @@ def detailed_route(
     no_pin_access=False,
     single_step_dr=False,
     min_access_points=-1,
-    save_guide_updates=False
+    save_guide_updates=False,
+    dynamic_scheduling=False,
+    radix_wavefront=False
 ):
     router = design.getTritonRoute()
     params = drt.ParamStruct()
@@ -54,6 +56,8 @@ def detailed_route(
     params.singleStepDR = single_step_dr
     params.minAccessPoints = min_access_points
     params.saveGuideUpdates = save_guide_updates
+    params.dynamicSchedulingDR = dynamic_scheduling
+    params.radixWavefrontDR = radix_wavefront
 
     router.setParams(params)
     router.main()
@@ -0,0 +1,25 @@
+# detailed_route with dynamically scheduled workers on several threads
+source "helpers.tcl"
+
+read_lef testcase/ispd18_sample/ispd18_sample.input.lef
+read_def testcase/ispd18_sample/ispd18_sample.input.def
+read_guides testcase/ispd18_sample/ispd18_sample.input.guide
+set_thread_count 4
+detailed_route -dynamic_scheduling -verbose 0
+
+set drvs [detailed_route_num_drvs]
+if { $drvs != 0 } {
+  puts "FAIL: $drvs violations after dynamically scheduled routing"
+  exit 1
+}
+
+foreach net [[ord::get_db_block] getNets] {
+  if { ![$net isSpecial] && [llength [$net getITerms]] > 1
+       && [$net getWire] == "NULL" } {
+    puts "FAIL: net [$net getName] is not routed"
+    exit 1
+  }
+}
+
+puts "pass"
+exit 0
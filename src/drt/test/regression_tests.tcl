@@ -15,4 +15,5 @@ record_tests {
 }
 record_pass_fail_tests {
   gc_test
+  ispd18_sample_dynamic
 }
@@ -0,0 +1,16 @@
+# Replays the workers dumped by detailed_route_debug -dump_dr (see
+# gcd_nangate45_dump_worker.tcl) once with each wavefront queue and writes
+# the per worker statistics to heap.json and radix.json in the dump dir.
+# Not part of the regression.
+#   DUMP_DIR=<dump_dir> openroad wavefront_bench.tcl
+source "helpers.tcl"
+if { [info exists ::env(DUMP_DIR)] } {
+  set dump_dir $::env(DUMP_DIR)
+} else {
+  set dump_dir results
+}
+
+detailed_route_benchmark_workers -dump_dir $dump_dir \
+  -output_json $dump_dir/heap.json
+detailed_route_benchmark_workers -dump_dir $dump_dir \
+  -output_json $dump_dir/radix.json -radix_wavefront
@@ -136,6 +136,7 @@ class Replace
 
   void addTimingNetWeightOverflow(int overflow);
   void setTimingNetWeightMax(float max);
+  void setTimingDrivenVirtualBuffering(bool mode);
 
   void setDebug(int pause_iterations,
                 int update_iterations,
@@ -199,6 +200,7 @@ class Replace
   float timingNetWeightMax_ = 1.9;
 
   bool timingDrivenMode_ = true;
+  bool timingDrivenVirtualBuffering_ = false;
   bool routabilityDrivenMode_ = true;
   bool routabilityUseRudy_ = true;
   bool uniformTargetDensityMode_ = false;
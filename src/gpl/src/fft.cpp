@@ -33,6 +33,9 @@
 
 #include "fft.h"
 
+#include <omp.h>
+
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <cstdlib>
@@ -42,11 +45,22 @@
 
 namespace gpl {
 
-FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY)
+// Grids smaller than this finish faster than threads can be woken up
+// (same cut-off as Ooura's FFT2D_THREADS_BEGIN_N).
+static constexpr int fftThreadsBeginN = 65536;
+
+FFT::FFT(int binCntX,
+         int binCntY,
+         int binSizeX,
+         int binSizeY,
+         int num_threads)
     : binCntX_(binCntX),
       binCntY_(binCntY),
       binSizeX_(binSizeX),
-      binSizeY_(binSizeY)
+      binSizeY_(binSizeY),
+      num_threads_(binCntX * binCntY >= fftThreadsBeginN
+                       ? std::max(num_threads, 1)
+                       : 1)
 {
   binDensity_ = new float*[binCntX_];
   electroPhi_ = new float*[binCntX_];
@@ -74,6 +88,17 @@ FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY)
 
   workArea_.resize(round(sqrt(std::max(binCntX_, binCntY_))) + 2, 0);
 
+  // The 1D transforms build the cos/sin tables on their first call for the
+  // longest length and only read them afterwards. Build them here, before
+  // several threads share them.
+  std::vector<float> tableInit(std::max(binCntX_, binCntY_), 0);
+  ddct(tableInit.size(), -1, tableInit.data(), &workArea_[0], &csTable_[0]);
+
+  colBuffers_.resize(num_threads_);
+  for (auto& buffer : colBuffers_) {
+    buffer.resize(4 * binCntX_, 0);
+  }
+
   for (int i = 0; i < binCntX_; i++) {
     wx_[i]
         = REPLACE_FFT_PI * static_cast<float>(i) / static_cast<float>(binCntX_);
@@ -126,15 +151,50 @@ float FFT::getElectroPhi(int x, int y) const
   return electroPhi_[x][y];
 }
 
+void FFT::ddxt2d(float** a, bool rowSine, bool colSine, int isgn)
+{
+  int* ip = &workArea_[0];
+  float* w = &csTable_[0];
+
+#pragma omp parallel for num_threads(num_threads_)
+  for (int i = 0; i < binCntX_; i++) {
+    if (rowSine) {
+      ddst(binCntY_, isgn, a[i], ip, w);
+    } else {
+      ddct(binCntY_, isgn, a[i], ip, w);
+    }
+  }
+
+  // Columns are gathered four at a time into a contiguous buffer.
+  const int blockCnt = (binCntY_ + 3) / 4;
+#pragma omp parallel for num_threads(num_threads_)
+  for (int block = 0; block < blockCnt; block++) {
+    float* t = colBuffers_[omp_get_thread_num()].data();
+    const int j0 = block * 4;
+    const int cols = std::min(4, binCntY_ - j0);
+    for (int i = 0; i < binCntX_; i++) {
+      for (int c = 0; c < cols; c++) {
+        t[c * binCntX_ + i] = a[i][j0 + c];
+      }
+    }
+    for (int c = 0; c < cols; c++) {
+      if (colSine) {
+        ddst(binCntX_, isgn, &t[c * binCntX_], ip, w);
+      } else {
+        ddct(binCntX_, isgn, &t[c * binCntX_], ip, w);
+      }
+    }
+    for (int i = 0; i < binCntX_; i++) {
+      for (int c = 0; c < cols; c++) {
+        a[i][j0 + c] = t[c * binCntX_ + i];
+      }
+    }
+  }
+}
+
 void FFT::doFFT()
 {
-  ddct2d(binCntX_,
-         binCntY_,
-         -1,
-         binDensity_,
-         nullptr,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
+  ddxt2d(binDensity_, false, false, -1);
 
   for (int i = 0; i < binCntX_; i++) {
     binDensity_[i][0] *= 0.5;
@@ -144,12 +204,14 @@ void FFT::doFFT()
     binDensity_[0][i] *= 0.5;
   }
 
+#pragma omp parallel for num_threads(num_threads_)
   for (int i = 0; i < binCntX_; i++) {
     for (int j = 0; j < binCntY_; j++) {
       binDensity_[i][j] *= 4.0 / binCntX_ / binCntY_;
     }
   }
 
+#pragma omp parallel for num_threads(num_threads_)
   for (int i = 0; i < binCntX_; i++) {
     float wx = wx_[i];
     float wx2 = wxSquare_[i];
@@ -185,28 +247,10 @@ void FFT::doFFT()
       electroForceY_[i][j] = electroY;
     }
   }
-  // Inverse DCT
-  ddct2d(binCntX_,
-         binCntY_,
-         1,
-         electroPhi_,
-         nullptr,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
-  ddsct2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceX_,
-          nullptr,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
-  ddcst2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceY_,
-          nullptr,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
+  // Inverse DCT (ddct2d), DCT-DST (ddsct2d) and DST-DCT (ddcst2d)
+  ddxt2d(electroPhi_, false, false, 1);
+  ddxt2d(electroForceX_, false, true, 1);
+  ddxt2d(electroForceY_, true, false, 1);
 }
 
 }  // namespace gpl
@@ -40,7 +40,7 @@ namespace gpl {
 class FFT
 {
  public:
-  FFT(int binCntX, int binCntY, int binSizeX, int binSizeY);
+  FFT(int binCntX, int binCntY, int binSizeX, int binSizeY, int num_threads);
   ~FFT();
 
   // input func
@@ -54,6 +54,11 @@ class FFT
   float getElectroPhi(int x, int y) const;
 
  private:
+  // 2D cosine/sine transform of a (binCntX_ x binCntY_), split into a
+  // row pass and a column pass like Ooura's ddct2d/ddsct2d/ddcst2d.
+  // Rows and column blocks are independent, so both passes are threaded.
+  void ddxt2d(float** a, bool rowSine, bool colSine, int isgn);
+
   // 2D array; width: binCntX_, height: binCntY_;
   // No hope to use Vector at this moment...
   float** binDensity_ = nullptr;
@@ -77,10 +82,14 @@ class FFT
   // length: round(sqrt( max(binCntX_, binCntY_) )) + 2
   std::vector<int> workArea_;
 
+  // per-thread buffers for the column pass. length: 4 * binCntX_
+  std::vector<std::vector<float>> colBuffers_;
+
   int binCntX_ = 0;
   int binCntY_ = 0;
   int binSizeX_ = 0;
   int binSizeY_ = 0;
+  int num_threads_ = 1;
 };
 
 //
@@ -46,6 +46,7 @@
 #include "odb/db.h"
 #include "placerBase.h"
 #include "utl/Logger.h"
+#include "waKernel.h"
 
 #define REPLACE_SQRT2 1.414213562373095048801L
 
@@ -77,6 +78,7 @@ static float getSecondNorm(const std::vector<FloatPoint>& a);
 static float getOverlapDensityArea(const Bin& bin, const GCell* cell);
 
 static float fastExp(float exp);
+static float fastExpBase(float exp);
 
 ////////////////////////////////////////////////
 // GCell
@@ -306,21 +308,6 @@ int64_t GNet::hpwl() const
   return (ux - lx) + (uy - ly);
 }
 
-void GNet::clearWaVars()
-{
-  waExpMinSumX_ = 0;
-  waXExpMinSumX_ = 0;
-
-  waExpMaxSumX_ = 0;
-  waXExpMaxSumX_ = 0;
-
-  waExpMinSumY_ = 0;
-  waYExpMinSumY_ = 0;
-
-  waExpMaxSumY_ = 0;
-  waYExpMaxSumY_ = 0;
-}
-
 void GNet::setDontCare()
 {
   isDontCare_ = true;
@@ -369,41 +356,6 @@ void GPin::setCenterLocation(int cx, int cy)
   cy_ = cy;
 }
 
-void GPin::clearWaVars()
-{
-  hasMaxExpSumX_ = false;
-  hasMaxExpSumY_ = false;
-  hasMinExpSumX_ = false;
-  hasMinExpSumY_ = false;
-
-  maxExpSumX_ = maxExpSumY_ = 0;
-  minExpSumX_ = minExpSumY_ = 0;
-}
-
-void GPin::setMaxExpSumX(float maxExpSumX)
-{
-  hasMaxExpSumX_ = true;
-  maxExpSumX_ = maxExpSumX;
-}
-
-void GPin::setMaxExpSumY(float maxExpSumY)
-{
-  hasMaxExpSumY_ = true;
-  maxExpSumY_ = maxExpSumY;
-}
-
-void GPin::setMinExpSumX(float minExpSumX)
-{
-  hasMinExpSumX_ = true;
-  minExpSumX_ = minExpSumX;
-}
-
-void GPin::setMinExpSumY(float minExpSumY)
-{
-  hasMinExpSumY_ = true;
-  minExpSumY_ = minExpSumY;
-}
-
 void GPin::updateLocation(const GCell* gCell)
 {
   cx_ = gCell->cx() + offsetCx_;
@@ -737,24 +689,42 @@ void BinGrid::updateBinsNonPlaceArea()
 // Core Part
 void BinGrid::updateBinsGCellDensityArea(const std::vector<GCell*>& cells)
 {
-  // clear the Bin-area info
-  for (Bin& bin : bins_) {
-    bin.setInstPlacedAreaUnscaled(0);
-    bin.setFillerArea(0);
+  // Bucket the cells by the bin rows they overlap so that every row is
+  // updated by a single thread. The bin areas are integers, so the result
+  // doesn't depend on the order the cells are accumulated in.
+  rowCells_.resize(binCntY_);
+  for (auto& row : rowCells_) {
+    row.clear();
   }
-
-  for (auto& cell : cells) {
-    std::pair<int, int> pairX = getDensityMinMaxIdxX(cell);
+  for (GCell* cell : cells) {
+    if (!cell->isInstance() && !cell->isFiller()) {
+      continue;
+    }
     std::pair<int, int> pairY = getDensityMinMaxIdxY(cell);
+    for (int y = pairY.first; y < pairY.second; y++) {
+      rowCells_[y].push_back(cell);
+    }
+  }
 
-    // The following function is critical runtime hotspot
-    // for global placer.
-    //
-    if (cell->isInstance()) {
-      // macro should have
-      // scale-down with target-density
-      if (cell->isMacroInstance()) {
-        for (int y = pairY.first; y < pairY.second; y++) {
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (int y = 0; y < binCntY_; y++) {
+    // clear the Bin-area info
+    for (int x = 0; x < binCntX_; x++) {
+      Bin& bin = bins_[y * binCntX_ + x];
+      bin.setInstPlacedAreaUnscaled(0);
+      bin.setFillerArea(0);
+    }
+
+    for (GCell* cell : rowCells_[y]) {
+      std::pair<int, int> pairX = getDensityMinMaxIdxX(cell);
+
+      // The following function is critical runtime hotspot
+      // for global placer.
+      //
+      if (cell->isInstance()) {
+        // macro should have
+        // scale-down with target-density
+        if (cell->isMacroInstance()) {
           for (int x = pairX.first; x < pairX.second; x++) {
             Bin& bin = bins_[y * binCntX_ + x];
 
@@ -764,10 +734,8 @@ void BinGrid::updateBinsGCellDensityArea(const std::vector<GCell*>& cells)
             bin.addInstPlacedAreaUnscaled(scaledAvea);
           }
         }
-      }
-      // normal cells
-      else if (cell->isStdInstance()) {
-        for (int y = pairY.first; y < pairY.second; y++) {
+        // normal cells
+        else if (cell->isStdInstance()) {
           for (int x = pairX.first; x < pairX.second; x++) {
             Bin& bin = bins_[y * binCntX_ + x];
             const float scaledArea
@@ -775,9 +743,7 @@ void BinGrid::updateBinsGCellDensityArea(const std::vector<GCell*>& cells)
             bin.addInstPlacedAreaUnscaled(scaledArea);
           }
         }
-      }
-    } else if (cell->isFiller()) {
-      for (int y = pairY.first; y < pairY.second; y++) {
+      } else if (cell->isFiller()) {
         for (int x = pairX.first; x < pairX.second; x++) {
           Bin& bin = bins_[y * binCntX_ + x];
           bin.addFillerArea(getOverlapDensityArea(bin, cell)
@@ -973,6 +939,51 @@ NesterovBaseCommon::NesterovBaseCommon(NesterovBaseVars nbVars,
       gNet.addGPin(pbToNb(pin));
     }
   }
+
+  initWaStor();
+}
+
+void NesterovBaseCommon::initWaStor()
+{
+  waNets_.pinStart.resize(gNetStor_.size() + 1);
+  waNets_.pinStart[0] = 0;
+  for (size_t i = 0; i < gNetStor_.size(); i++) {
+    waNets_.pinStart[i + 1]
+        = waNets_.pinStart[i] + gNetStor_[i].gPins().size();
+  }
+  const int slotCnt = waNets_.pinStart.back();
+
+  waPinSlot_.assign(gPinStor_.size(), -1);
+  waPins_.gPinIdx.resize(slotCnt);
+  for (size_t i = 0; i < gNetStor_.size(); i++) {
+    int slot = waNets_.pinStart[i];
+    for (GPin* gPin : gNetStor_[i].gPins()) {
+      const int gPinIdx = gPin - gPinStor_.data();
+      waPins_.gPinIdx[slot] = gPinIdx;
+      waPinSlot_[gPinIdx] = slot;
+      slot++;
+    }
+  }
+
+  for (auto* pinVec : {&waPins_.cx, &waPins_.cy}) {
+    pinVec->assign(slotCnt, 0);
+  }
+  for (auto* pinVec : {&waPins_.minExpX,
+                       &waPins_.maxExpX,
+                       &waPins_.minExpY,
+                       &waPins_.maxExpY}) {
+    pinVec->assign(slotCnt, 0);
+  }
+  for (auto* netVec : {&waNets_.expMinSumX,
+                       &waNets_.xExpMinSumX,
+                       &waNets_.expMaxSumX,
+                       &waNets_.xExpMaxSumX,
+                       &waNets_.expMinSumY,
+                       &waNets_.yExpMinSumY,
+                       &waNets_.expMaxSumY,
+                       &waNets_.yExpMaxSumY}) {
+    netVec->assign(gNetStor_.size(), 0);
+  }
 }
 
 GCell* NesterovBaseCommon::pbToNb(Instance* inst) const
@@ -1025,98 +1036,147 @@ GNet* NesterovBaseCommon::dbToNb(odb::dbNet* net) const
 void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
 {
   assert(omp_get_thread_num() == 0);
-  // clear all WA variables.
-#pragma omp parallel for num_threads(num_threads_)
-  for (auto gPin = gPinStor_.begin(); gPin < gPinStor_.end(); ++gPin) {
-    // old-style loop for old OpenMP
-    gPin->clearWaVars();
-  }
-
-#pragma omp parallel for num_threads(num_threads_)
-  for (auto gNet = gNetStor_.begin(); gNet < gNetStor_.end(); ++gNet) {
-    // old-style loop for old OpenMP
-
-    gNet->clearWaVars();
-    gNet->updateBox();
-
-    for (auto& gPin : gNet->gPins()) {
-      // The WA terms are shift invariant:
-      //
-      //   Sum(x_i * exp(x_i))    Sum(x_i * exp(x_i - C))
-      //   -----------------    = -----------------
-      //   Sum(exp(x_i))          Sum(exp(x_i - C))
-      //
-      // So we shift to keep the exponential from overflowing
-      float expMinX = (gNet->lx() - gPin->cx()) * wlCoeffX;
-      float expMaxX = (gPin->cx() - gNet->ux()) * wlCoeffX;
-      float expMinY = (gNet->ly() - gPin->cy()) * wlCoeffY;
-      float expMaxY = (gPin->cy() - gNet->uy()) * wlCoeffY;
-
-      // min x
-      if (expMinX > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumX(fastExp(expMinX));
-        gNet->addWaExpMinSumX(gPin->minExpSumX());
-        gNet->addWaXExpMinSumX(gPin->cx() * gPin->minExpSumX());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MinX updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->minExpSumX());
-        }
+  const float forceBar = nbVars_.minWireLengthForceBar;
+  const int netCnt = gNetStor_.size();
+
+  // Most nets have only a few pins, so nets are taken in blocks to give
+  // the exp kernel long runs of pins to work on.
+  const int netBlockSize = 256;
+  const int blockCnt = (netCnt + netBlockSize - 1) / netBlockSize;
+
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (int block = 0; block < blockCnt; block++) {
+    const int netBegin = block * netBlockSize;
+    const int netEnd = std::min(netBegin + netBlockSize, netCnt);
+
+    int* cx = waPins_.cx.data();
+    int* cy = waPins_.cy.data();
+    float* minExpX = waPins_.minExpX.data();
+    float* maxExpX = waPins_.maxExpX.data();
+    float* minExpY = waPins_.minExpY.data();
+    float* maxExpY = waPins_.maxExpY.data();
+
+    // gather the pin locations and set up the exp bases of every pin
+    for (int netIdx = netBegin; netIdx < netEnd; netIdx++) {
+      GNet& gNet = gNetStor_[netIdx];
+      gNet.updateBox();
+
+      const int lx = gNet.lx();
+      const int ux = gNet.ux();
+      const int ly = gNet.ly();
+      const int uy = gNet.uy();
+      for (int slot = waNets_.pinStart[netIdx];
+           slot < waNets_.pinStart[netIdx + 1];
+           slot++) {
+        const GPin& gPin = gPinStor_[waPins_.gPinIdx[slot]];
+        cx[slot] = gPin.cx();
+        cy[slot] = gPin.cy();
+
+        // The WA terms are shift invariant:
+        //
+        //   Sum(x_i * exp(x_i))    Sum(x_i * exp(x_i - C))
+        //   -----------------    = -----------------
+        //   Sum(exp(x_i))          Sum(exp(x_i - C))
+        //
+        // So we shift to keep the exponential from overflowing
+        const float expMinX = (lx - cx[slot]) * wlCoeffX;
+        const float expMaxX = (cx[slot] - ux) * wlCoeffX;
+        const float expMinY = (ly - cy[slot]) * wlCoeffY;
+        const float expMaxY = (cy[slot] - uy) * wlCoeffY;
+        minExpX[slot] = (expMinX > forceBar) ? fastExpBase(expMinX) : 0;
+        maxExpX[slot] = (expMaxX > forceBar) ? fastExpBase(expMaxX) : 0;
+        minExpY[slot] = (expMinY > forceBar) ? fastExpBase(expMinY) : 0;
+        maxExpY[slot] = (expMaxY > forceBar) ? fastExpBase(expMaxY) : 0;
       }
+    }
 
-      // max x
-      if (expMaxX > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumX(fastExp(expMaxX));
-        gNet->addWaExpMaxSumX(gPin->maxExpSumX());
-        gNet->addWaXExpMaxSumX(gPin->cx() * gPin->maxExpSumX());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MaxX updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->maxExpSumX());
-        }
+    // pins of the block are contiguous
+    const int slotBegin = waNets_.pinStart[netBegin];
+    const int slotCnt = waNets_.pinStart[netEnd] - slotBegin;
+    waExpPow1024(minExpX + slotBegin, slotCnt);
+    waExpPow1024(maxExpX + slotBegin, slotCnt);
+    waExpPow1024(minExpY + slotBegin, slotCnt);
+    waExpPow1024(maxExpY + slotBegin, slotCnt);
+
+    // sums are accumulated in pin order to keep the results reproducible
+    for (int netIdx = netBegin; netIdx < netEnd; netIdx++) {
+      float expMinSumX = 0, xExpMinSumX = 0;
+      float expMaxSumX = 0, xExpMaxSumX = 0;
+      float expMinSumY = 0, yExpMinSumY = 0;
+      float expMaxSumY = 0, yExpMaxSumY = 0;
+      for (int slot = waNets_.pinStart[netIdx];
+           slot < waNets_.pinStart[netIdx + 1];
+           slot++) {
+        expMinSumX += minExpX[slot];
+        xExpMinSumX += cx[slot] * minExpX[slot];
+        expMaxSumX += maxExpX[slot];
+        xExpMaxSumX += cx[slot] * maxExpX[slot];
+        expMinSumY += minExpY[slot];
+        yExpMinSumY += cy[slot] * minExpY[slot];
+        expMaxSumY += maxExpY[slot];
+        yExpMaxSumY += cy[slot] * maxExpY[slot];
       }
+      waNets_.expMinSumX[netIdx] = expMinSumX;
+      waNets_.xExpMinSumX[netIdx] = xExpMinSumX;
+      waNets_.expMaxSumX[netIdx] = expMaxSumX;
+      waNets_.xExpMaxSumX[netIdx] = xExpMaxSumX;
+      waNets_.expMinSumY[netIdx] = expMinSumY;
+      waNets_.yExpMinSumY[netIdx] = yExpMinSumY;
+      waNets_.expMaxSumY[netIdx] = expMaxSumY;
+      waNets_.yExpMaxSumY[netIdx] = yExpMaxSumY;
+    }
+  }
 
-      // min y
-      if (expMinY > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumY(fastExp(expMinY));
-        gNet->addWaExpMinSumY(gPin->minExpSumY());
-        gNet->addWaYExpMinSumY(gPin->cy() * gPin->minExpSumY());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MinY updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->minExpSumY());
-        }
-      }
+  if (log_->debugCheck(GPL, "wlUpdateWA", 1)) {
+    checkWireLengthForceWA(wlCoeffX, wlCoeffY);
+  }
+}
 
-      // max y
-      if (expMaxY > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumY(fastExp(expMaxY));
-        gNet->addWaExpMaxSumY(gPin->maxExpSumY());
-        gNet->addWaYExpMaxSumY(gPin->cy() * gPin->maxExpSumY());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MaxY updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->maxExpSumY());
-        }
+// Debug check of the vector WA kernel against the scalar fastExp path.
+void NesterovBaseCommon::checkWireLengthForceWA(float wlCoeffX,
+                                               float wlCoeffY) const
+{
+  const float forceBar = nbVars_.minWireLengthForceBar;
+  auto scalarExp
+      = [forceBar](float exp) { return exp > forceBar ? fastExp(exp) : 0; };
+
+  int mismatchCnt = 0;
+  for (size_t netIdx = 0; netIdx < gNetStor_.size(); netIdx++) {
+    const GNet& gNet = gNetStor_[netIdx];
+    for (int slot = waNets_.pinStart[netIdx];
+         slot < waNets_.pinStart[netIdx + 1];
+         slot++) {
+      const GPin& gPin = gPinStor_[waPins_.gPinIdx[slot]];
+      const float minExpX = scalarExp((gNet.lx() - gPin.cx()) * wlCoeffX);
+      const float maxExpX = scalarExp((gPin.cx() - gNet.ux()) * wlCoeffX);
+      const float minExpY = scalarExp((gNet.ly() - gPin.cy()) * wlCoeffY);
+      const float maxExpY = scalarExp((gPin.cy() - gNet.uy()) * wlCoeffY);
+      if (minExpX != waPins_.minExpX[slot] || maxExpX != waPins_.maxExpX[slot]
+          || minExpY != waPins_.minExpY[slot]
+          || maxExpY != waPins_.maxExpY[slot]) {
+        mismatchCnt++;
+      }
+      if (gPin.gCell() && gPin.gCell()->isInstance()) {
+        debugPrint(log_,
+                   GPL,
+                   "wlUpdateWA",
+                   1,
+                   "WA updated: {} X[{:g} {:g}] Y[{:g} {:g}]",
+                   gPin.gCell()->instance()->dbInst()->getConstName(),
+                   waPins_.minExpX[slot],
+                   waPins_.maxExpX[slot],
+                   waPins_.minExpY[slot],
+                   waPins_.maxExpY[slot]);
       }
     }
   }
+  debugPrint(log_,
+             GPL,
+             "wlUpdateWA",
+             1,
+             "WA kernel ({}): {} pins differ from the scalar path",
+             waKernelIsa(),
+             mismatchCnt);
 }
 
 // get x,y WA Gradient values with given GCell
@@ -1172,49 +1232,57 @@ FloatPoint NesterovBaseCommon::getWireLengthGradientPinWA(const GPin* gPin,
   float gradientMinX = 0, gradientMinY = 0;
   float gradientMaxX = 0, gradientMaxY = 0;
 
+  const int slot = waPinSlot_[gPin - gPinStor_.data()];
+  if (slot < 0) {
+    return FloatPoint(0, 0);
+  }
+  const int netIdx = gPin->gNet() - gNetStor_.data();
+  const int cx = gPin->cx();
+  const int cy = gPin->cy();
+
   // min x
-  if (gPin->hasMinExpSumX()) {
+  const float minExpX = waPins_.minExpX[slot];
+  if (minExpX != 0) {
     // from Net.
-    float waExpMinSumX = gPin->gNet()->waExpMinSumX();
-    float waXExpMinSumX = gPin->gNet()->waXExpMinSumX();
+    float waExpMinSumX = waNets_.expMinSumX[netIdx];
+    float waXExpMinSumX = waNets_.xExpMinSumX[netIdx];
 
-    gradientMinX
-        = (waExpMinSumX * (gPin->minExpSumX() * (1.0 - wlCoeffX * gPin->cx()))
-           + wlCoeffX * gPin->minExpSumX() * waXExpMinSumX)
-          / (waExpMinSumX * waExpMinSumX);
+    gradientMinX = (waExpMinSumX * (minExpX * (1.0 - wlCoeffX * cx))
+                    + wlCoeffX * minExpX * waXExpMinSumX)
+                   / (waExpMinSumX * waExpMinSumX);
   }
 
   // max x
-  if (gPin->hasMaxExpSumX()) {
-    float waExpMaxSumX = gPin->gNet()->waExpMaxSumX();
-    float waXExpMaxSumX = gPin->gNet()->waXExpMaxSumX();
+  const float maxExpX = waPins_.maxExpX[slot];
+  if (maxExpX != 0) {
+    float waExpMaxSumX = waNets_.expMaxSumX[netIdx];
+    float waXExpMaxSumX = waNets_.xExpMaxSumX[netIdx];
 
-    gradientMaxX
-        = (waExpMaxSumX * (gPin->maxExpSumX() * (1.0 + wlCoeffX * gPin->cx()))
-           - wlCoeffX * gPin->maxExpSumX() * waXExpMaxSumX)
-          / (waExpMaxSumX * waExpMaxSumX);
+    gradientMaxX = (waExpMaxSumX * (maxExpX * (1.0 + wlCoeffX * cx))
+                    - wlCoeffX * maxExpX * waXExpMaxSumX)
+                   / (waExpMaxSumX * waExpMaxSumX);
   }
 
   // min y
-  if (gPin->hasMinExpSumY()) {
-    float waExpMinSumY = gPin->gNet()->waExpMinSumY();
-    float waYExpMinSumY = gPin->gNet()->waYExpMinSumY();
+  const float minExpY = waPins_.minExpY[slot];
+  if (minExpY != 0) {
+    float waExpMinSumY = waNets_.expMinSumY[netIdx];
+    float waYExpMinSumY = waNets_.yExpMinSumY[netIdx];
 
-    gradientMinY
-        = (waExpMinSumY * (gPin->minExpSumY() * (1.0 - wlCoeffY * gPin->cy()))
-           + wlCoeffY * gPin->minExpSumY() * waYExpMinSumY)
-          / (waExpMinSumY * waExpMinSumY);
+    gradientMinY = (waExpMinSumY * (minExpY * (1.0 - wlCoeffY * cy))
+                    + wlCoeffY * minExpY * waYExpMinSumY)
+                   / (waExpMinSumY * waExpMinSumY);
   }
 
   // max y
-  if (gPin->hasMaxExpSumY()) {
-    float waExpMaxSumY = gPin->gNet()->waExpMaxSumY();
-    float waYExpMaxSumY = gPin->gNet()->waYExpMaxSumY();
+  const float maxExpY = waPins_.maxExpY[slot];
+  if (maxExpY != 0) {
+    float waExpMaxSumY = waNets_.expMaxSumY[netIdx];
+    float waYExpMaxSumY = waNets_.yExpMaxSumY[netIdx];
 
-    gradientMaxY
-        = (waExpMaxSumY * (gPin->maxExpSumY() * (1.0 + wlCoeffY * gPin->cy()))
-           - wlCoeffY * gPin->maxExpSumY() * waYExpMaxSumY)
-          / (waExpMaxSumY * waExpMaxSumY);
+    gradientMaxY = (waExpMaxSumY * (maxExpY * (1.0 + wlCoeffY * cy))
+                    - wlCoeffY * maxExpY * waYExpMaxSumY)
+                   / (waExpMaxSumY * waExpMaxSumY);
   }
 
   debugPrint(log_,
@@ -1335,6 +1403,7 @@ NesterovBase::NesterovBase(NesterovBaseVars nbVars,
 
   bg_.setPlacerBase(pb_);
   bg_.setLogger(log_);
+  bg_.setNumThreads(nbc_->getNumThreads());
   bg_.setCorePoints(&(pb_->die()));
   bg_.setTargetDensity(targetDensity_);
 
@@ -1342,8 +1411,11 @@ NesterovBase::NesterovBase(NesterovBaseVars nbVars,
   bg_.initBins();
 
   // initialize fft structrue based on bins
-  std::unique_ptr<FFT> fft(
-      new FFT(bg_.binCntX(), bg_.binCntY(), bg_.binSizeX(), bg_.binSizeY()));
+  std::unique_ptr<FFT> fft(new FFT(bg_.binCntX(),
+                                   bg_.binCntY(),
+                                   bg_.binSizeX(),
+                                   bg_.binSizeY(),
+                                   nbc_->getNumThreads()));
 
   fft_ = std::move(fft);
 
@@ -2483,9 +2555,15 @@ static float calculateBiVariateNormalCDF(biNormalParameters i)
 }
 //
 // https://codingforspeed.com/using-faster-exponential-approximation/
+// First step of fastExp; waExpPow1024 raises it to the 1024th power.
+static float fastExpBase(float exp)
+{
+  return 1.0f + exp / 1024.0f;
+}
+
 static float fastExp(float exp)
 {
-  exp = 1.0f + exp / 1024.0f;
+  exp = fastExpBase(exp);
   exp *= exp;
   exp *= exp;
   exp *= exp;
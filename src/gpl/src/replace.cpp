@@ -114,6 +114,7 @@ void Replace::reset()
   routabilityMaxInflationIter_ = 4;
 
   timingDrivenMode_ = true;
+  timingDrivenVirtualBuffering_ = false;
   routabilityDrivenMode_ = true;
   routabilityUseRudy_ = true;
   uniformTargetDensityMode_ = false;
@@ -333,6 +334,7 @@ bool Replace::initNesterovPlace(int threads)
     tb_ = std::make_shared<TimingBase>(nbc_, rs_, log_);
     tb_->setTimingNetWeightOverflows(timingNetWeightOverflows_);
     tb_->setTimingNetWeightMax(timingNetWeightMax_);
+    tb_->setVirtualBuffering(timingDrivenVirtualBuffering_);
   }
 
   if (!np_) {
@@ -374,7 +376,11 @@ int Replace::doNesterovPlace(int threads, int start_iter)
   if (timingDrivenMode_) {
     rs_->resizeSlackPreamble();
   }
-  return np_->doNesterovPlace(start_iter);
+  const int iter = np_->doNesterovPlace(start_iter);
+  if (timingDrivenMode_ && timingDrivenVirtualBuffering_) {
+    rs_->estimateResizeSlacksEnd();
+  }
+  return iter;
 }
 
 void Replace::setInitialPlaceMaxIter(int iter)
@@ -568,4 +574,9 @@ void Replace::setTimingNetWeightMax(float max)
   timingNetWeightMax_ = max;
 }
 
+void Replace::setTimingDrivenVirtualBuffering(bool mode)
+{
+  timingDrivenVirtualBuffering_ = mode;
+}
+
 }  // namespace gpl
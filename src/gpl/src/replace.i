@@ -271,6 +271,13 @@ set_timing_driven_net_weight_max_cmd(float max)
   return replace->setTimingNetWeightMax(max);
 }
 
+void
+set_timing_driven_virtual_buffering_cmd(bool virtual_buffering)
+{
+  Replace* replace = getReplace();
+  replace->setTimingDrivenVirtualBuffering(virtual_buffering);
+}
+
 
 
 void
@@ -62,6 +62,7 @@ sta::define_cmd_args "global_placement" {\
     [-timing_driven_net_reweight_overflow timing_driven_net_reweight_overflow]\
     [-timing_driven_net_weight_max timing_driven_net_weight_max]\
     [-timing_driven_nets_percentage timing_driven_nets_percentage]\
+    [-timing_driven_virtual_buffering]\
     [-pad_left pad_left]\
     [-pad_right pad_right]\
 }
@@ -88,6 +89,7 @@ proc global_placement { args } {
       -timing_driven \
       -routability_driven \
       -routability_use_grt \
+      -timing_driven_virtual_buffering \
       -disable_timing_driven \
       -disable_routability_driven \
       -skip_io \
@@ -141,6 +143,9 @@ proc global_placement { args } {
     if { [info exists keys(-timing_driven_nets_percentage)] } {
       rsz::set_worst_slack_nets_percent $keys(-timing_driven_nets_percentage)
     }
+
+    gpl::set_timing_driven_virtual_buffering_cmd \
+      [info exists flags(-timing_driven_virtual_buffering)]
   }
 
   if { [info exists flags(-disable_timing_driven)] } {
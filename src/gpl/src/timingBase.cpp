@@ -142,9 +142,18 @@ void TimingBase::setTimingNetWeightMax(float max)
   net_weight_max_ = max;
 }
 
+void TimingBase::setVirtualBuffering(bool mode)
+{
+  virtual_buffering_ = mode;
+}
+
 bool TimingBase::updateGNetWeights(float overflow)
 {
-  rs_->findResizeSlacks();
+  if (virtual_buffering_) {
+    rs_->estimateResizeSlacks();
+  } else {
+    rs_->findResizeSlacks();
+  }
 
   // get worst resize nets
   sta::NetSeq& worst_slack_nets = rs_->resizeWorstSlackNets();
@@ -66,6 +66,9 @@ class TimingBase
   size_t getTimingNetWeightOverflowSize() const;
 
   void setTimingNetWeightMax(float max);
+  // Estimate slacks with virtually buffered long wires instead of running
+  // repair_design on the netlist.
+  void setVirtualBuffering(bool mode);
 
   // updateNetWeight.
   // True: successfully reweighted gnets
@@ -80,6 +83,7 @@ class TimingBase
   std::vector<int> timingNetWeightOverflow_;
   std::vector<int> timingOverflowChk_;
   float net_weight_max_ = 1.9;
+  bool virtual_buffering_ = false;
   void initTimingOverflowChk();
 };
 
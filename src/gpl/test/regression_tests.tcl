@@ -3,6 +3,7 @@ record_tests {
   simple01-obs
   simple01-td
   simple01-td-tune
+  simple01-td-vb
   simple01-uniform
   simple01-ref
   simple01-skip-io
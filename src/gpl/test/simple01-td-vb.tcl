@@ -0,0 +1,36 @@
+# timing driven with virtual buffering. No wire of this design is longer
+# than the max wire length, so the placement matches simple01-td.
+source helpers.tcl
+set test_name simple01-td-vb
+read_liberty ./library/nangate45/NangateOpenCellLibrary_typical.lib
+
+read_lef ./nangate45.lef
+read_def ./simple01-td.def
+
+create_clock -name core_clock -period 2 clk
+
+set_wire_rc -signal -layer metal3
+set_wire_rc -clock  -layer metal5
+
+global_placement -timing_driven -timing_driven_virtual_buffering
+
+# parasitics left by the placer must match a fresh estimate
+report_worst_slack
+estimate_parasitics -placement
+report_worst_slack
+
+set def_file [make_result_file $test_name.def]
+write_def $def_file
+diff_file $def_file simple01-td.defok
+
+# A 100x wire resistance brings the max wire length below the length of
+# the critical nets, so virtual buffering must raise their slack.
+set_wire_rc -signal -resistance 3.574e-01 -capacitance 7.516e-02
+estimate_parasitics -placement
+set unbuffered_slack [sta::worst_slack -max]
+rsz::resize_slack_preamble
+rsz::estimate_resize_slacks
+set buffered_slack [sta::worst_slack -max]
+rsz::estimate_resize_slacks_end
+puts "virtual buffering raises worst slack:\
+  [expr $buffered_slack > $unbuffered_slack]"
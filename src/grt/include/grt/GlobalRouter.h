@@ -175,6 +175,8 @@ class GlobalRouter : public ant::GlobalRouteSource
                            float reduction_percentage);
   void setVerbose(const bool v);
   void setOverflowIterations(int iterations);
+  void setParallelMaze(bool parallel_maze);
+  void setNumThreads(int num_threads);
   void setCongestionReportIterStep(int congestion_report_iter_step);
   void setCongestionReportFile(const char* file_name);
   void setGridOrigin(int x, int y);
@@ -462,6 +464,8 @@ class GlobalRouter : public ant::GlobalRouteSource
   std::vector<RegionAdjustment> region_adjustments_;
 
   bool verbose_;
+  bool parallel_maze_;
+  int num_threads_;
   int min_layer_for_clock_;
   int max_layer_for_clock_;
 
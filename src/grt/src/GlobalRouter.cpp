@@ -98,6 +98,8 @@ GlobalRouter::GlobalRouter()
       macro_extension_(0),
       initialized_(false),
       verbose_(false),
+      parallel_maze_(false),
+      num_threads_(1),
       min_layer_for_clock_(-1),
       max_layer_for_clock_(-2),
       seed_(0),
@@ -1573,6 +1575,17 @@ void GlobalRouter::setOverflowIterations(int iterations)
   overflow_iterations_ = iterations;
 }
 
+void GlobalRouter::setParallelMaze(bool parallel_maze)
+{
+  parallel_maze_ = parallel_maze;
+}
+
+void GlobalRouter::setNumThreads(int num_threads)
+{
+  num_threads_ = num_threads;
+  fastroute_->setNumThreads(num_threads_);
+}
+
 void GlobalRouter::setCongestionReportIterStep(int congestion_report_iter_step)
 {
   congestion_report_iter_step_ = congestion_report_iter_step;
@@ -1685,6 +1698,8 @@ void GlobalRouter::configFastRoute()
 {
   fastroute_->setVerbose(verbose_);
   fastroute_->setOverflowIterations(overflow_iterations_);
+  fastroute_->setParallelMaze(parallel_maze_);
+  fastroute_->setNumThreads(num_threads_);
   fastroute_->setCongestionReportIterStep(congestion_report_iter_step_);
 
   if (congestion_file_name_ != nullptr) {
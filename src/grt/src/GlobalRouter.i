@@ -125,6 +125,12 @@ set_overflow_iterations(int iterations)
   getGlobalRouter()->setOverflowIterations(iterations);
 }
 
+void
+set_parallel_maze(bool parallel_maze)
+{
+  getGlobalRouter()->setParallelMaze(parallel_maze);
+}
+
 void
 set_congestion_report_iter_step(int congestion_report_iter_step)
 {
@@ -188,6 +194,8 @@ set_perturbation_amount(int perturbation)
 void
 global_route(bool start_incremental, bool end_incremental)
 {
+  const int num_threads = ord::OpenRoad::openRoad()->getThreadCount();
+  getGlobalRouter()->setNumThreads(num_threads);
   getGlobalRouter()->globalRoute(true, start_incremental, end_incremental);
 }
 
@@ -199,6 +199,7 @@ sta::define_cmd_args "global_route" {[-guide_file out_file] \
                                   [-allow_overflow] \
                                   [-overflow_iterations iterations] \
                                   [-verbose] \
+                                  [-parallel_maze] \
                                   [-start_incremental] \
                                   [-end_incremental]
 }
@@ -208,7 +209,8 @@ proc global_route { args } {
     keys {-guide_file -congestion_iterations -congestion_report_file \
           -overflow_iterations -grid_origin -critical_nets_percentage -congestion_report_iter_step
          } \
-    flags {-allow_congestion -allow_overflow -verbose -start_incremental -end_incremental}
+    flags {-allow_congestion -allow_overflow -verbose -parallel_maze \
+           -start_incremental -end_incremental}
 
   sta::check_argc_eq0 "global_route" $args
 
@@ -221,6 +223,7 @@ proc global_route { args } {
   }
 
   grt::set_verbose [info exists flags(-verbose)]
+  grt::set_parallel_maze [info exists flags(-parallel_maze)]
 
   if { [info exists keys(-grid_origin)] } {
     set origin $keys(-grid_origin)
@@ -68,6 +68,12 @@ enum class Direction
   Down
 };
 
+struct parent3D
+{
+  short l;
+  int x, y;
+};
+
 enum class EdgeDirection
 {
   Horizontal,
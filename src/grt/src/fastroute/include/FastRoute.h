@@ -36,10 +36,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <boost/functional/hash.hpp>
 #include <boost/icl/interval.hpp>
 #include <boost/icl/interval_set.hpp>
 #include <boost/multi_array.hpp>
+#include <cstdint>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -196,6 +198,8 @@ class FastRouteCore
   float getCriticalNetsPercentage() { return critical_nets_percentage_; };
   void setMakeWireParasiticsBuilder(AbstractMakeWireParasitics* builder);
   void setOverflowIterations(int iterations);
+  void setParallelMaze(bool parallel_maze);
+  void setNumThreads(int num_threads);
   void setCongestionReportIterStep(int congestion_report_iter_step);
   void setCongestionReportFile(const char* congestion_file_name);
   void setGridMax(int x_max, int y_max);
@@ -245,6 +249,83 @@ class FastRouteCore
   NetRouteMap getRoutes();
   NetRouteMap getPlanarRoutes();
 
+  // Buffers of one thread of the 2D maze router
+  struct MazeScratch
+  {
+    std::vector<float*> src_heap;
+    std::vector<float*> dest_heap;
+    std::vector<bool> pop_heap2;
+    std::vector<OrderNetEdge> net_eo;
+    std::set<std::pair<int, int>> h_used_ggrid;
+    std::set<std::pair<int, int>> v_used_ggrid;
+    int enlarge = -1;  // enlargement of the last rerouted edge
+
+    // Search generation that last reached each grid of d1. Grids of older
+    // generations are reset on first access instead of clearing the whole
+    // routing region before each search.
+    std::vector<uint32_t> d1_generation;
+    uint32_t generation = 0;
+
+    void newSearch()
+    {
+      if (++generation == 0) {
+        std::fill(d1_generation.begin(), d1_generation.end(), 0);
+        generation = 1;
+      }
+    }
+    void reach(const multi_array<float, 2>& d1, const float* dist)
+    {
+      d1_generation[dist - d1.data()] = generation;
+    }
+    void touch(multi_array<float, 2>& d1, const int y, const int x)
+    {
+      float& dist = d1[y][x];
+      uint32_t& dist_generation = d1_generation[&dist - d1.data()];
+      if (dist_generation != generation) {
+        dist_generation = generation;
+        dist = BIG_INT;
+      }
+    }
+  };
+
+  // Buffers of one thread of the 3D maze router
+  struct MazeScratch3D
+  {
+    std::vector<int*> src_heap;
+    std::vector<int*> dest_heap;
+    std::vector<bool> pop_heap2;
+    std::set<std::pair<int, int>> h_used_ggrid;
+    std::set<std::pair<int, int>> v_used_ggrid;
+
+    // Same generation scheme as MazeScratch, over all the layers of d1_3D
+    std::vector<uint32_t> d1_generation;
+    uint32_t generation = 0;
+
+    void newSearch()
+    {
+      if (++generation == 0) {
+        std::fill(d1_generation.begin(), d1_generation.end(), 0);
+        generation = 1;
+      }
+    }
+    void reach(const multi_array<int, 3>& d1_3D, const int* dist)
+    {
+      d1_generation[dist - d1_3D.data()] = generation;
+    }
+    void touch(multi_array<int, 3>& d1_3D,
+               const int l,
+               const int y,
+               const int x)
+    {
+      int& dist = d1_3D[l][y][x];
+      uint32_t& dist_generation = d1_generation[&dist - d1_3D.data()];
+      if (dist_generation != generation) {
+        dist_generation = generation;
+        dist = BIG_INT;
+      }
+    }
+  };
+
   // maze functions
   // Maze-routing in different orders
   void mazeRouteMSMD(const int iter,
@@ -259,6 +340,28 @@ class FastRouteCore
                      const int slope,
                      const int L,
                      float& slack_th);
+  bool mazeRouteMSMDNet(const int netID,
+                        const int iter,
+                        const int expand,
+                        const float cost_height,
+                        const int ripup_threshold,
+                        const int maze_edge_threshold,
+                        const int cost_type,
+                        const float logis_cof,
+                        const int via,
+                        const int slope,
+                        const int L,
+                        const float slack_th,
+                        multi_array<float, 2>& d1,
+                        multi_array<float, 2>& d2,
+                        MazeScratch& scratch,
+                        const odb::Rect* footprint);
+  odb::Rect mazeRouteFootprint(const int netID, const int expand) const;
+  std::vector<std::vector<int>> mazeRouteBatches(
+      const std::vector<int>& net_order,
+      const int expand,
+      std::vector<odb::Rect>& footprints) const;
+  void initMazeScratches(int num_scratches);
   void convertToMazeroute();
   void updateCongestionHistory(const int upType, bool stopDEC, int& max_adj);
   int getOverflow2D(int* maxOverflow);
@@ -337,13 +440,29 @@ class FastRouteCore
 
   // maze3D functions
   void mazeRouteMSMDOrder3D(int expand, int ripupTHlb, int ripupTHub);
+  void initMazeScratches3D(int num_scratches);
+  void mazeRouteMSMDOrder3DNet(int netID,
+                               int expand,
+                               int ripupTHlb,
+                               int ripupTHub,
+                               multi_array<Direction, 3>& directions_3D,
+                               multi_array<int, 3>& corr_edge_3D,
+                               multi_array<parent3D, 3>& pr_3D,
+                               multi_array<int, 3>& d1_3D,
+                               multi_array<int, 3>& d2_3D,
+                               MazeScratch3D& scratch,
+                               const odb::Rect* footprint);
   void addNeighborPoints(int netID,
                          int n1,
                          int n2,
                          std::vector<int*>& points_heap_3D,
                          multi_array<int, 3>& dist_3D,
                          multi_array<Direction, 3>& directions_3D,
-                         multi_array<int, 3>& corr_edge_3D);
+                         multi_array<int, 3>& corr_edge_3D,
+                         int regionX1,
+                         int regionX2,
+                         int regionY1,
+                         int regionY2);
   void setupHeap3D(int netID,
                    int edgeID,
                    std::vector<int*>& src_heap_3D,
@@ -498,15 +617,19 @@ class FastRouteCore
                          int& best_cost,
                          multi_array<int, 2>& layer_grid);
   void assignEdge(int netID, int edgeID, bool processDIR);
-  void recoverEdge(int netID, int edgeID);
+  void recoverEdge(int netID,
+                   int edgeID,
+                   std::set<std::pair<int, int>>& h_used_ggrid,
+                   std::set<std::pair<int, int>>& v_used_ggrid);
   void layerAssignmentV4();
+  void layerAssignmentV4Net(int netID);
   void netpinOrderInc();
   void checkRoute3D();
   void StNetOrder();
   float CalculatePartialSlack();
   bool checkRoute2DTree(int netID);
   void removeLoops();
-  void netedgeOrderDec(int netID);
+  void netedgeOrderDec(int netID, std::vector<OrderNetEdge>& net_eo);
   void printTree2D(int netID);
   void printEdge2D(int netID, int edgeID);
   void printEdge3D(int netID, int edgeID);
@@ -565,6 +688,8 @@ class FastRouteCore
   bool has_2D_overflow_;
   int grid_hv_;
   bool verbose_;
+  bool parallel_maze_;  // route nets with disjoint footprints in parallel
+  int num_threads_;
   float critical_nets_percentage_;
   int via_cost_;
   int mazeedge_threshold_;
@@ -594,7 +719,6 @@ class FastRouteCore
 
   std::vector<FrNet*> nets_;
   std::unordered_map<odb::dbNet*, int> db_net_id_map_;  // db net -> net id
-  std::vector<OrderNetEdge> net_eo_;
   std::vector<std::vector<int>>
       gxs_;  // the copy of xs for nets, used for second FLUTE
   std::vector<std::vector<int>>
@@ -617,7 +741,17 @@ class FastRouteCore
   multi_array<bool, 2> hv_;
   multi_array<bool, 2> hyper_v_;
   multi_array<bool, 2> hyper_h_;
-  multi_array<bool, 2> in_region_;
+
+  // Maze routing buffers, sized once per grid and kept between calls
+  multi_array<float, 2> maze_d1_;
+  multi_array<float, 2> maze_d2_;
+  std::vector<MazeScratch> maze_scratches_;
+  multi_array<Direction, 3> directions_3D_;
+  multi_array<int, 3> corr_edge_3D_;
+  multi_array<parent3D, 3> pr_3D_;
+  multi_array<int, 3> d1_3D_;
+  multi_array<int, 3> d2_3D_;
+  std::vector<MazeScratch3D> maze_scratches_3D_;
 
   std::vector<StTree> sttrees_;  // the Steiner trees
   std::vector<StTree> sttrees_bk_;
@@ -635,6 +769,9 @@ class FastRouteCore
 
   std::set<std::pair<int, int>> h_used_ggrid_;
   std::set<std::pair<int, int>> v_used_ggrid_;
+  // 2D edges whose last_usage/congCNT may be non-zero from a previous run.
+  std::set<std::pair<int, int>> h_history_ggrid_;
+  std::set<std::pair<int, int>> v_history_ggrid_;
   std::vector<int> net_ids_;
 };
 
@@ -75,6 +75,8 @@ FastRouteCore::FastRouteCore(odb::dbDatabase* db,
       has_2D_overflow_(false),
       grid_hv_(0),
       verbose_(false),
+      parallel_maze_(false),
+      num_threads_(1),
       critical_nets_percentage_(10),
       via_cost_(0),
       mazeedge_threshold_(0),
@@ -123,8 +125,6 @@ void FastRouteCore::clear()
   parent_x3_.resize(boost::extents[0][0]);
   parent_y3_.resize(boost::extents[0][0]);
 
-  net_eo_.clear();
-
   xcor_.clear();
   ycor_.clear();
   dcor_.clear();
@@ -134,7 +134,15 @@ void FastRouteCore::clear()
   hyper_h_.resize(boost::extents[0][0]);
   corr_edge_.resize(boost::extents[0][0]);
 
-  in_region_.resize(boost::extents[0][0]);
+  maze_d1_.resize(boost::extents[0][0]);
+  maze_d2_.resize(boost::extents[0][0]);
+  maze_scratches_.clear();
+  directions_3D_.resize(boost::extents[0][0][0]);
+  corr_edge_3D_.resize(boost::extents[0][0][0]);
+  pr_3D_.resize(boost::extents[0][0][0]);
+  d1_3D_.resize(boost::extents[0][0][0]);
+  d2_3D_.resize(boost::extents[0][0][0]);
+  maze_scratches_3D_.clear();
 
   v_capacity_3D_.clear();
   h_capacity_3D_.clear();
@@ -199,8 +207,6 @@ void FastRouteCore::setGridsAndLayers(int x, int y, int nLayers)
   hyper_h_.resize(boost::extents[y_range_][x_range_]);
   corr_edge_.resize(boost::extents[y_range_][x_range_]);
 
-  in_region_.resize(boost::extents[y_range_][x_range_]);
-
   cost_hvh_.resize(x_range_);  // Horizontal first Z
   cost_vhv_.resize(y_range_);  // Vertical first Z
   cost_h_.resize(y_range_);    // Horizontal segment cost
@@ -329,6 +335,9 @@ void FastRouteCore::initEdges()
   v_edges_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
   h_edges_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
 
+  h_history_ggrid_.clear();
+  v_history_ggrid_.clear();
+
   for (int i = 0; i < y_grid_; i++) {
     for (int j = 0; j < x_grid_; j++) {
       // 2D edge initialization
@@ -671,10 +680,16 @@ void FastRouteCore::initAuxVar()
 
   grid_hv_ = x_range_ * y_range_;
 
-  parent_x1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_x3_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y3_.resize(boost::extents[y_grid_][x_grid_]);
+  // The parent arrays are scratch space fully written before being read, so
+  // incremental runs on the same grid reuse them instead of reallocating.
+  const auto shape = parent_x1_.shape();
+  if (shape[0] != static_cast<size_t>(y_grid_)
+      || shape[1] != static_cast<size_t>(x_grid_)) {
+    parent_x1_.resize(boost::extents[y_grid_][x_grid_]);
+    parent_y1_.resize(boost::extents[y_grid_][x_grid_]);
+    parent_x3_.resize(boost::extents[y_grid_][x_grid_]);
+    parent_y3_.resize(boost::extents[y_grid_][x_grid_]);
+  }
 }
 
 NetRouteMap FastRouteCore::getRoutes()
@@ -970,7 +985,6 @@ NetRouteMap FastRouteCore::run()
   xcor_.resize(max_degree2);
   ycor_.resize(max_degree2);
   dcor_.resize(max_degree2);
-  net_eo_.reserve(max_degree2);
 
   int THRESH_M = 20;
   const int ENLARGE = 15;  // 5
@@ -1389,8 +1403,10 @@ NetRouteMap FastRouteCore::run()
   }
 
   NetRouteMap routes = getRoutes();
-  net_eo_.clear();
   net_ids_.clear();
+  // Edges touched by this run may carry congestion history into the next.
+  h_history_ggrid_.insert(h_used_ggrid_.begin(), h_used_ggrid_.end());
+  v_history_ggrid_.insert(v_used_ggrid_.begin(), v_used_ggrid_.end());
   return routes;
 }
 
@@ -1415,6 +1431,16 @@ void FastRouteCore::setOverflowIterations(int iterations)
   overflow_iterations_ = iterations;
 }
 
+void FastRouteCore::setParallelMaze(bool parallel_maze)
+{
+  parallel_maze_ = parallel_maze;
+}
+
+void FastRouteCore::setNumThreads(int num_threads)
+{
+  num_threads_ = num_threads;
+}
+
 void FastRouteCore::setCongestionReportIterStep(int congestion_report_iter_step)
 {
   congestion_report_iter_step_ = congestion_report_iter_step;
@@ -30,16 +30,29 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <deque>
+#include <limits>
 
 #include "DataType.h"
 #include "FastRoute.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
 using utl::GRT;
 
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+using BgPoint = bg::model::d2::point_xy<int, bg::cs::cartesian>;
+using BgBox = bg::model::box<BgPoint>;
+
 static int parent_index(int i)
 {
   return (i - 1) / 2;
@@ -501,18 +514,16 @@ void FastRouteCore::convertToMazeroute()
     convertToMazerouteNet(netID);
   }
 
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_ - 1; j++) {
-      // Add to keep the usage values of the last incremental routing performed
-      h_edges_[i][j].usage += h_edges_[i][j].est_usage;
-    }
+  // est_usage is only ever raised on edges recorded in the used sets, so
+  // visiting those keeps incremental runs proportional to the touched nets.
+  for (const auto& [i, j] : h_used_ggrid_) {
+    // Add to keep the usage values of the last incremental routing performed
+    h_edges_[i][j].usage += h_edges_[i][j].est_usage;
   }
 
-  for (int i = 0; i < y_grid_ - 1; i++) {
-    for (int j = 0; j < x_grid_; j++) {
-      // Add to keep the usage values of the last incremental routing performed
-      v_edges_[i][j].usage += v_edges_[i][j].est_usage;
-    }
+  for (const auto& [i, j] : v_used_ggrid_) {
+    // Add to keep the usage values of the last incremental routing performed
+    v_edges_[i][j].usage += v_edges_[i][j].est_usage;
   }
 
   // check 2D edges for invalid usage values
@@ -739,10 +750,9 @@ void FastRouteCore::setupHeap(const int netID,
                               const int regionY1,
                               const int regionY2)
 {
-  for (int i = regionY1; i <= regionY2; i++) {
-    for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = true;
-  }
+  const auto inRegion = [=](const int x, const int y) {
+    return x >= regionX1 && x <= regionX2 && y >= regionY1 && y <= regionY2;
+  };
 
   const auto& treeedges = sttrees_[netID].edges;
   const auto& treenodes = sttrees_[netID].nodes;
@@ -808,7 +818,7 @@ void FastRouteCore::setupHeap(const int netID,
         if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
           // put nbr into src_heap if in enlarged region
           const TreeNode& nbr_node = treenodes[nbr];
-          if (in_region_[nbr_node.y][nbr_node.x]) {
+          if (inRegion(nbr_node.x, nbr_node.y)) {
             const int nbrX = nbr_node.x;
             const int nbrY = nbr_node.y;
             d1[nbrY][nbrX] = 0;
@@ -825,7 +835,7 @@ void FastRouteCore::setupHeap(const int netID,
             const int x_grid = route->gridsX[j];
             const int y_grid = route->gridsY[j];
 
-            if (in_region_[y_grid][x_grid]) {
+            if (inRegion(x_grid, y_grid)) {
               d1[y_grid][x_grid] = 0;
               src_heap.push_back(&d1[y_grid][x_grid]);
               corr_edge_[y_grid][x_grid] = edge;
@@ -878,7 +888,7 @@ void FastRouteCore::setupHeap(const int netID,
         if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
           // put nbr into dest_heap
           const TreeNode& nbr_node = treenodes[nbr];
-          if (in_region_[nbr_node.y][nbr_node.x]) {
+          if (inRegion(nbr_node.x, nbr_node.y)) {
             const int nbrX = nbr_node.x;
             const int nbrY = nbr_node.y;
             d2[nbrY][nbrX] = 0;
@@ -895,7 +905,7 @@ void FastRouteCore::setupHeap(const int netID,
           for (int j = 1; j < route->routelen; j++) {
             const int x_grid = route->gridsX[j];
             const int y_grid = route->gridsY[j];
-            if (in_region_[y_grid][x_grid]) {
+            if (inRegion(x_grid, y_grid)) {
               d2[y_grid][x_grid] = 0;
               dest_heap.push_back(&d2[y_grid][x_grid]);
               corr_edge_[y_grid][x_grid] = edge;
@@ -909,11 +919,6 @@ void FastRouteCore::setupHeap(const int netID,
       }  // loop i (3 neigbors for cur node)
     }    // while queue is not empty
   }      // net with more than two pins
-
-  for (int i = regionY1; i <= regionY2; i++) {
-    for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = false;
-  }
 }
 
 int FastRouteCore::copyGrids(const std::vector<TreeNode>& treenodes,
@@ -1303,830 +1308,1056 @@ float getCost(const int i,
   return cost;
 }
 
-void FastRouteCore::mazeRouteMSMD(const int iter,
-                                  const int expand,
-                                  const float cost_height,
-                                  const int ripup_threshold,
-                                  const int maze_edge_threshold,
-                                  const bool ordering,
-                                  const int cost_type,
-                                  const float logis_cof,
-                                  const int via,
-                                  const int slope,
-                                  const int L,
-                                  float& slack_th)
+bool FastRouteCore::mazeRouteMSMDNet(const int netID,
+                                     const int iter,
+                                     const int expand,
+                                     const float cost_height,
+                                     const int ripup_threshold,
+                                     const int maze_edge_threshold,
+                                     const int cost_type,
+                                     const float logis_cof,
+                                     const int via,
+                                     const int slope,
+                                     const int L,
+                                     const float slack_th,
+                                     multi_array<float, 2>& d1,
+                                     multi_array<float, 2>& d2,
+                                     MazeScratch& scratch,
+                                     const odb::Rect* footprint)
 {
-  // maze routing for multi-source, multi-destination
   int tmpX, tmpY;
+  const int num_terminals = sttrees_[netID].num_terminals;
 
-  const int max_usage_multiplier = 40;
-
-  // allocate memory for distance and parent and pop_heap
-  h_cost_table_.resize(max_usage_multiplier * h_capacity_);
-  v_cost_table_.resize(max_usage_multiplier * v_capacity_);
-
-  for (int i = 0; i < max_usage_multiplier * h_capacity_; i++) {
-    h_cost_table_[i]
-        = getCost(i, logis_cof, cost_height, slope, h_capacity_, cost_type);
-  }
-  for (int i = 0; i < max_usage_multiplier * v_capacity_; i++) {
-    v_cost_table_[i]
-        = getCost(i, logis_cof, cost_height, slope, v_capacity_, cost_type);
-  }
+  const int origENG = expand;
 
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_; j++)
-      in_region_[i][j] = false;
-  }
+  netedgeOrderDec(netID, scratch.net_eo);
 
-  if (ordering) {
-    if (critical_nets_percentage_) {
-      slack_th = CalculatePartialSlack();
+  auto& treeedges = sttrees_[netID].edges;
+  auto& treenodes = sttrees_[netID].nodes;
+  // loop for all the tree edges
+  const int num_edges = sttrees_[netID].num_edges();
+  for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
+    const int edgeID = scratch.net_eo[edgeREC].edgeID;
+    TreeEdge* treeedge = &(treeedges[edgeID]);
+
+    int n1 = treeedge->n1;
+    int n2 = treeedge->n2;
+    const int n1x = treenodes[n1].x;
+    const int n1y = treenodes[n1].y;
+    const int n2x = treenodes[n2].x;
+    const int n2y = treenodes[n2].y;
+    treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
+
+    if (treeedge->len
+        <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
+    {
+      continue;
     }
-    StNetOrder();
-  }
-
-  std::vector<float*> src_heap;
-  std::vector<float*> dest_heap;
-  src_heap.reserve(y_grid_ * x_grid_);
-  dest_heap.reserve(y_grid_ * x_grid_);
 
-  multi_array<float, 2> d1(boost::extents[y_range_][x_range_]);
-  multi_array<float, 2> d2(boost::extents[y_range_][x_range_]);
+    const bool enter = newRipupCheck(treeedge,
+                                     n1x,
+                                     n1y,
+                                     n2x,
+                                     n2y,
+                                     ripup_threshold,
+                                     slack_th,
+                                     netID,
+                                     edgeID);
 
-  std::vector<bool> pop_heap2(y_grid_ * x_range_, false);
-
-  for (int nidRPC = 0; nidRPC < net_ids_.size(); nidRPC++) {
-    const int netID
-        = ordering ? tree_order_cong_[nidRPC].treeIndex : net_ids_[nidRPC];
-
-    const int num_terminals = sttrees_[netID].num_terminals;
-
-    const int origENG = expand;
-
-    netedgeOrderDec(netID);
-
-    auto& treeedges = sttrees_[netID].edges;
-    auto& treenodes = sttrees_[netID].nodes;
-    // loop for all the tree edges
-    const int num_edges = sttrees_[netID].num_edges();
-    for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
-      const int edgeID = net_eo_[edgeREC].edgeID;
-      TreeEdge* treeedge = &(treeedges[edgeID]);
-
-      int n1 = treeedge->n1;
-      int n2 = treeedge->n2;
-      const int n1x = treenodes[n1].x;
-      const int n1y = treenodes[n1].y;
-      const int n2x = treenodes[n2].x;
-      const int n2y = treenodes[n2].y;
-      treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
-
-      if (treeedge->len
-          <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
-      {
-        continue;
-      }
+    if (!enter) {
+      continue;
+    }
 
-      const bool enter = newRipupCheck(treeedge,
-                                       n1x,
-                                       n1y,
-                                       n2x,
-                                       n2y,
-                                       ripup_threshold,
-                                       slack_th,
-                                       netID,
-                                       edgeID);
-
-      if (!enter) {
-        continue;
+    // ripup the routing for the edge
+    const int ymin = std::min(n1y, n2y);
+    const int ymax = std::max(n1y, n2y);
+
+    const int xmin = std::min(n1x, n2x);
+    const int xmax = std::max(n1x, n2x);
+
+    const int enlarge
+        = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+    scratch.enlarge = enlarge;
+
+    int decrease = 0;
+
+    if (nets_[netID]->isCritical()) {
+      decrease = std::min((iter / 7) * 5, enlarge / 2);
+    }
+    int regionX1 = std::max(xmin - enlarge + decrease, 0);
+    int regionX2 = std::min(xmax + enlarge - decrease, x_grid_ - 1);
+    int regionY1 = std::max(ymin - enlarge + decrease, 0);
+    int regionY2 = std::min(ymax + enlarge - decrease, y_grid_ - 1);
+    if (footprint != nullptr) {
+      // The tree nodes may have moved onto routes of earlier edges, so the
+      // region can reach past the footprint reserved for the net's batch.
+      regionX1 = std::max(regionX1, footprint->xMin());
+      regionX2 = std::min(regionX2, footprint->xMax());
+      regionY1 = std::max(regionY1, footprint->yMin());
+      regionY2 = std::min(regionY2, footprint->yMax());
+    }
+
+    // grids of d1 are reset to BIG_INT when the search first reaches them,
+    // and hyper_h_/hyper_v_ when they are first put into src_heap. d2 is only
+    // used to index pop_heap2 and needs no reset.
+    scratch.newSearch();
+
+    // The heaps only hold grids of the routing region
+    const int region_size
+        = (regionX2 - regionX1 + 1) * (regionY2 - regionY1 + 1);
+    scratch.src_heap.reserve(region_size);
+    scratch.dest_heap.reserve(region_size);
+
+    // setup src_heap, dest_heap and initialize d1[][] and d2[][] for all the
+    // grids on the two subtrees
+    setupHeap(netID,
+              edgeID,
+              scratch.src_heap,
+              scratch.dest_heap,
+              d1,
+              d2,
+              regionX1,
+              regionX2,
+              regionY1,
+              regionY2);
+    for (const float* dist : scratch.src_heap) {
+      scratch.reach(d1, dist);
+    }
+
+    // while loop to find shortest path
+    int ind1 = (scratch.src_heap[0] - &d1[0][0]);
+    for (int i = 0; i < scratch.dest_heap.size(); i++)
+      scratch.pop_heap2[(scratch.dest_heap[i] - &d2[0][0])] = true;
+
+    // stop when the grid position been popped out from both src_heap and
+    // dest_heap
+    while (scratch.pop_heap2[ind1] == false) {
+      // relax all the adjacent grids within the enlarged region for
+      // source subtree
+      const int curX = ind1 % x_range_;
+      const int curY = ind1 / x_range_;
+      int preX, preY;
+      if (d1[curY][curX] != 0) {
+        if (hv_[curY][curX]) {
+          preX = parent_x1_[curY][curX];
+          preY = parent_y1_[curY][curX];
+        } else {
+          preX = parent_x3_[curY][curX];
+          preY = parent_y3_[curY][curX];
+        }
+      } else {
+        preX = curX;
+        preY = curY;
       }
 
-      // ripup the routing for the edge
-      const int ymin = std::min(n1y, n2y);
-      const int ymax = std::max(n1y, n2y);
+      removeMin(scratch.src_heap);
 
-      const int xmin = std::min(n1x, n2x);
-      const int xmax = std::max(n1x, n2x);
+      // left
+      if (curX > regionX1) {
+        float tmp, cost1, cost2;
+        const int pos1 = h_edges_[curY][curX - 1].usage_red()
+                         + L * h_edges_[curY][(curX - 1)].last_usage;
 
-      enlarge_ = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
 
-      int decrease = 0;
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curX < regionX2 - 1) {
+            const int pos2 = h_edges_[curY][curX].usage_red()
+                             + L * h_edges_[curY][curX].last_usage;
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+
+            scratch.touch(d1, curY, curX + 1);
+            const int tmp_cost = d1[curY][curX + 1] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h_[curY][curX] = true;
+            }
+          }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpX = curX - 1;  // the left neighbor
 
-      if (nets_[netID]->isCritical()) {
-        decrease = std::min((iter / 7) * 5, enlarge_ / 2);
-      }
-      const int regionX1 = std::max(xmin - enlarge_ + decrease, 0);
-      const int regionX2 = std::min(xmax + enlarge_ - decrease, x_grid_ - 1);
-      const int regionY1 = std::max(ymin - enlarge_ + decrease, 0);
-      const int regionY2 = std::min(ymax + enlarge_ - decrease, y_grid_ - 1);
-
-      // initialize d1[][] and d2[][] as BIG_INT
-      for (int i = regionY1; i <= regionY2; i++) {
-        for (int j = regionX1; j <= regionX2; j++) {
-          d1[i][j] = BIG_INT;
-          d2[i][j] = BIG_INT;
-          hyper_h_[i][j] = false;
-          hyper_v_[i][j] = false;
+        scratch.touch(d1, curY, tmpX);
+        if (d1[curY][tmpX]
+            >= BIG_INT)  // left neighbor not been put into src_heap
+        {
+          d1[curY][tmpX] = tmp;
+          hyper_h_[curY][tmpX] = false;
+          hyper_v_[curY][tmpX] = false;
+          parent_x3_[curY][tmpX] = curX;
+          parent_y3_[curY][tmpX] = curY;
+          hv_[curY][tmpX] = false;
+          scratch.src_heap.push_back(&d1[curY][tmpX]);
+          updateHeap(scratch.src_heap, scratch.src_heap.size() - 1);
+        } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3_[curY][tmpX] = curX;
+          parent_y3_[curY][tmpX] = curY;
+          hv_[curY][tmpX] = false;
+          float* dtmp = &d1[curY][tmpX];
+          int ind = 0;
+          while (scratch.src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(scratch.src_heap, ind);
         }
       }
-
-      // setup src_heap, dest_heap and initialize d1[][] and d2[][] for all the
-      // grids on the two subtrees
-      setupHeap(netID,
-                edgeID,
-                src_heap,
-                dest_heap,
-                d1,
-                d2,
-                regionX1,
-                regionX2,
-                regionY1,
-                regionY2);
-
-      // while loop to find shortest path
-      int ind1 = (src_heap[0] - &d1[0][0]);
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = true;
-
-      // stop when the grid position been popped out from both src_heap and
-      // dest_heap
-      while (pop_heap2[ind1] == false) {
-        // relax all the adjacent grids within the enlarged region for
-        // source subtree
-        const int curX = ind1 % x_range_;
-        const int curY = ind1 / x_range_;
-        int preX, preY;
-        if (d1[curY][curX] != 0) {
-          if (hv_[curY][curX]) {
-            preX = parent_x1_[curY][curX];
-            preY = parent_y1_[curY][curX];
-          } else {
-            preX = parent_x3_[curY][curX];
-            preY = parent_y3_[curY][curX];
-          }
+      // right
+      if (curX < regionX2) {
+        float tmp, cost1, cost2;
+        const int pos1 = h_edges_[curY][curX].usage_red()
+                         + L * h_edges_[curY][curX].last_usage;
+
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
+
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
         } else {
-          preX = curX;
-          preY = curY;
-        }
-
-        removeMin(src_heap);
-
-        // left
-        if (curX > regionX1) {
-          float tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX - 1].usage_red()
-                           + L * h_edges_[curY][(curX - 1)].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX < regionX2 - 1) {
-              const int pos2 = h_edges_[curY][curX].usage_red()
-                               + L * h_edges_[curY][curX].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY][curX + 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
+          if (curX > regionX1 + 1) {
+            const int pos2 = h_edges_[curY][curX - 1].usage_red()
+                             + L * h_edges_[curY][curX - 1].last_usage;
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+            scratch.touch(d1, curY, curX - 1);
+            const int tmp_cost = d1[curY][curX - 1] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h_[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX - 1;  // the left neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // left neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
         }
-        // right
-        if (curX < regionX2) {
-          float tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX].usage_red()
-                           + L * h_edges_[curY][curX].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX > regionX1 + 1) {
-              const int pos2 = h_edges_[curY][curX - 1].usage_red()
-                               + L * h_edges_[curY][curX - 1].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY][curX - 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
-            }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX + 1;  // the right neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // right neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
-          }
+        tmpX = curX + 1;  // the right neighbor
+
+        scratch.touch(d1, curY, tmpX);
+        if (d1[curY][tmpX]
+            >= BIG_INT)  // right neighbor not been put into src_heap
+        {
+          d1[curY][tmpX] = tmp;
+          hyper_h_[curY][tmpX] = false;
+          hyper_v_[curY][tmpX] = false;
+          parent_x3_[curY][tmpX] = curX;
+          parent_y3_[curY][tmpX] = curY;
+          hv_[curY][tmpX] = false;
+          scratch.src_heap.push_back(&d1[curY][tmpX]);
+          updateHeap(scratch.src_heap, scratch.src_heap.size() - 1);
+        } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3_[curY][tmpX] = curX;
+          parent_y3_[curY][tmpX] = curY;
+          hv_[curY][tmpX] = false;
+          float* dtmp = &d1[curY][tmpX];
+          int ind = 0;
+          while (scratch.src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(scratch.src_heap, ind);
         }
-        // bottom
-        if (curY > regionY1) {
-          float tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY - 1][curX].usage_red()
-                           + L * v_edges_[curY - 1][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY < regionY2 - 1) {
-              const int pos2 = v_edges_[curY][curX].usage_red()
-                               + L * v_edges_[curY][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY + 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+      }
+      // bottom
+      if (curY > regionY1) {
+        float tmp, cost1, cost2;
+        const int pos1 = v_edges_[curY - 1][curX].usage_red()
+                         + L * v_edges_[curY - 1][curX].last_usage;
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY < regionY2 - 1) {
+            const int pos2 = v_edges_[curY][curX].usage_red()
+                             + L * v_edges_[curY][curX].last_usage;
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+            scratch.touch(d1, curY + 1, curX);
+            const int tmp_cost = d1[curY + 1][curX] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v_[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY - 1;  // the bottom neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // bottom neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpY = curY - 1;  // the bottom neighbor
+        scratch.touch(d1, tmpY, curX);
+        if (d1[tmpY][curX]
+            >= BIG_INT)  // bottom neighbor not been put into src_heap
+        {
+          d1[tmpY][curX] = tmp;
+          hyper_h_[tmpY][curX] = false;
+          hyper_v_[tmpY][curX] = false;
+          parent_x1_[tmpY][curX] = curX;
+          parent_y1_[tmpY][curX] = curY;
+          hv_[tmpY][curX] = true;
+          scratch.src_heap.push_back(&d1[tmpY][curX]);
+          updateHeap(scratch.src_heap, scratch.src_heap.size() - 1);
+        } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1_[tmpY][curX] = curX;
+          parent_y1_[tmpY][curX] = curY;
+          hv_[tmpY][curX] = true;
+          float* dtmp = &d1[tmpY][curX];
+          int ind = 0;
+          while (scratch.src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(scratch.src_heap, ind);
         }
-        // top
-        if (curY < regionY2) {
-          float tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY][curX].usage_red()
-                           + L * v_edges_[curY][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY > regionY1 + 1) {
-              const int pos2 = v_edges_[curY - 1][curX].usage_red()
-                               + L * v_edges_[curY - 1][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY - 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+      }
+      // top
+      if (curY < regionY2) {
+        float tmp, cost1, cost2;
+        const int pos1 = v_edges_[curY][curX].usage_red()
+                         + L * v_edges_[curY][curX].last_usage;
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY > regionY1 + 1) {
+            const int pos2 = v_edges_[curY - 1][curX].usage_red()
+                             + L * v_edges_[curY - 1][curX].last_usage;
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+
+            scratch.touch(d1, curY - 1, curX);
+            const int tmp_cost = d1[curY - 1][curX] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v_[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY + 1;  // the top neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // top neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpY = curY + 1;  // the top neighbor
+        scratch.touch(d1, tmpY, curX);
+        if (d1[tmpY][curX]
+            >= BIG_INT)  // top neighbor not been put into src_heap
+        {
+          d1[tmpY][curX] = tmp;
+          hyper_h_[tmpY][curX] = false;
+          hyper_v_[tmpY][curX] = false;
+          parent_x1_[tmpY][curX] = curX;
+          parent_y1_[tmpY][curX] = curY;
+          hv_[tmpY][curX] = true;
+          scratch.src_heap.push_back(&d1[tmpY][curX]);
+          updateHeap(scratch.src_heap, scratch.src_heap.size() - 1);
+        } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1_[tmpY][curX] = curX;
+          parent_y1_[tmpY][curX] = curY;
+          hv_[tmpY][curX] = true;
+          float* dtmp = &d1[tmpY][curX];
+          int ind = 0;
+          while (scratch.src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(scratch.src_heap, ind);
         }
+      }
 
-        // update ind1 for next loop
-        ind1 = (src_heap[0] - &d1[0][0]);
+      // update ind1 for next loop
+      ind1 = (scratch.src_heap[0] - &d1[0][0]);
 
-      }  // while loop
+    }  // while loop
 
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = false;
+    for (int i = 0; i < scratch.dest_heap.size(); i++)
+      scratch.pop_heap2[(scratch.dest_heap[i] - &d2[0][0])] = false;
 
-      const int crossX = ind1 % x_range_;
-      const int crossY = ind1 / x_range_;
+    const int crossX = ind1 % x_range_;
+    const int crossY = ind1 / x_range_;
 
-      int cnt = 0;
-      int curX = crossX;
-      int curY = crossY;
-      std::vector<int> tmp_gridsX, tmp_gridsY;
-      while (d1[curY][curX] != 0)  // loop until reach subtree1
-      {
-        bool hypered = false;
-        if (cnt != 0) {
-          if (curX != tmpX && hyper_h_[curY][curX]) {
-            curX = 2 * curX - tmpX;
-            hypered = true;
-          }
+    int cnt = 0;
+    int curX = crossX;
+    int curY = crossY;
+    std::vector<int> tmp_gridsX, tmp_gridsY;
+    while (d1[curY][curX] != 0)  // loop until reach subtree1
+    {
+      bool hypered = false;
+      if (cnt != 0) {
+        if (curX != tmpX && hyper_h_[curY][curX]) {
+          curX = 2 * curX - tmpX;
+          hypered = true;
+        }
 
-          if (curY != tmpY && hyper_v_[curY][curX]) {
-            curY = 2 * curY - tmpY;
-            hypered = true;
-          }
+        if (curY != tmpY && hyper_v_[curY][curX]) {
+          curY = 2 * curY - tmpY;
+          hypered = true;
         }
-        tmpX = curX;
-        tmpY = curY;
-        if (!hypered) {
-          if (hv_[tmpY][tmpX]) {
-            curY = parent_y1_[tmpY][tmpX];
-          } else {
-            curX = parent_x3_[tmpY][tmpX];
-          }
+      }
+      tmpX = curX;
+      tmpY = curY;
+      if (!hypered) {
+        if (hv_[tmpY][tmpX]) {
+          curY = parent_y1_[tmpY][tmpX];
+        } else {
+          curX = parent_x3_[tmpY][tmpX];
         }
-        tmp_gridsX.push_back(curX);
-        tmp_gridsY.push_back(curY);
-        cnt++;
       }
-      // reverse the grids on the path
-      std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
-      std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
-
-      // add the connection point (crossX, crossY)
-      gridsX.push_back(crossX);
-      gridsY.push_back(crossY);
+      tmp_gridsX.push_back(curX);
+      tmp_gridsY.push_back(curY);
       cnt++;
+    }
+    // reverse the grids on the path
+    std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
+    std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
+
+    // add the connection point (crossX, crossY)
+    gridsX.push_back(crossX);
+    gridsY.push_back(crossY);
+    cnt++;
 
-      curX = crossX;
-      curY = crossY;
-      const int cnt_n1n2 = cnt;
-
-      // change the tree structure according to the new routing for the tree
-      // edge find E1 and E2, and the endpoints of the edges they are on
-      const int E1x = gridsX[0];
-      const int E1y = gridsY[0];
-      const int E2x = gridsX.back();
-      const int E2y = gridsY.back();
-
-      const int edge_n1n2 = edgeID;
-      // (1) consider subtree1
-      if (n1 < num_terminals && (E1x != n1x || E1y != n1y)) {
-        // split neighbor edge and return id new node
-        n1 = splitEdge(treeedges, treenodes, n2, n1, edgeID);
+    curX = crossX;
+    curY = crossY;
+    const int cnt_n1n2 = cnt;
+
+    // change the tree structure according to the new routing for the tree
+    // edge find E1 and E2, and the endpoints of the edges they are on
+    const int E1x = gridsX[0];
+    const int E1y = gridsY[0];
+    const int E2x = gridsX.back();
+    const int E2y = gridsY.back();
+
+    const int edge_n1n2 = edgeID;
+    // (1) consider subtree1
+    if (n1 < num_terminals && (E1x != n1x || E1y != n1y)) {
+      // split neighbor edge and return id new node
+      n1 = splitEdge(treeedges, treenodes, n2, n1, edgeID);
+    }
+    if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
+    // n1 is not a pin and E1!=n1, then make change to subtree1,
+    // otherwise, no change to subtree1
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge_[E1y][E1x]].n1;
+      const int endpt2 = treeedges[corr_edge_[E1y][E1x]].n2;
+
+      // find A1, A2 and edge_n1A1, edge_n1A2
+      int A1, A2;
+      int edge_n1A1, edge_n1A2;
+      if (treenodes[n1].nbr[0] == n2) {
+        A1 = treenodes[n1].nbr[1];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[1];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else if (treenodes[n1].nbr[1] == n2) {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[1];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[1];
       }
-      if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
-      // n1 is not a pin and E1!=n1, then make change to subtree1,
-      // otherwise, no change to subtree1
+
+      if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E1y][E1x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E1y][E1x]].n2;
-
-        // find A1, A2 and edge_n1A1, edge_n1A2
-        int A1, A2;
-        int edge_n1A1, edge_n1A2;
-        if (treenodes[n1].nbr[0] == n2) {
-          A1 = treenodes[n1].nbr[1];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[1];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else if (treenodes[n1].nbr[1] == n2) {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[1];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[1];
+        // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
+        // (n1, A1)
+        if (endpt1 == A2 || endpt2 == A2) {
+          std::swap(A1, A2);
+          std::swap(edge_n1A1, edge_n1A2);
         }
 
-        if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
-        {
-          // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
-          // (n1, A1)
-          if (endpt1 == A2 || endpt2 == A2) {
-            std::swap(A1, A2);
-            std::swap(edge_n1A1, edge_n1A2);
-          }
-
-          // update route for edge (n1, A1), (n1, A2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes,
-                                           n1,
-                                           A1,
-                                           A2,
-                                           E1x,
-                                           E1y,
-                                           treeedges,
-                                           edge_n1A1,
-                                           edge_n1A2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->error(GRT,
-                             150,
-                             "Net {} has errors during updateRouteType1.",
-                             nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update route for edge (n1, A1), (n1, A2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes,
+                                         n1,
+                                         A1,
+                                         A2,
+                                         E1x,
+                                         E1y,
+                                         treeedges,
+                                         edge_n1A1,
+                                         edge_n1A2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->error(GRT,
+                           150,
+                           "Net {} has errors during updateRouteType1.",
+                           nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+      }     // if E1 is on (n1, A1) or (n1, A2)
+      else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+      {
+        const int C1 = endpt1;
+        const int C2 = endpt2;
+        const int edge_C1C2 = corr_edge_[E1y][E1x];
+
+        // update route for edge (n1, C1), (n1, C2) and (A1, A2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes,
+                                         n1,
+                                         A1,
+                                         A2,
+                                         C1,
+                                         C2,
+                                         E1x,
+                                         E1y,
+                                         treeedges,
+                                         edge_n1A1,
+                                         edge_n1A2,
+                                         edge_C1C2);
+        if (!route_ok) {
+          debugPrint(logger_,
+                     utl::GRT,
+                     "maze_2d",
+                     1,
+                     "Net {} has errors during updateRouteType2.",
+                     nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+        // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
+        // C2)->(A1, A2)
+        const int edge_n1C1 = edge_n1A1;
+        treeedges[edge_n1C1].n1 = C1;
+        treeedges[edge_n1C1].n2 = n1;
+        const int edge_n1C2 = edge_n1A2;
+        treeedges[edge_n1C2].n1 = n1;
+        treeedges[edge_n1C2].n2 = C2;
+        const int edge_A1A2 = edge_C1C2;
+        treeedges[edge_A1A2].n1 = A1;
+        treeedges[edge_A1A2].n2 = A2;
+        // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
+        // n1's nbr (n2, A1, A2)->(n2, C1, C2)
+        treenodes[n1].nbr[0] = n2;
+        treenodes[n1].edge[0] = edge_n1n2;
+        treenodes[n1].nbr[1] = C1;
+        treenodes[n1].edge[1] = edge_n1C1;
+        treenodes[n1].nbr[2] = C2;
+        treenodes[n1].edge[2] = edge_n1C2;
+        // A1's nbr n1->A2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A1].nbr[i] == n1) {
+            treenodes[A1].nbr[i] = A2;
+            treenodes[A1].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-        }     // if E1 is on (n1, A1) or (n1, A2)
-        else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-        {
-          const int C1 = endpt1;
-          const int C2 = endpt2;
-          const int edge_C1C2 = corr_edge_[E1y][E1x];
-
-          // update route for edge (n1, C1), (n1, C2) and (A1, A2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes,
-                                           n1,
-                                           A1,
-                                           A2,
-                                           C1,
-                                           C2,
-                                           E1x,
-                                           E1y,
-                                           treeedges,
-                                           edge_n1A1,
-                                           edge_n1A2,
-                                           edge_C1C2);
-          if (!route_ok) {
-            debugPrint(logger_,
-                       utl::GRT,
-                       "maze_2d",
-                       1,
-                       "Net {} has errors during updateRouteType2.",
-                       nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // A2's nbr n1->A1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A2].nbr[i] == n1) {
+            treenodes[A2].nbr[i] = A1;
+            treenodes[A2].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-          // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
-          // C2)->(A1, A2)
-          const int edge_n1C1 = edge_n1A1;
-          treeedges[edge_n1C1].n1 = C1;
-          treeedges[edge_n1C1].n2 = n1;
-          const int edge_n1C2 = edge_n1A2;
-          treeedges[edge_n1C2].n1 = n1;
-          treeedges[edge_n1C2].n2 = C2;
-          const int edge_A1A2 = edge_C1C2;
-          treeedges[edge_A1A2].n1 = A1;
-          treeedges[edge_A1A2].n2 = A2;
-          // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
-          // n1's nbr (n2, A1, A2)->(n2, C1, C2)
-          treenodes[n1].nbr[0] = n2;
-          treenodes[n1].edge[0] = edge_n1n2;
-          treenodes[n1].nbr[1] = C1;
-          treenodes[n1].edge[1] = edge_n1C1;
-          treenodes[n1].nbr[2] = C2;
-          treenodes[n1].edge[2] = edge_n1C2;
-          // A1's nbr n1->A2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A1].nbr[i] == n1) {
-              treenodes[A1].nbr[i] = A2;
-              treenodes[A1].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // A2's nbr n1->A1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A2].nbr[i] == n1) {
-              treenodes[A2].nbr[i] = A1;
-              treenodes[A2].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // C1's nbr C2->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C1].nbr[i] == C2) {
-              treenodes[C1].nbr[i] = n1;
-              treenodes[C1].edge[i] = edge_n1C1;
-              break;
-            }
+        }
+        // C1's nbr C2->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C1].nbr[i] == C2) {
+            treenodes[C1].nbr[i] = n1;
+            treenodes[C1].edge[i] = edge_n1C1;
+            break;
           }
-          // C2's nbr C1->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C2].nbr[i] == C1) {
-              treenodes[C2].nbr[i] = n1;
-              treenodes[C2].edge[i] = edge_n1C2;
-              break;
-            }
+        }
+        // C2's nbr C1->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C2].nbr[i] == C1) {
+            treenodes[C2].nbr[i] = n1;
+            treenodes[C2].edge[i] = edge_n1C2;
+            break;
           }
+        }
 
-        }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-      }    // n1 is not a pin and E1!=n1
+      }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+    }    // n1 is not a pin and E1!=n1
 
-      // (2) consider subtree2
-      if (n2 < num_terminals && (E2x != n2x || E2y != n2y)) {
-        // split neighbor edge and return id new node
-        n2 = splitEdge(treeedges, treenodes, n1, n2, edgeID);
+    // (2) consider subtree2
+    if (n2 < num_terminals && (E2x != n2x || E2y != n2y)) {
+      // split neighbor edge and return id new node
+      n2 = splitEdge(treeedges, treenodes, n1, n2, edgeID);
+    }
+    if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
+    // n2 is not a pin and E2!=n2, then make change to subtree2,
+    // otherwise, no change to subtree2
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge_[E2y][E2x]].n1;
+      const int endpt2 = treeedges[corr_edge_[E2y][E2x]].n2;
+
+      // find B1, B2
+      int B1, B2;
+      int edge_n2B1, edge_n2B2;
+      if (treenodes[n2].nbr[0] == n1) {
+        B1 = treenodes[n2].nbr[1];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[1];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else if (treenodes[n2].nbr[1] == n1) {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[1];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[1];
       }
-      if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
-      // n2 is not a pin and E2!=n2, then make change to subtree2,
-      // otherwise, no change to subtree2
+
+      if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E2y][E2x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E2y][E2x]].n2;
-
-        // find B1, B2
-        int B1, B2;
-        int edge_n2B1, edge_n2B2;
-        if (treenodes[n2].nbr[0] == n1) {
-          B1 = treenodes[n2].nbr[1];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[1];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else if (treenodes[n2].nbr[1] == n1) {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[1];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[1];
+        // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
+        // (n2, B1)
+        if (endpt1 == B2 || endpt2 == B2) {
+          std::swap(B1, B2);
+          std::swap(edge_n2B1, edge_n2B2);
         }
 
-        if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
-        {
-          // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
-          // (n2, B1)
-          if (endpt1 == B2 || endpt2 == B2) {
-            std::swap(B1, B2);
-            std::swap(edge_n2B1, edge_n2B2);
-          }
+        // update route for edge (n2, B1), (n2, B2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes,
+                                         n2,
+                                         B1,
+                                         B2,
+                                         E2x,
+                                         E2y,
+                                         treeedges,
+                                         edge_n2B1,
+                                         edge_n2B2);
+        if (!route_ok) {
+          debugPrint(logger_,
+                     utl::GRT,
+                     "maze_2d",
+                     1,
+                     "Net {} has errors during updateRouteType1.",
+                     nets_[netID]->getName());
+          return false;
+        }
 
-          // update route for edge (n2, B1), (n2, B2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes,
-                                           n2,
-                                           B1,
-                                           B2,
-                                           E2x,
-                                           E2y,
-                                           treeedges,
-                                           edge_n2B1,
-                                           edge_n2B2);
-          if (!route_ok) {
-            debugPrint(logger_,
-                       utl::GRT,
-                       "maze_2d",
-                       1,
-                       "Net {} has errors during updateRouteType1.",
-                       nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+      }     // if E2 is on (n2, B1) or (n2, B2)
+      else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+      {
+        const int D1 = endpt1;
+        const int D2 = endpt2;
+        const int edge_D1D2 = corr_edge_[E2y][E2x];
+
+        // update route for edge (n2, D1), (n2, D2) and (B1, B2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes,
+                                         n2,
+                                         B1,
+                                         B2,
+                                         D1,
+                                         D2,
+                                         E2x,
+                                         E2y,
+                                         treeedges,
+                                         edge_n2B1,
+                                         edge_n2B2,
+                                         edge_D1D2);
+        if (!route_ok) {
+          debugPrint(logger_,
+                     utl::GRT,
+                     "maze_2d",
+                     1,
+                     "Net {} has errors during updateRouteType2.",
+                     nets_[netID]->getName());
+          return false;
+        }
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+        // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
+        // D2)->(B1, B2)
+        const int edge_n2D1 = edge_n2B1;
+        treeedges[edge_n2D1].n1 = D1;
+        treeedges[edge_n2D1].n2 = n2;
+        const int edge_n2D2 = edge_n2B2;
+        treeedges[edge_n2D2].n1 = n2;
+        treeedges[edge_n2D2].n2 = D2;
+        const int edge_B1B2 = edge_D1D2;
+        treeedges[edge_B1B2].n1 = B1;
+        treeedges[edge_B1B2].n2 = B2;
+        // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
+        // n1's nbr (n1, B1, B2)->(n1, D1, D2)
+        treenodes[n2].nbr[0] = n1;
+        treenodes[n2].edge[0] = edge_n1n2;
+        treenodes[n2].nbr[1] = D1;
+        treenodes[n2].edge[1] = edge_n2D1;
+        treenodes[n2].nbr[2] = D2;
+        treenodes[n2].edge[2] = edge_n2D2;
+        // B1's nbr n2->B2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B1].nbr[i] == n2) {
+            treenodes[B1].nbr[i] = B2;
+            treenodes[B1].edge[i] = edge_B1B2;
             break;
           }
-
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-        }     // if E2 is on (n2, B1) or (n2, B2)
-        else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-        {
-          const int D1 = endpt1;
-          const int D2 = endpt2;
-          const int edge_D1D2 = corr_edge_[E2y][E2x];
-
-          // update route for edge (n2, D1), (n2, D2) and (B1, B2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes,
-                                           n2,
-                                           B1,
-                                           B2,
-                                           D1,
-                                           D2,
-                                           E2x,
-                                           E2y,
-                                           treeedges,
-                                           edge_n2B1,
-                                           edge_n2B2,
-                                           edge_D1D2);
-          if (!route_ok) {
-            debugPrint(logger_,
-                       utl::GRT,
-                       "maze_2d",
-                       1,
-                       "Net {} has errors during updateRouteType2.",
-                       nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // B2's nbr n2->B1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B2].nbr[i] == n2) {
+            treenodes[B2].nbr[i] = B1;
+            treenodes[B2].edge[i] = edge_B1B2;
             break;
           }
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-          // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
-          // D2)->(B1, B2)
-          const int edge_n2D1 = edge_n2B1;
-          treeedges[edge_n2D1].n1 = D1;
-          treeedges[edge_n2D1].n2 = n2;
-          const int edge_n2D2 = edge_n2B2;
-          treeedges[edge_n2D2].n1 = n2;
-          treeedges[edge_n2D2].n2 = D2;
-          const int edge_B1B2 = edge_D1D2;
-          treeedges[edge_B1B2].n1 = B1;
-          treeedges[edge_B1B2].n2 = B2;
-          // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
-          // n1's nbr (n1, B1, B2)->(n1, D1, D2)
-          treenodes[n2].nbr[0] = n1;
-          treenodes[n2].edge[0] = edge_n1n2;
-          treenodes[n2].nbr[1] = D1;
-          treenodes[n2].edge[1] = edge_n2D1;
-          treenodes[n2].nbr[2] = D2;
-          treenodes[n2].edge[2] = edge_n2D2;
-          // B1's nbr n2->B2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B1].nbr[i] == n2) {
-              treenodes[B1].nbr[i] = B2;
-              treenodes[B1].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // B2's nbr n2->B1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B2].nbr[i] == n2) {
-              treenodes[B2].nbr[i] = B1;
-              treenodes[B2].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // D1's nbr D2->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D1].nbr[i] == D2) {
-              treenodes[D1].nbr[i] = n2;
-              treenodes[D1].edge[i] = edge_n2D1;
-              break;
-            }
+        }
+        // D1's nbr D2->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D1].nbr[i] == D2) {
+            treenodes[D1].nbr[i] = n2;
+            treenodes[D1].edge[i] = edge_n2D1;
+            break;
           }
-          // D2's nbr D1->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D2].nbr[i] == D1) {
-              treenodes[D2].nbr[i] = n2;
-              treenodes[D2].edge[i] = edge_n2D2;
-              break;
-            }
+        }
+        // D2's nbr D1->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D2].nbr[i] == D1) {
+            treenodes[D2].nbr[i] = n2;
+            treenodes[D2].edge[i] = edge_n2D2;
+            break;
           }
-        }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-      }    // n2 is not a pin and E2!=n2
+        }
+      }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+    }    // n2 is not a pin and E2!=n2
 
-      // update route for edge (n1, n2) and edge usage
-      if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
-        treeedges[edge_n1n2].route.gridsX.clear();
-        treeedges[edge_n1n2].route.gridsY.clear();
+    // update route for edge (n1, n2) and edge usage
+    if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
+      treeedges[edge_n1n2].route.gridsX.clear();
+      treeedges[edge_n1n2].route.gridsY.clear();
+    }
+    treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
+    treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
+    treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
+
+    for (int i = 0; i < cnt_n1n2; i++) {
+      treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
+      treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
+    }
+
+    int edgeCost = nets_[netID]->getEdgeCost();
+
+    // update edge usage
+    for (int i = 0; i < cnt_n1n2 - 1; i++) {
+      if (gridsX[i] == gridsX[i + 1])  // a vertical edge
+      {
+        const int min_y = std::min(gridsY[i], gridsY[i + 1]);
+        v_edges_[min_y][gridsX[i]].usage += edgeCost;
+        scratch.v_used_ggrid.insert(std::make_pair(min_y, gridsX[i]));
+      } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
+      {
+        const int min_x = std::min(gridsX[i], gridsX[i + 1]);
+        h_edges_[gridsY[i]][min_x].usage += edgeCost;
+        scratch.h_used_ggrid.insert(std::make_pair(gridsY[i], min_x));
       }
-      treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
-      treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
-      treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
-
-      for (int i = 0; i < cnt_n1n2; i++) {
-        treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
-        treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
+    }
+  }  // loop edgeID
+  return true;
+}
+
+// Grid area that routing netID with the given expansion may read or write:
+// the bounding box of its tree nodes and current routes enlarged by expand.
+odb::Rect FastRouteCore::mazeRouteFootprint(const int netID,
+                                            const int expand) const
+{
+  int x_min = std::numeric_limits<int>::max();
+  int y_min = std::numeric_limits<int>::max();
+  int x_max = std::numeric_limits<int>::min();
+  int y_max = std::numeric_limits<int>::min();
+  const auto addGrid = [&](const int x, const int y) {
+    x_min = std::min(x_min, x);
+    y_min = std::min(y_min, y);
+    x_max = std::max(x_max, x);
+    y_max = std::max(y_max, y);
+  };
+
+  for (const TreeNode& node : sttrees_[netID].nodes) {
+    addGrid(node.x, node.y);
+  }
+  for (const TreeEdge& edge : sttrees_[netID].edges) {
+    const Route& route = edge.route;
+    if (route.type != RouteType::MazeRoute) {
+      continue;
+    }
+    for (int i = 0; i <= route.routelen && i < route.gridsX.size(); i++) {
+      addGrid(route.gridsX[i], route.gridsY[i]);
+    }
+  }
+
+  if (x_min > x_max) {
+    return odb::Rect(0, 0, 0, 0);
+  }
+  return odb::Rect(std::max(x_min - expand, 0),
+                   std::max(y_min - expand, 0),
+                   std::min(x_max + expand, x_grid_ - 1),
+                   std::min(y_max + expand, y_grid_ - 1));
+}
+
+// Splits the routing order into batches of nets whose footprints do not
+// intersect, so the nets of a batch can be routed concurrently. Nets are
+// scanned in order and a net that is deferred keeps its footprint claimed
+// for the rest of the scan, so a net is never routed before an earlier net
+// that it overlaps. The batches only depend on the routing order. The
+// footprint of each net is returned in footprints, indexed by net id; the
+// router must keep each net's routing regions inside it.
+std::vector<std::vector<int>> FastRouteCore::mazeRouteBatches(
+    const std::vector<int>& net_order,
+    const int expand,
+    std::vector<odb::Rect>& footprints) const
+{
+  const int max_batch_size = 256;
+  const int max_deferred = 8 * max_batch_size;
+
+  footprints.assign(netCount(), odb::Rect(0, 0, 0, 0));
+  for (const int netID : net_order) {
+    footprints[netID] = mazeRouteFootprint(netID, expand);
+  }
+
+  std::vector<std::vector<int>> batches;
+  std::deque<int> pending(net_order.begin(), net_order.end());
+  std::vector<int> deferred;
+  bgi::rtree<BgBox, bgi::quadratic<16>> claimed;
+  while (!pending.empty()) {
+    std::vector<int> batch;
+    deferred.clear();
+    claimed.clear();
+    while (!pending.empty() && batch.size() < max_batch_size
+           && deferred.size() < max_deferred) {
+      const int netID = pending.front();
+      pending.pop_front();
+      const odb::Rect& rect = footprints[netID];
+      const BgBox box(BgPoint(rect.xMin(), rect.yMin()),
+                      BgPoint(rect.xMax(), rect.yMax()));
+      if (claimed.qbegin(bgi::intersects(box)) == claimed.qend()) {
+        batch.push_back(netID);
+      } else {
+        deferred.push_back(netID);
       }
+      claimed.insert(box);
+    }
+    pending.insert(pending.begin(), deferred.begin(), deferred.end());
+    batches.push_back(std::move(batch));
+  }
 
-      int edgeCost = nets_[netID]->getEdgeCost();
+  return batches;
+}
 
-      // update edge usage
-      for (int i = 0; i < cnt_n1n2 - 1; i++) {
-        if (gridsX[i] == gridsX[i + 1])  // a vertical edge
-        {
-          const int min_y = std::min(gridsY[i], gridsY[i + 1]);
-          v_edges_[min_y][gridsX[i]].usage += edgeCost;
-          v_used_ggrid_.insert(std::make_pair(min_y, gridsX[i]));
-        } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
-        {
-          const int min_x = std::min(gridsX[i], gridsX[i + 1]);
-          h_edges_[gridsY[i]][min_x].usage += edgeCost;
-          h_used_ggrid_.insert(std::make_pair(gridsY[i], min_x));
+// Sizes the 2D maze buffers for the current grid. They are only reallocated
+// when the grid or the number of threads changes. The heaps grow with the
+// routing regions of the edges each thread routes.
+void FastRouteCore::initMazeScratches(const int num_scratches)
+{
+  if (maze_d1_.shape()[0] != y_range_ || maze_d1_.shape()[1] != x_range_) {
+    maze_d1_.resize(boost::extents[y_range_][x_range_]);
+    maze_d2_.resize(boost::extents[y_range_][x_range_]);
+  }
+
+  maze_scratches_.resize(num_scratches);
+  const int grid_count = y_range_ * x_range_;
+  for (MazeScratch& scratch : maze_scratches_) {
+    if (scratch.d1_generation.size() != grid_count) {
+      scratch.pop_heap2.assign(grid_count, false);
+      scratch.d1_generation.assign(grid_count, 0);
+      scratch.generation = 0;
+    }
+  }
+}
+
+void FastRouteCore::mazeRouteMSMD(const int iter,
+                                  const int expand,
+                                  const float cost_height,
+                                  const int ripup_threshold,
+                                  const int maze_edge_threshold,
+                                  const bool ordering,
+                                  const int cost_type,
+                                  const float logis_cof,
+                                  const int via,
+                                  const int slope,
+                                  const int L,
+                                  float& slack_th)
+{
+  // maze routing for multi-source, multi-destination
+  const int max_usage_multiplier = 40;
+
+  // allocate memory for distance and parent and pop_heap
+  h_cost_table_.resize(max_usage_multiplier * h_capacity_);
+  v_cost_table_.resize(max_usage_multiplier * v_capacity_);
+
+  for (int i = 0; i < max_usage_multiplier * h_capacity_; i++) {
+    h_cost_table_[i]
+        = getCost(i, logis_cof, cost_height, slope, h_capacity_, cost_type);
+  }
+  for (int i = 0; i < max_usage_multiplier * v_capacity_; i++) {
+    v_cost_table_[i]
+        = getCost(i, logis_cof, cost_height, slope, v_capacity_, cost_type);
+  }
+
+  if (ordering) {
+    if (critical_nets_percentage_) {
+      slack_th = CalculatePartialSlack();
+    }
+    StNetOrder();
+  }
+
+  std::vector<int> net_order(net_ids_.size());
+  for (int nidRPC = 0; nidRPC < net_ids_.size(); nidRPC++) {
+    net_order[nidRPC]
+        = ordering ? tree_order_cong_[nidRPC].treeIndex : net_ids_[nidRPC];
+  }
+
+  const int num_scratches = parallel_maze_ ? std::max(num_threads_, 1) : 1;
+  initMazeScratches(num_scratches);
+  std::vector<MazeScratch>& scratches = maze_scratches_;
+
+  const auto routeNet = [&](const int netID,
+                            MazeScratch& scratch,
+                            const odb::Rect* footprint) {
+    return mazeRouteMSMDNet(netID,
+                            iter,
+                            expand,
+                            cost_height,
+                            ripup_threshold,
+                            maze_edge_threshold,
+                            cost_type,
+                            logis_cof,
+                            via,
+                            slope,
+                            L,
+                            slack_th,
+                            maze_d1_,
+                            maze_d2_,
+                            scratch,
+                            footprint);
+  };
+
+  // Routes netID until it succeeds, rebuilding its tree after a failure.
+  const auto routeNetSerial = [&](const int netID) {
+    MazeScratch& scratch = scratches[0];
+    while (true) {
+      scratch.enlarge = -1;
+      const bool routed = routeNet(netID, scratch, nullptr);
+      if (scratch.enlarge >= 0) {
+        enlarge_ = scratch.enlarge;
+      }
+      if (routed) {
+        break;
+      }
+      reInitTree(netID);
+    }
+  };
+
+  if (!parallel_maze_) {
+    for (const int netID : net_order) {
+      routeNetSerial(netID);
+    }
+  } else {
+    // Nets of a batch only touch their own footprints, so they see the same
+    // congestion whatever the number of threads. Tree rebuilds use flute,
+    // which is not reentrant, and are done serially after each batch.
+    std::vector<odb::Rect> footprints;
+    for (const std::vector<int>& batch :
+         mazeRouteBatches(net_order, expand, footprints)) {
+      const int batch_size = batch.size();
+      std::vector<int> enlarges(batch_size, -1);
+      std::vector<char> routed(batch_size, false);
+      utl::ThreadException exception;
+#pragma omp parallel for num_threads(num_scratches) schedule(dynamic)
+      for (int i = 0; i < batch_size; i++) {
+        try {
+          MazeScratch& scratch = scratches[omp_get_thread_num()];
+          scratch.enlarge = -1;
+          routed[i] = routeNet(batch[i], scratch, &footprints[batch[i]]);
+          enlarges[i] = scratch.enlarge;
+        } catch (...) {
+          exception.capture();
+        }
+      }
+      exception.rethrow();
+
+      for (int i = 0; i < batch_size; i++) {
+        if (enlarges[i] >= 0) {
+          enlarge_ = enlarges[i];
+        }
+      }
+      for (int i = 0; i < batch_size; i++) {
+        if (!routed[i]) {
+          reInitTree(batch[i]);
+          routeNetSerial(batch[i]);
         }
       }
-    }  // loop edgeID
-  }    // loop netID
+    }
+  }
+
+  for (MazeScratch& scratch : scratches) {
+    h_used_ggrid_.insert(scratch.h_used_ggrid.begin(),
+                         scratch.h_used_ggrid.end());
+    v_used_ggrid_.insert(scratch.v_used_ggrid.begin(),
+                         scratch.v_used_ggrid.end());
+    scratch.h_used_ggrid.clear();
+    scratch.v_used_ggrid.clear();
+  }
 
   h_cost_table_.clear();
   v_cost_table_.clear();
@@ -2485,16 +2716,12 @@ int FastRouteCore::getOverflow3D()
 
 void FastRouteCore::InitEstUsage()
 {
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_ - 1; j++) {
-      h_edges_[i][j].est_usage = 0;
-    }
+  for (const auto& [i, j] : h_used_ggrid_) {
+    h_edges_[i][j].est_usage = 0;
   }
 
-  for (int i = 0; i < y_grid_ - 1; i++) {
-    for (int j = 0; j < x_grid_; j++) {
-      v_edges_[i][j].est_usage = 0;
-    }
+  for (const auto& [i, j] : v_used_ggrid_) {
+    v_edges_[i][j].est_usage = 0;
   }
 }
 
@@ -2521,42 +2748,27 @@ void FastRouteCore::str_accu(const int rnd)
 
 void FastRouteCore::InitLastUsage(const int upType)
 {
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_ - 1; j++) {
-      h_edges_[i][j].last_usage = 0;
-    }
-  }
-
-  for (int i = 0; i < y_grid_ - 1; i++) {
-    for (int j = 0; j < x_grid_; j++) {
-      v_edges_[i][j].last_usage = 0;
-    }
-  }
-
-  if (upType == 1) {
-    for (int i = 0; i < y_grid_; i++) {
-      for (int j = 0; j < x_grid_ - 1; j++) {
-        h_edges_[i][j].congCNT = 0;
-      }
-    }
-
-    for (int i = 0; i < y_grid_ - 1; i++) {
-      for (int j = 0; j < x_grid_; j++) {
-        v_edges_[i][j].congCNT = 0;
-      }
-    }
-  } else if (upType == 2) {
-    for (int i = 0; i < y_grid_; i++) {
-      for (int j = 0; j < x_grid_ - 1; j++) {
-        h_edges_[i][j].last_usage = h_edges_[i][j].last_usage * 0.2;
+  // last_usage and congCNT only change on edges in the used sets (str_accu
+  // needs a non-zero congCNT), so the history and used sets cover every
+  // edge that can hold a non-zero value.
+  auto reset = [&](multi_array<Edge, 2>& edges,
+                   const std::set<std::pair<int, int>>& ggrid) {
+    for (const auto& [i, j] : ggrid) {
+      edges[i][j].last_usage = 0;
+      if (upType == 1) {
+        edges[i][j].congCNT = 0;
       }
     }
+  };
+  reset(h_edges_, h_history_ggrid_);
+  reset(h_edges_, h_used_ggrid_);
+  reset(v_edges_, v_history_ggrid_);
+  reset(v_edges_, v_used_ggrid_);
 
-    for (int i = 0; i < y_grid_ - 1; i++) {
-      for (int j = 0; j < x_grid_; j++) {
-        v_edges_[i][j].last_usage = v_edges_[i][j].last_usage * 0.2;
-      }
-    }
+  // With upType 2 congCNT is kept, so the history must be kept too.
+  if (upType == 1) {
+    h_history_ggrid_.clear();
+    v_history_ggrid_.clear();
   }
 }
 
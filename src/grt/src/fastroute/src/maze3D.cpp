@@ -30,23 +30,20 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
 
 #include "DataType.h"
 #include "FastRoute.h"
 #include "odb/db.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
 using utl::GRT;
 
-struct parent3D
-{
-  short l;
-  int x, y;
-};
-
 static int parent_index(int i)
 {
   return (i - 1) / 2;
@@ -119,8 +116,16 @@ void FastRouteCore::addNeighborPoints(const int netID,
                                       std::vector<int*>& points_heap_3D,
                                       multi_array<int, 3>& dist_3D,
                                       multi_array<Direction, 3>& directions_3D,
-                                      multi_array<int, 3>& corr_edge_3D)
+                                      multi_array<int, 3>& corr_edge_3D,
+                                      const int regionX1,
+                                      const int regionX2,
+                                      const int regionY1,
+                                      const int regionY2)
 {
+  const auto inRegion = [=](const int x, const int y) {
+    return x >= regionX1 && x <= regionX2 && y >= regionY1 && y <= regionY2;
+  };
+
   const auto& treeedges = sttrees_[netID].edges;
   const auto& treenodes = sttrees_[netID].nodes;
 
@@ -169,7 +174,7 @@ void FastRouteCore::addNeighborPoints(const int netID,
       if (treeedges[edge].route.routelen > 0) {
         // not a degraded edge
         // put nbr into points_heap_3D if in enlarged region
-        if (in_region_[treenodes[nbr].y][treenodes[nbr].x]) {
+        if (inRegion(treenodes[nbr].x, treenodes[nbr].y)) {
           const int nbrX = treenodes[nbr].x;
           const int nbrY = treenodes[nbr].y;
           nt = treenodes[nbr].stackAlias;
@@ -191,7 +196,7 @@ void FastRouteCore::addNeighborPoints(const int netID,
             const int y_grid = route->gridsY[j];
             const int l_grid = route->gridsL[j];
 
-            if (in_region_[y_grid][x_grid]) {
+            if (inRegion(x_grid, y_grid)) {
               dist_3D[l_grid][y_grid][x_grid] = 0;
               points_heap_3D.push_back(&dist_3D[l_grid][y_grid][x_grid]);
               directions_3D[l_grid][y_grid][x_grid] = Direction::Origin;
@@ -251,26 +256,33 @@ void FastRouteCore::setupHeap3D(int netID,
     directions_3D[node2_access_layer][y2][x2] = Direction::Origin;
     dest_heap_3D.push_back(&d2_3D[node2_access_layer][y2][x2]);
   } else {  // net with more than 2 pins
-    for (int i = regionY1; i <= regionY2; i++) {
-      for (int j = regionX1; j <= regionX2; j++) {
-        in_region_[i][j] = true;
-      }
-    }
     // find all the grids on tree edges in subtree t1 (connecting to n1) and put
     // them into src_heap_3D
-    addNeighborPoints(
-        netID, n1, n2, src_heap_3D, d1_3D, directions_3D, corr_edge_3D);
+    addNeighborPoints(netID,
+                      n1,
+                      n2,
+                      src_heap_3D,
+                      d1_3D,
+                      directions_3D,
+                      corr_edge_3D,
+                      regionX1,
+                      regionX2,
+                      regionY1,
+                      regionY2);
 
     // find all the grids on tree edges in subtree t2 (connecting
     // to n2) and put them into dest_heap_3D
-    addNeighborPoints(
-        netID, n2, n1, dest_heap_3D, d2_3D, directions_3D, corr_edge_3D);
-
-    for (int i = regionY1; i <= regionY2; i++) {
-      for (int j = regionX1; j <= regionX2; j++) {
-        in_region_[i][j] = false;
-      }
-    }
+    addNeighborPoints(netID,
+                      n2,
+                      n1,
+                      dest_heap_3D,
+                      d2_3D,
+                      directions_3D,
+                      corr_edge_3D,
+                      regionX1,
+                      regionX2,
+                      regionY1,
+                      regionY2);
   }  // net with more than two pins
 }
 
@@ -782,786 +794,872 @@ void FastRouteCore::updateRouteType23D(int netID,
   }
 }
 
-void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
-                                         int ripupTHlb,
-                                         int ripupTHub)
+void FastRouteCore::mazeRouteMSMDOrder3DNet(
+    const int netID,
+    const int expand,
+    const int ripupTHlb,
+    const int ripupTHub,
+    multi_array<Direction, 3>& directions_3D,
+    multi_array<int, 3>& corr_edge_3D,
+    multi_array<parent3D, 3>& pr_3D,
+    multi_array<int, 3>& d1_3D,
+    multi_array<int, 3>& d2_3D,
+    MazeScratch3D& scratch,
+    const odb::Rect* footprint)
 {
-  static multi_array<Direction, 3> directions_3D(
-      boost::extents[num_layers_][y_grid_][x_grid_]);
-  static multi_array<int, 3> corr_edge_3D(
-      boost::extents[num_layers_][y_grid_][x_grid_]);
-  static multi_array<parent3D, 3> pr_3D_(
-      boost::extents[num_layers_][y_grid_][x_grid_]);
-
-  int64 total_size = static_cast<int64>(num_layers_) * y_range_ * x_range_;
-  static std::vector<bool> pop_heap2_3D(total_size, false);
-
-  // allocate memory for priority queue
-  total_size = static_cast<int64>(y_grid_) * x_grid_ * num_layers_;
-  static std::vector<int*> src_heap_3D(total_size);
-  static std::vector<int*> dest_heap_3D(total_size);
-
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_; j++) {
-      in_region_[i][j] = false;
-    }
-  }
-
-  const int endIND = tree_order_pv_.size() * 0.9;
-
-  static multi_array<int, 3> d1_3D(
-      boost::extents[num_layers_][y_range_][x_range_]);
-  static multi_array<int, 3> d2_3D(
-      boost::extents[num_layers_][y_range_][x_range_]);
-
-  for (int orderIndex = 0; orderIndex < endIND; orderIndex++) {
-    const int netID = tree_order_pv_[orderIndex].treeIndex;
+  FrNet* net = nets_[netID];
 
-    FrNet* net = nets_[netID];
+  int enlarge = expand;
+  const int num_terminals = sttrees_[netID].num_terminals;
+  auto& treeedges = sttrees_[netID].edges;
+  auto& treenodes = sttrees_[netID].nodes;
+  const int origEng = enlarge;
 
-    int enlarge = expand;
-    const int num_terminals = sttrees_[netID].num_terminals;
-    auto& treeedges = sttrees_[netID].edges;
-    auto& treenodes = sttrees_[netID].nodes;
-    const int origEng = enlarge;
+  for (int edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
+    TreeEdge* treeedge = &(treeedges[edgeID]);
 
-    for (int edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
-      TreeEdge* treeedge = &(treeedges[edgeID]);
+    if (treeedge->len >= ripupTHub || treeedge->len <= ripupTHlb) {
+      continue;
+    }
+    int n1 = treeedge->n1;
+    int n2 = treeedge->n2;
+    const int n1x = treenodes[n1].x;
+    const int n1y = treenodes[n1].y;
+    const int n2x = treenodes[n2].x;
+    const int n2y = treenodes[n2].y;
+
+    const int ymin = std::min(n1y, n2y);
+    const int ymax = std::max(n1y, n2y);
+
+    const int xmin = std::min(n1x, n2x);
+    const int xmax = std::max(n1x, n2x);
+
+    // ripup the routing for the edge
+    if (!newRipup3DType3(netID, edgeID)) {
+      continue;
+    }
+    enlarge = std::min(origEng, treeedge->route.routelen);
+
+    int regionX1 = std::max(0, xmin - enlarge);
+    int regionX2 = std::min(x_grid_ - 1, xmax + enlarge);
+    int regionY1 = std::max(0, ymin - enlarge);
+    int regionY2 = std::min(y_grid_ - 1, ymax + enlarge);
+    if (footprint != nullptr) {
+      // Shifted tree nodes can put the region past the net's footprint.
+      regionX1 = std::max(regionX1, footprint->xMin());
+      regionX2 = std::min(regionX2, footprint->xMax());
+      regionY1 = std::max(regionY1, footprint->yMin());
+      regionY2 = std::min(regionY2, footprint->yMax());
+    }
 
-      if (treeedge->len >= ripupTHub || treeedge->len <= ripupTHlb) {
-        continue;
-      }
-      int n1 = treeedge->n1;
-      int n2 = treeedge->n2;
-      const int n1x = treenodes[n1].x;
-      const int n1y = treenodes[n1].y;
-      const int n2x = treenodes[n2].x;
-      const int n2y = treenodes[n2].y;
+    bool n1Shift = false;
+    bool n2Shift = false;
+    int n1a = treeedge->n1a;
+    int n2a = treeedge->n2a;
+
+    // grids of d1_3D are reset to BIG_INT when the search first reaches
+    // them. d2_3D is only used to index pop_heap2_3D and needs no reset.
+    scratch.newSearch();
+
+    // The heaps only hold grids of the routing region
+    const int64 region_size = static_cast<int64>(regionX2 - regionX1 + 1)
+                              * (regionY2 - regionY1 + 1) * num_layers_;
+    scratch.src_heap.reserve(region_size);
+    scratch.dest_heap.reserve(region_size);
+
+    // setup src_heap_3D, dest_heap_3D and initialize d1_3D[][] and
+    // d2_3D[][] for all the grids on the two subtrees
+    setupHeap3D(netID,
+                edgeID,
+                scratch.src_heap,
+                scratch.dest_heap,
+                directions_3D,
+                corr_edge_3D,
+                d1_3D,
+                d2_3D,
+                regionX1,
+                regionX2,
+                regionY1,
+                regionY2);
+    for (const int* dist : scratch.src_heap) {
+      scratch.reach(d1_3D, dist);
+    }
 
-      const int ymin = std::min(n1y, n2y);
-      const int ymax = std::max(n1y, n2y);
+    // while loop to find shortest path
+    int ind1 = (scratch.src_heap[0] - &d1_3D[0][0][0]);
 
-      const int xmin = std::min(n1x, n2x);
-      const int xmax = std::max(n1x, n2x);
+    for (int i = 0; i < scratch.dest_heap.size(); i++)
+      scratch.pop_heap2[scratch.dest_heap[i] - &d2_3D[0][0][0]] = true;
 
-      // ripup the routing for the edge
-      if (!newRipup3DType3(netID, edgeID)) {
-        continue;
-      }
-      enlarge = std::min(origEng, treeedge->route.routelen);
-
-      const int regionX1 = std::max(0, xmin - enlarge);
-      const int regionX2 = std::min(x_grid_ - 1, xmax + enlarge);
-      const int regionY1 = std::max(0, ymin - enlarge);
-      const int regionY2 = std::min(y_grid_ - 1, ymax + enlarge);
-
-      bool n1Shift = false;
-      bool n2Shift = false;
-      int n1a = treeedge->n1a;
-      int n2a = treeedge->n2a;
-
-      // initialize pop_src_heap_3D_[] and pop_heap2_3D[] as false (for
-      // detecting the shortest path is found or not)
-
-      for (int k = 0; k < num_layers_; k++) {
-        for (int i = regionY1; i <= regionY2; i++) {
-          for (int j = regionX1; j <= regionX2; j++) {
-            d1_3D[k][i][j] = BIG_INT;
-            d2_3D[k][i][j] = BIG_INT;
-          }
-        }
-      }
-
-      // setup src_heap_3D, dest_heap_3D and initialize d1_3D[][] and
-      // d2_3D[][] for all the grids on the two subtrees
-      setupHeap3D(netID,
-                  edgeID,
-                  src_heap_3D,
-                  dest_heap_3D,
-                  directions_3D,
-                  corr_edge_3D,
-                  d1_3D,
-                  d2_3D,
-                  regionX1,
-                  regionX2,
-                  regionY1,
-                  regionY2);
-
-      // while loop to find shortest path
-      int ind1 = (src_heap_3D[0] - &d1_3D[0][0][0]);
-
-      for (int i = 0; i < dest_heap_3D.size(); i++)
-        pop_heap2_3D[dest_heap_3D[i] - &d2_3D[0][0][0]] = true;
-
-      while (pop_heap2_3D[ind1]
-             == false)  // stop until the grid position been popped out from
-                        // both src_heap_3D and dest_heap_3D
-      {
-        // relax all the adjacent grids within the enlarged region for
-        // source subtree
-        const int curL = ind1 / (grid_hv_);
-        const int remd = ind1 % (grid_hv_);
-        const int curX = remd % x_range_;
-        const int curY = remd / x_range_;
-        removeMin3D(src_heap_3D);
-
-        const bool Horizontal
-            = layer_directions_[curL] == odb::dbTechLayerDir::HORIZONTAL;
-
-        if (Horizontal) {
-          // left
-          if (curX > regionX1
-              && directions_3D[curL][curY][curX] != Direction::East) {
-            const float tmp = d1_3D[curL][curY][curX] + 1;
-            if (h_edges_3D_[curL][curY][curX - 1].usage
-                    < h_edges_3D_[curL][curY][curX - 1].cap
-                && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              const int tmpX = curX - 1;  // the left neighbor
-
-              if (d1_3D[curL][curY][tmpX] >= BIG_INT)  // left neighbor not been
-                                                       // put into src_heap_3D
-              {
-                d1_3D[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D[curL][curY][tmpX] = Direction::West;
-                src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-              } else if (d1_3D[curL][curY][tmpX]
-                         > tmp)  // left neighbor been put into src_heap_3D
-                                 // but needs update
-              {
-                d1_3D[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D[curL][curY][tmpX] = Direction::West;
-                const int* dtmp = &d1_3D[curL][curY][tmpX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
-              }
+    while (scratch.pop_heap2[ind1]
+           == false)  // stop until the grid position been popped out from
+                      // both src_heap_3D and dest_heap_3D
+    {
+      // relax all the adjacent grids within the enlarged region for
+      // source subtree
+      const int curL = ind1 / (grid_hv_);
+      const int remd = ind1 % (grid_hv_);
+      const int curX = remd % x_range_;
+      const int curY = remd / x_range_;
+      removeMin3D(scratch.src_heap);
+
+      const bool Horizontal
+          = layer_directions_[curL] == odb::dbTechLayerDir::HORIZONTAL;
+
+      if (Horizontal) {
+        // left
+        if (curX > regionX1
+            && directions_3D[curL][curY][curX] != Direction::East) {
+          const float tmp = d1_3D[curL][curY][curX] + 1;
+          if (h_edges_3D_[curL][curY][curX - 1].usage
+                  < h_edges_3D_[curL][curY][curX - 1].cap
+              && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
+            const int tmpX = curX - 1;  // the left neighbor
+
+            scratch.touch(d1_3D, curL, curY, tmpX);
+
+            if (d1_3D[curL][curY][tmpX] >= BIG_INT)  // left neighbor not been
+                                                     // put into src_heap_3D
+            {
+              d1_3D[curL][curY][tmpX] = tmp;
+              pr_3D[curL][curY][tmpX].l = curL;
+              pr_3D[curL][curY][tmpX].x = curX;
+              pr_3D[curL][curY][tmpX].y = curY;
+              directions_3D[curL][curY][tmpX] = Direction::West;
+              scratch.src_heap.push_back(&d1_3D[curL][curY][tmpX]);
+              updateHeap3D(scratch.src_heap, scratch.src_heap.size() - 1);
+            } else if (d1_3D[curL][curY][tmpX]
+                       > tmp)  // left neighbor been put into src_heap_3D
+                               // but needs update
+            {
+              d1_3D[curL][curY][tmpX] = tmp;
+              pr_3D[curL][curY][tmpX].l = curL;
+              pr_3D[curL][curY][tmpX].x = curX;
+              pr_3D[curL][curY][tmpX].y = curY;
+              directions_3D[curL][curY][tmpX] = Direction::West;
+              const int* dtmp = &d1_3D[curL][curY][tmpX];
+              int ind = 0;
+              while (scratch.src_heap[ind] != dtmp)
+                ind++;
+              updateHeap3D(scratch.src_heap, ind);
             }
           }
-          // right
-          if (Horizontal && curX < regionX2
-              && directions_3D[curL][curY][curX] != Direction::West) {
-            const float tmp = d1_3D[curL][curY][curX] + 1;
-            const int tmpX = curX + 1;  // the right neighbor
-
-            if (h_edges_3D_[curL][curY][curX].usage
-                    < h_edges_3D_[curL][curY][curX].cap
-                && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              if (d1_3D[curL][curY][tmpX]
-                  >= BIG_INT)  // right neighbor not been put into
-                               // src_heap_3D
-              {
-                d1_3D[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D[curL][curY][tmpX] = Direction::East;
-                src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-              } else if (d1_3D[curL][curY][tmpX]
-                         > tmp)  // right neighbor been put into src_heap_3D
-                                 // but needs update
-              {
-                d1_3D[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D[curL][curY][tmpX] = Direction::East;
-                const int* dtmp = &d1_3D[curL][curY][tmpX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
-              }
+        }
+        // right
+        if (Horizontal && curX < regionX2
+            && directions_3D[curL][curY][curX] != Direction::West) {
+          const float tmp = d1_3D[curL][curY][curX] + 1;
+          const int tmpX = curX + 1;  // the right neighbor
+
+          if (h_edges_3D_[curL][curY][curX].usage
+                  < h_edges_3D_[curL][curY][curX].cap
+              && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
+            scratch.touch(d1_3D, curL, curY, tmpX);
+            if (d1_3D[curL][curY][tmpX]
+                >= BIG_INT)  // right neighbor not been put into
+                             // src_heap_3D
+            {
+              d1_3D[curL][curY][tmpX] = tmp;
+              pr_3D[curL][curY][tmpX].l = curL;
+              pr_3D[curL][curY][tmpX].x = curX;
+              pr_3D[curL][curY][tmpX].y = curY;
+              directions_3D[curL][curY][tmpX] = Direction::East;
+              scratch.src_heap.push_back(&d1_3D[curL][curY][tmpX]);
+              updateHeap3D(scratch.src_heap, scratch.src_heap.size() - 1);
+            } else if (d1_3D[curL][curY][tmpX]
+                       > tmp)  // right neighbor been put into src_heap_3D
+                               // but needs update
+            {
+              d1_3D[curL][curY][tmpX] = tmp;
+              pr_3D[curL][curY][tmpX].l = curL;
+              pr_3D[curL][curY][tmpX].x = curX;
+              pr_3D[curL][curY][tmpX].y = curY;
+              directions_3D[curL][curY][tmpX] = Direction::East;
+              const int* dtmp = &d1_3D[curL][curY][tmpX];
+              int ind = 0;
+              while (scratch.src_heap[ind] != dtmp)
+                ind++;
+              updateHeap3D(scratch.src_heap, ind);
             }
           }
-        } else {
-          // bottom
-          if (!Horizontal && curY > regionY1
-              && directions_3D[curL][curY][curX] != Direction::South) {
-            const float tmp = d1_3D[curL][curY][curX] + 1;
-            const int tmpY = curY - 1;  // the bottom neighbor
-            if (v_edges_3D_[curL][curY - 1][curX].usage
-                    < v_edges_3D_[curL][curY - 1][curX].cap
-                && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              if (d1_3D[curL][tmpY][curX]
-                  >= BIG_INT)  // bottom neighbor not been put into
-                               // src_heap_3D
-              {
-                d1_3D[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D[curL][tmpY][curX] = Direction::North;
-                src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-              } else if (d1_3D[curL][tmpY][curX]
-                         > tmp)  // bottom neighbor been put into
-                                 // src_heap_3D but needs update
-              {
-                d1_3D[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D[curL][tmpY][curX] = Direction::North;
-                const int* dtmp = &d1_3D[curL][tmpY][curX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
-              }
+        }
+      } else {
+        // bottom
+        if (!Horizontal && curY > regionY1
+            && directions_3D[curL][curY][curX] != Direction::South) {
+          const float tmp = d1_3D[curL][curY][curX] + 1;
+          const int tmpY = curY - 1;  // the bottom neighbor
+          if (v_edges_3D_[curL][curY - 1][curX].usage
+                  < v_edges_3D_[curL][curY - 1][curX].cap
+              && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
+            scratch.touch(d1_3D, curL, tmpY, curX);
+            if (d1_3D[curL][tmpY][curX]
+                >= BIG_INT)  // bottom neighbor not been put into
+                             // src_heap_3D
+            {
+              d1_3D[curL][tmpY][curX] = tmp;
+              pr_3D[curL][tmpY][curX].l = curL;
+              pr_3D[curL][tmpY][curX].x = curX;
+              pr_3D[curL][tmpY][curX].y = curY;
+              directions_3D[curL][tmpY][curX] = Direction::North;
+              scratch.src_heap.push_back(&d1_3D[curL][tmpY][curX]);
+              updateHeap3D(scratch.src_heap, scratch.src_heap.size() - 1);
+            } else if (d1_3D[curL][tmpY][curX]
+                       > tmp)  // bottom neighbor been put into
+                               // src_heap_3D but needs update
+            {
+              d1_3D[curL][tmpY][curX] = tmp;
+              pr_3D[curL][tmpY][curX].l = curL;
+              pr_3D[curL][tmpY][curX].x = curX;
+              pr_3D[curL][tmpY][curX].y = curY;
+              directions_3D[curL][tmpY][curX] = Direction::North;
+              const int* dtmp = &d1_3D[curL][tmpY][curX];
+              int ind = 0;
+              while (scratch.src_heap[ind] != dtmp)
+                ind++;
+              updateHeap3D(scratch.src_heap, ind);
             }
           }
-          // top
-          if (!Horizontal && curY < regionY2
-              && directions_3D[curL][curY][curX] != Direction::North) {
-            const float tmp = d1_3D[curL][curY][curX] + 1;
-            const int tmpY = curY + 1;  // the top neighbor
-            if (v_edges_3D_[curL][curY][curX].usage
-                    < v_edges_3D_[curL][curY][curX].cap
-                && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              if (d1_3D[curL][tmpY][curX]
-                  >= BIG_INT)  // top neighbor not been put into src_heap_3D
-              {
-                d1_3D[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D[curL][tmpY][curX] = Direction::South;
-                src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-              } else if (d1_3D[curL][tmpY][curX]
-                         > tmp)  // top neighbor been put into src_heap_3D
-                                 // but needs update
-              {
-                d1_3D[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D[curL][tmpY][curX] = Direction::South;
-                const int* dtmp = &d1_3D[curL][tmpY][curX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
-              }
+        }
+        // top
+        if (!Horizontal && curY < regionY2
+            && directions_3D[curL][curY][curX] != Direction::North) {
+          const float tmp = d1_3D[curL][curY][curX] + 1;
+          const int tmpY = curY + 1;  // the top neighbor
+          if (v_edges_3D_[curL][curY][curX].usage
+                  < v_edges_3D_[curL][curY][curX].cap
+              && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
+            scratch.touch(d1_3D, curL, tmpY, curX);
+            if (d1_3D[curL][tmpY][curX]
+                >= BIG_INT)  // top neighbor not been put into src_heap_3D
+            {
+              d1_3D[curL][tmpY][curX] = tmp;
+              pr_3D[curL][tmpY][curX].l = curL;
+              pr_3D[curL][tmpY][curX].x = curX;
+              pr_3D[curL][tmpY][curX].y = curY;
+              directions_3D[curL][tmpY][curX] = Direction::South;
+              scratch.src_heap.push_back(&d1_3D[curL][tmpY][curX]);
+              updateHeap3D(scratch.src_heap, scratch.src_heap.size() - 1);
+            } else if (d1_3D[curL][tmpY][curX]
+                       > tmp)  // top neighbor been put into src_heap_3D
+                               // but needs update
+            {
+              d1_3D[curL][tmpY][curX] = tmp;
+              pr_3D[curL][tmpY][curX].l = curL;
+              pr_3D[curL][tmpY][curX].x = curX;
+              pr_3D[curL][tmpY][curX].y = curY;
+              directions_3D[curL][tmpY][curX] = Direction::South;
+              const int* dtmp = &d1_3D[curL][tmpY][curX];
+              int ind = 0;
+              while (scratch.src_heap[ind] != dtmp)
+                ind++;
+              updateHeap3D(scratch.src_heap, ind);
             }
           }
         }
+      }
 
-        // down
-        if (curL > 0 && directions_3D[curL][curY][curX] != Direction::Up) {
-          const float tmp = d1_3D[curL][curY][curX] + via_cost_;
-          const int tmpL = curL - 1;  // the bottom neighbor
-
-          if (d1_3D[tmpL][curY][curX]
-              >= BIG_INT)  // bottom neighbor not been put into src_heap_3D
-          {
-            d1_3D[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D[tmpL][curY][curX] = Direction::Down;
-            src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
-            updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-          } else if (d1_3D[tmpL][curY][curX]
-                     > tmp)  // bottom neighbor been put into src_heap_3D
-                             // but needs update
-          {
-            d1_3D[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D[tmpL][curY][curX] = Direction::Down;
-            const int* dtmp = &d1_3D[tmpL][curY][curX];
-            int ind = 0;
-            while (src_heap_3D[ind] != dtmp)
-              ind++;
-            updateHeap3D(src_heap_3D, ind);
-          }
-        }
+      // down
+      if (curL > 0 && directions_3D[curL][curY][curX] != Direction::Up) {
+        const float tmp = d1_3D[curL][curY][curX] + via_cost_;
+        const int tmpL = curL - 1;  // the bottom neighbor
 
-        // up
-        if (curL < num_layers_ - 1
-            && directions_3D[curL][curY][curX] != Direction::Down) {
-          const float tmp = d1_3D[curL][curY][curX] + via_cost_;
-          const int tmpL = curL + 1;  // the bottom neighbor
-          if (d1_3D[tmpL][curY][curX]
-              >= BIG_INT)  // bottom neighbor not been put into src_heap_3D
-          {
-            d1_3D[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D[tmpL][curY][curX] = Direction::Up;
-            src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
-            updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-          } else if (d1_3D[tmpL][curY][curX]
-                     > tmp)  // bottom neighbor been put into src_heap_3D
-                             // but needs update
-          {
-            d1_3D[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D[tmpL][curY][curX] = Direction::Up;
-            const int* dtmp = &d1_3D[tmpL][curY][curX];
-            int ind = 0;
-            while (src_heap_3D[ind] != dtmp)
-              ind++;
-            updateHeap3D(src_heap_3D, ind);
-          }
+        scratch.touch(d1_3D, tmpL, curY, curX);
+
+        if (d1_3D[tmpL][curY][curX]
+            >= BIG_INT)  // bottom neighbor not been put into src_heap_3D
+        {
+          d1_3D[tmpL][curY][curX] = tmp;
+          pr_3D[tmpL][curY][curX].l = curL;
+          pr_3D[tmpL][curY][curX].x = curX;
+          pr_3D[tmpL][curY][curX].y = curY;
+          directions_3D[tmpL][curY][curX] = Direction::Down;
+          scratch.src_heap.push_back(&d1_3D[tmpL][curY][curX]);
+          updateHeap3D(scratch.src_heap, scratch.src_heap.size() - 1);
+        } else if (d1_3D[tmpL][curY][curX]
+                   > tmp)  // bottom neighbor been put into src_heap_3D
+                           // but needs update
+        {
+          d1_3D[tmpL][curY][curX] = tmp;
+          pr_3D[tmpL][curY][curX].l = curL;
+          pr_3D[tmpL][curY][curX].x = curX;
+          pr_3D[tmpL][curY][curX].y = curY;
+          directions_3D[tmpL][curY][curX] = Direction::Down;
+          const int* dtmp = &d1_3D[tmpL][curY][curX];
+          int ind = 0;
+          while (scratch.src_heap[ind] != dtmp)
+            ind++;
+          updateHeap3D(scratch.src_heap, ind);
         }
+      }
 
-        if (src_heap_3D.empty()) {
-          logger_->error(GRT,
-                         183,
-                         "Net {}: heap underflow during 3D maze routing.",
-                         nets_[netID]->getName());
+      // up
+      if (curL < num_layers_ - 1
+          && directions_3D[curL][curY][curX] != Direction::Down) {
+        const float tmp = d1_3D[curL][curY][curX] + via_cost_;
+        const int tmpL = curL + 1;  // the bottom neighbor
+        scratch.touch(d1_3D, tmpL, curY, curX);
+        if (d1_3D[tmpL][curY][curX]
+            >= BIG_INT)  // bottom neighbor not been put into src_heap_3D
+        {
+          d1_3D[tmpL][curY][curX] = tmp;
+          pr_3D[tmpL][curY][curX].l = curL;
+          pr_3D[tmpL][curY][curX].x = curX;
+          pr_3D[tmpL][curY][curX].y = curY;
+          directions_3D[tmpL][curY][curX] = Direction::Up;
+          scratch.src_heap.push_back(&d1_3D[tmpL][curY][curX]);
+          updateHeap3D(scratch.src_heap, scratch.src_heap.size() - 1);
+        } else if (d1_3D[tmpL][curY][curX]
+                   > tmp)  // bottom neighbor been put into src_heap_3D
+                           // but needs update
+        {
+          d1_3D[tmpL][curY][curX] = tmp;
+          pr_3D[tmpL][curY][curX].l = curL;
+          pr_3D[tmpL][curY][curX].x = curX;
+          pr_3D[tmpL][curY][curX].y = curY;
+          directions_3D[tmpL][curY][curX] = Direction::Up;
+          const int* dtmp = &d1_3D[tmpL][curY][curX];
+          int ind = 0;
+          while (scratch.src_heap[ind] != dtmp)
+            ind++;
+          updateHeap3D(scratch.src_heap, ind);
         }
-        // update ind1 for next loop
-        ind1 = (src_heap_3D[0] - &d1_3D[0][0][0]);
-      }  // while loop
+      }
 
-      for (int i = 0; i < dest_heap_3D.size(); i++)
-        pop_heap2_3D[dest_heap_3D[i] - &d2_3D[0][0][0]] = false;
+      if (scratch.src_heap.empty()) {
+        logger_->error(GRT,
+                       183,
+                       "Net {}: heap underflow during 3D maze routing.",
+                       nets_[netID]->getName());
+      }
+      // update ind1 for next loop
+      ind1 = (scratch.src_heap[0] - &d1_3D[0][0][0]);
+    }  // while loop
 
-      // get the new route for the edge and store it in gridsX[] and
-      // gridsY[] temporarily
+    for (int i = 0; i < scratch.dest_heap.size(); i++)
+      scratch.pop_heap2[scratch.dest_heap[i] - &d2_3D[0][0][0]] = false;
 
-      const int crossL = ind1 / (grid_hv_);
-      const int crossX = (ind1 % (grid_hv_)) % x_range_;
-      const int crossY = (ind1 % (grid_hv_)) / x_range_;
+    // get the new route for the edge and store it in gridsX[] and
+    // gridsY[] temporarily
 
-      int cnt = 0;
-      int curX = crossX;
-      int curY = crossY;
-      int curL = crossL;
+    const int crossL = ind1 / (grid_hv_);
+    const int crossX = (ind1 % (grid_hv_)) % x_range_;
+    const int crossY = (ind1 % (grid_hv_)) / x_range_;
 
-      if (d1_3D[curL][curY][curX] == 0) {
-        recoverEdge(netID, edgeID);
-        break;
-      }
+    int cnt = 0;
+    int curX = crossX;
+    int curY = crossY;
+    int curL = crossL;
+
+    if (d1_3D[curL][curY][curX] == 0) {
+      recoverEdge(
+          netID, edgeID, scratch.h_used_ggrid, scratch.v_used_ggrid);
+      return;
+    }
 
-      std::vector<int> tmp_gridsX, tmp_gridsY, tmp_gridsL;
+    std::vector<int> tmp_gridsX, tmp_gridsY, tmp_gridsL;
 
-      while (d1_3D[curL][curY][curX] != 0)  // loop until reach subtree1
-      {
-        const int tmpL = pr_3D_[curL][curY][curX].l;
-        const int tmpX = pr_3D_[curL][curY][curX].x;
-        const int tmpY = pr_3D_[curL][curY][curX].y;
-        curX = tmpX;
-        curY = tmpY;
-        curL = tmpL;
-        fflush(stdout);
-        tmp_gridsX.push_back(curX);
-        tmp_gridsY.push_back(curY);
-        tmp_gridsL.push_back(curL);
-        cnt++;
-      }
+    while (d1_3D[curL][curY][curX] != 0)  // loop until reach subtree1
+    {
+      const int tmpL = pr_3D[curL][curY][curX].l;
+      const int tmpX = pr_3D[curL][curY][curX].x;
+      const int tmpY = pr_3D[curL][curY][curX].y;
+      curX = tmpX;
+      curY = tmpY;
+      curL = tmpL;
+      fflush(stdout);
+      tmp_gridsX.push_back(curX);
+      tmp_gridsY.push_back(curY);
+      tmp_gridsL.push_back(curL);
+      cnt++;
+    }
 
-      std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
-      std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
-      std::vector<int> gridsL(tmp_gridsL.rbegin(), tmp_gridsL.rend());
+    std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
+    std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
+    std::vector<int> gridsL(tmp_gridsL.rbegin(), tmp_gridsL.rend());
 
-      // add the connection point (crossX, crossY)
-      gridsX.push_back(crossX);
-      gridsY.push_back(crossY);
-      gridsL.push_back(crossL);
-      cnt++;
+    // add the connection point (crossX, crossY)
+    gridsX.push_back(crossX);
+    gridsY.push_back(crossY);
+    gridsL.push_back(crossL);
+    cnt++;
 
-      curX = crossX;
-      curY = crossY;
-      curL = crossL;
+    curX = crossX;
+    curY = crossY;
+    curL = crossL;
 
-      const int cnt_n1n2 = cnt;
+    const int cnt_n1n2 = cnt;
 
-      const int E1x = gridsX[0];
-      const int E1y = gridsY[0];
-      const int E2x = gridsX.back();
-      const int E2y = gridsY.back();
+    const int E1x = gridsX[0];
+    const int E1y = gridsY[0];
+    const int E2x = gridsX.back();
+    const int E2y = gridsY.back();
 
-      int headRoom = 0;
-      int origL = gridsL[0];
+    int headRoom = 0;
+    int origL = gridsL[0];
 
-      while (headRoom < gridsX.size() && gridsX[headRoom] == E1x
-             && gridsY[headRoom] == E1y) {
-        headRoom++;
-      }
-      if (headRoom > 0) {
-        headRoom--;
-      }
+    while (headRoom < gridsX.size() && gridsX[headRoom] == E1x
+           && gridsY[headRoom] == E1y) {
+      headRoom++;
+    }
+    if (headRoom > 0) {
+      headRoom--;
+    }
 
-      int lastL = gridsL[headRoom];
+    int lastL = gridsL[headRoom];
 
-      // change the tree structure according to the new routing for the tree
-      // edge find E1 and E2, and the endpoints of the edges they are on
+    // change the tree structure according to the new routing for the tree
+    // edge find E1 and E2, and the endpoints of the edges they are on
 
-      const int edge_n1n2 = edgeID;
-      // (1) consider subtree1
-      if (n1 < num_terminals && (E1x != n1x || E1y != n1y)) {
-        // split neighbor edge and return id new node
-        n1 = splitEdge(treeedges, treenodes, n2, n1, edgeID);
-        // calculate TreeNode variables for new node
-        setTreeNodesVariables(netID);
+    const int edge_n1n2 = edgeID;
+    // (1) consider subtree1
+    if (n1 < num_terminals && (E1x != n1x || E1y != n1y)) {
+      // split neighbor edge and return id new node
+      n1 = splitEdge(treeedges, treenodes, n2, n1, edgeID);
+      // calculate TreeNode variables for new node
+      setTreeNodesVariables(netID);
+    }
+    if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
+    // n1 is not a pin and E1!=n1, then make change to subtree1,
+    // otherwise, no change to subtree1
+    {
+      n1Shift = true;
+      const int corE1 = corr_edge_3D[origL][E1y][E1x];
+
+      const int endpt1 = treeedges[corE1].n1;
+      const int endpt2 = treeedges[corE1].n2;
+
+      // find A1, A2 and edge_n1A1, edge_n1A2
+      int edge_n1A1, edge_n1A2;
+      int A1, A2;
+      if (treenodes[n1].nbr[0] == n2) {
+        A1 = treenodes[n1].nbr[1];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[1];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else if (treenodes[n1].nbr[1] == n2) {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[1];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[1];
       }
-      if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
-      // n1 is not a pin and E1!=n1, then make change to subtree1,
-      // otherwise, no change to subtree1
+
+      if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
       {
-        n1Shift = true;
-        const int corE1 = corr_edge_3D[origL][E1y][E1x];
-
-        const int endpt1 = treeedges[corE1].n1;
-        const int endpt2 = treeedges[corE1].n2;
-
-        // find A1, A2 and edge_n1A1, edge_n1A2
-        int edge_n1A1, edge_n1A2;
-        int A1, A2;
-        if (treenodes[n1].nbr[0] == n2) {
-          A1 = treenodes[n1].nbr[1];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[1];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else if (treenodes[n1].nbr[1] == n2) {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[1];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[1];
+        // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
+        // (n1, A1)
+        if (endpt1 == A2 || endpt2 == A2) {
+          std::swap(A1, A2);
+          std::swap(edge_n1A1, edge_n1A2);
         }
 
-        if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
-        {
-          // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
-          // (n1, A1)
-          if (endpt1 == A2 || endpt2 == A2) {
-            std::swap(A1, A2);
-            std::swap(edge_n1A1, edge_n1A2);
-          }
-
-          // update route for edge (n1, A1), (n1, A2)
-          updateRouteType13D(netID,
-                             treenodes,
-                             n1,
-                             A1,
-                             A2,
-                             E1x,
-                             E1y,
-                             treeedges,
-                             edge_n1A1,
-                             edge_n1A2);
-
-          // update position for n1
-
-          // treenodes[n1].l = E1l;
-          treenodes[n1].assigned = true;
-        }     // if E1 is on (n1, A1) or (n1, A2)
-        else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-        {
-          const int C1 = endpt1;
-          const int C2 = endpt2;
-          const int edge_C1C2 = corr_edge_3D[origL][E1y][E1x];
-
-          // update route for edge (n1, C1), (n1, C2) and (A1, A2)
-          updateRouteType23D(netID,
-                             treenodes,
-                             n1,
-                             A1,
-                             A2,
-                             C1,
-                             C2,
-                             E1x,
-                             E1y,
-                             treeedges,
-                             edge_n1A1,
-                             edge_n1A2,
-                             edge_C1C2);
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-          treenodes[n1].assigned = true;
-          // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
-          // C2)->(A1, A2)
-          const int edge_n1C1 = edge_n1A1;
-          treeedges[edge_n1C1].n1 = C1;
-          treeedges[edge_n1C1].n2 = n1;
-          const int edge_n1C2 = edge_n1A2;
-          treeedges[edge_n1C2].n1 = n1;
-          treeedges[edge_n1C2].n2 = C2;
-          const int edge_A1A2 = edge_C1C2;
-          treeedges[edge_A1A2].n1 = A1;
-          treeedges[edge_A1A2].n2 = A2;
-          // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
-          // n1's nbr (n2, A1, A2)->(n2, C1, C2)
-          treenodes[n1].nbr[0] = n2;
-          treenodes[n1].edge[0] = edge_n1n2;
-          treenodes[n1].nbr[1] = C1;
-          treenodes[n1].edge[1] = edge_n1C1;
-          treenodes[n1].nbr[2] = C2;
-          treenodes[n1].edge[2] = edge_n1C2;
-          // A1's nbr n1->A2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A1].nbr[i] == n1) {
-              treenodes[A1].nbr[i] = A2;
-              treenodes[A1].edge[i] = edge_A1A2;
-              break;
-            }
+        // update route for edge (n1, A1), (n1, A2)
+        updateRouteType13D(netID,
+                           treenodes,
+                           n1,
+                           A1,
+                           A2,
+                           E1x,
+                           E1y,
+                           treeedges,
+                           edge_n1A1,
+                           edge_n1A2);
+
+        // update position for n1
+
+        // treenodes[n1].l = E1l;
+        treenodes[n1].assigned = true;
+      }     // if E1 is on (n1, A1) or (n1, A2)
+      else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+      {
+        const int C1 = endpt1;
+        const int C2 = endpt2;
+        const int edge_C1C2 = corr_edge_3D[origL][E1y][E1x];
+
+        // update route for edge (n1, C1), (n1, C2) and (A1, A2)
+        updateRouteType23D(netID,
+                           treenodes,
+                           n1,
+                           A1,
+                           A2,
+                           C1,
+                           C2,
+                           E1x,
+                           E1y,
+                           treeedges,
+                           edge_n1A1,
+                           edge_n1A2,
+                           edge_C1C2);
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+        treenodes[n1].assigned = true;
+        // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
+        // C2)->(A1, A2)
+        const int edge_n1C1 = edge_n1A1;
+        treeedges[edge_n1C1].n1 = C1;
+        treeedges[edge_n1C1].n2 = n1;
+        const int edge_n1C2 = edge_n1A2;
+        treeedges[edge_n1C2].n1 = n1;
+        treeedges[edge_n1C2].n2 = C2;
+        const int edge_A1A2 = edge_C1C2;
+        treeedges[edge_A1A2].n1 = A1;
+        treeedges[edge_A1A2].n2 = A2;
+        // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
+        // n1's nbr (n2, A1, A2)->(n2, C1, C2)
+        treenodes[n1].nbr[0] = n2;
+        treenodes[n1].edge[0] = edge_n1n2;
+        treenodes[n1].nbr[1] = C1;
+        treenodes[n1].edge[1] = edge_n1C1;
+        treenodes[n1].nbr[2] = C2;
+        treenodes[n1].edge[2] = edge_n1C2;
+        // A1's nbr n1->A2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A1].nbr[i] == n1) {
+            treenodes[A1].nbr[i] = A2;
+            treenodes[A1].edge[i] = edge_A1A2;
+            break;
           }
-          // A2's nbr n1->A1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A2].nbr[i] == n1) {
-              treenodes[A2].nbr[i] = A1;
-              treenodes[A2].edge[i] = edge_A1A2;
-              break;
-            }
+        }
+        // A2's nbr n1->A1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A2].nbr[i] == n1) {
+            treenodes[A2].nbr[i] = A1;
+            treenodes[A2].edge[i] = edge_A1A2;
+            break;
           }
-          // C1's nbr C2->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C1].nbr[i] == C2) {
-              treenodes[C1].nbr[i] = n1;
-              treenodes[C1].edge[i] = edge_n1C1;
-              break;
-            }
+        }
+        // C1's nbr C2->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C1].nbr[i] == C2) {
+            treenodes[C1].nbr[i] = n1;
+            treenodes[C1].edge[i] = edge_n1C1;
+            break;
           }
-          // C2's nbr C1->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C2].nbr[i] == C1) {
-              treenodes[C2].nbr[i] = n1;
-              treenodes[C2].edge[i] = edge_n1C2;
-              break;
-            }
+        }
+        // C2's nbr C1->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C2].nbr[i] == C1) {
+            treenodes[C2].nbr[i] = n1;
+            treenodes[C2].edge[i] = edge_n1C2;
+            break;
           }
-        }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-      }    // n1 is not a pin and E1!=n1
-      else {
-        newUpdateNodeLayers(treenodes, edge_n1n2, n1a, lastL);
-      }
+        }
+      }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+    }    // n1 is not a pin and E1!=n1
+    else {
+      newUpdateNodeLayers(treenodes, edge_n1n2, n1a, lastL);
+    }
 
-      origL = gridsL[cnt_n1n2 - 1];
-      int tailRoom = cnt_n1n2 - 1;
+    origL = gridsL[cnt_n1n2 - 1];
+    int tailRoom = cnt_n1n2 - 1;
 
-      while (tailRoom > 0 && gridsX[tailRoom] == E2x
-             && gridsY[tailRoom] == E2y) {
-        tailRoom--;
-      }
-      if (tailRoom < cnt_n1n2 - 1) {
-        tailRoom++;
-      }
+    while (tailRoom > 0 && gridsX[tailRoom] == E2x
+           && gridsY[tailRoom] == E2y) {
+      tailRoom--;
+    }
+    if (tailRoom < cnt_n1n2 - 1) {
+      tailRoom++;
+    }
 
-      lastL = gridsL[tailRoom];
+    lastL = gridsL[tailRoom];
 
-      // (2) consider subtree2
-      if (n2 < num_terminals && (E2x != n2x || E2y != n2y)) {
-        // split neighbor edge and return id new node
-        n2 = splitEdge(treeedges, treenodes, n1, n2, edgeID);
-        // calculate TreeNode variables for new node
-        setTreeNodesVariables(netID);
+    // (2) consider subtree2
+    if (n2 < num_terminals && (E2x != n2x || E2y != n2y)) {
+      // split neighbor edge and return id new node
+      n2 = splitEdge(treeedges, treenodes, n1, n2, edgeID);
+      // calculate TreeNode variables for new node
+      setTreeNodesVariables(netID);
+    }
+    if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
+    // n2 is not a pin and E2!=n2, then make change to subtree2,
+    // otherwise, no change to subtree2
+    {
+      // find the endpoints of the edge E1 is on
+
+      n2Shift = true;
+      const int corE2 = corr_edge_3D[origL][E2y][E2x];
+      const int endpt1 = treeedges[corE2].n1;
+      const int endpt2 = treeedges[corE2].n2;
+
+      // find B1, B2
+      int edge_n2B1, edge_n2B2;
+      int B1, B2;
+      if (treenodes[n2].nbr[0] == n1) {
+        B1 = treenodes[n2].nbr[1];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[1];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else if (treenodes[n2].nbr[1] == n1) {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[1];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[1];
       }
-      if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
-      // n2 is not a pin and E2!=n2, then make change to subtree2,
-      // otherwise, no change to subtree2
+
+      if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
       {
-        // find the endpoints of the edge E1 is on
-
-        n2Shift = true;
-        const int corE2 = corr_edge_3D[origL][E2y][E2x];
-        const int endpt1 = treeedges[corE2].n1;
-        const int endpt2 = treeedges[corE2].n2;
-
-        // find B1, B2
-        int edge_n2B1, edge_n2B2;
-        int B1, B2;
-        if (treenodes[n2].nbr[0] == n1) {
-          B1 = treenodes[n2].nbr[1];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[1];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else if (treenodes[n2].nbr[1] == n1) {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[1];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[1];
+        // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
+        // (n2, B1)
+        if (endpt1 == B2 || endpt2 == B2) {
+          std::swap(B1, B2);
+          std::swap(edge_n2B1, edge_n2B2);
         }
 
-        if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
-        {
-          // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
-          // (n2, B1)
-          if (endpt1 == B2 || endpt2 == B2) {
-            std::swap(B1, B2);
-            std::swap(edge_n2B1, edge_n2B2);
-          }
-
-          // update route for edge (n2, B1), (n2, B2)
-          updateRouteType13D(netID,
-                             treenodes,
-                             n2,
-                             B1,
-                             B2,
-                             E2x,
-                             E2y,
-                             treeedges,
-                             edge_n2B1,
-                             edge_n2B2);
-
-          // update position for n2
-          treenodes[n2].assigned = true;
-        }     // if E2 is on (n2, B1) or (n2, B2)
-        else  // E2 is not on (n2, B1) or (n2, B2), but on (d1_3D, d2_3D)
-        {
-          const int D1 = endpt1;
-          const int D2 = endpt2;
-          const int edge_D1D2 = corr_edge_3D[origL][E2y][E2x];
-
-          // update route for edge (n2, d1_3D), (n2, d2_3D) and (B1, B2)
-          updateRouteType23D(netID,
-                             treenodes,
-                             n2,
-                             B1,
-                             B2,
-                             D1,
-                             D2,
-                             E2x,
-                             E2y,
-                             treeedges,
-                             edge_n2B1,
-                             edge_n2B2,
-                             edge_D1D2);
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-          treenodes[n2].assigned = true;
-          // update 3 edges (n2, B1)->(d1_3D, n2), (n2, B2)->(n2, d2_3D),
-          // (d1_3D, d2_3D)->(B1, B2)
-          const int edge_n2D1 = edge_n2B1;
-          treeedges[edge_n2D1].n1 = D1;
-          treeedges[edge_n2D1].n2 = n2;
-          const int edge_n2D2 = edge_n2B2;
-          treeedges[edge_n2D2].n1 = n2;
-          treeedges[edge_n2D2].n2 = D2;
-          const int edge_B1B2 = edge_D1D2;
-          treeedges[edge_B1B2].n1 = B1;
-          treeedges[edge_B1B2].n2 = B2;
-          // update nbr and edge for 5 nodes n2, B1, B2, d1_3D, d2_3D
-          // n1's nbr (n1, B1, B2)->(n1, d1_3D, d2_3D)
-          treenodes[n2].nbr[0] = n1;
-          treenodes[n2].edge[0] = edge_n1n2;
-          treenodes[n2].nbr[1] = D1;
-          treenodes[n2].edge[1] = edge_n2D1;
-          treenodes[n2].nbr[2] = D2;
-          treenodes[n2].edge[2] = edge_n2D2;
-          // B1's nbr n2->B2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B1].nbr[i] == n2) {
-              treenodes[B1].nbr[i] = B2;
-              treenodes[B1].edge[i] = edge_B1B2;
-              break;
-            }
+        // update route for edge (n2, B1), (n2, B2)
+        updateRouteType13D(netID,
+                           treenodes,
+                           n2,
+                           B1,
+                           B2,
+                           E2x,
+                           E2y,
+                           treeedges,
+                           edge_n2B1,
+                           edge_n2B2);
+
+        // update position for n2
+        treenodes[n2].assigned = true;
+      }     // if E2 is on (n2, B1) or (n2, B2)
+      else  // E2 is not on (n2, B1) or (n2, B2), but on (d1_3D, d2_3D)
+      {
+        const int D1 = endpt1;
+        const int D2 = endpt2;
+        const int edge_D1D2 = corr_edge_3D[origL][E2y][E2x];
+
+        // update route for edge (n2, d1_3D), (n2, d2_3D) and (B1, B2)
+        updateRouteType23D(netID,
+                           treenodes,
+                           n2,
+                           B1,
+                           B2,
+                           D1,
+                           D2,
+                           E2x,
+                           E2y,
+                           treeedges,
+                           edge_n2B1,
+                           edge_n2B2,
+                           edge_D1D2);
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+        treenodes[n2].assigned = true;
+        // update 3 edges (n2, B1)->(d1_3D, n2), (n2, B2)->(n2, d2_3D),
+        // (d1_3D, d2_3D)->(B1, B2)
+        const int edge_n2D1 = edge_n2B1;
+        treeedges[edge_n2D1].n1 = D1;
+        treeedges[edge_n2D1].n2 = n2;
+        const int edge_n2D2 = edge_n2B2;
+        treeedges[edge_n2D2].n1 = n2;
+        treeedges[edge_n2D2].n2 = D2;
+        const int edge_B1B2 = edge_D1D2;
+        treeedges[edge_B1B2].n1 = B1;
+        treeedges[edge_B1B2].n2 = B2;
+        // update nbr and edge for 5 nodes n2, B1, B2, d1_3D, d2_3D
+        // n1's nbr (n1, B1, B2)->(n1, d1_3D, d2_3D)
+        treenodes[n2].nbr[0] = n1;
+        treenodes[n2].edge[0] = edge_n1n2;
+        treenodes[n2].nbr[1] = D1;
+        treenodes[n2].edge[1] = edge_n2D1;
+        treenodes[n2].nbr[2] = D2;
+        treenodes[n2].edge[2] = edge_n2D2;
+        // B1's nbr n2->B2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B1].nbr[i] == n2) {
+            treenodes[B1].nbr[i] = B2;
+            treenodes[B1].edge[i] = edge_B1B2;
+            break;
           }
-          // B2's nbr n2->B1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B2].nbr[i] == n2) {
-              treenodes[B2].nbr[i] = B1;
-              treenodes[B2].edge[i] = edge_B1B2;
-              break;
-            }
+        }
+        // B2's nbr n2->B1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B2].nbr[i] == n2) {
+            treenodes[B2].nbr[i] = B1;
+            treenodes[B2].edge[i] = edge_B1B2;
+            break;
           }
-          // D1's nbr D2->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D1].nbr[i] == D2) {
-              treenodes[D1].nbr[i] = n2;
-              treenodes[D1].edge[i] = edge_n2D1;
-              break;
-            }
+        }
+        // D1's nbr D2->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D1].nbr[i] == D2) {
+            treenodes[D1].nbr[i] = n2;
+            treenodes[D1].edge[i] = edge_n2D1;
+            break;
           }
-          // D2's nbr D1->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D2].nbr[i] == D1) {
-              treenodes[D2].nbr[i] = n2;
-              treenodes[D2].edge[i] = edge_n2D2;
-              break;
-            }
+        }
+        // D2's nbr D1->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D2].nbr[i] == D1) {
+            treenodes[D2].nbr[i] = n2;
+            treenodes[D2].edge[i] = edge_n2D2;
+            break;
           }
-        }     // else E2 is not on (n2, B1) or (n2, B2), but on (d1_3D,
-              // d2_3D)
-      } else  // n2 is not a pin and E2!=n2
-      {
-        newUpdateNodeLayers(treenodes, edge_n1n2, n2a, lastL);
-      }
+        }
+      }     // else E2 is not on (n2, B1) or (n2, B2), but on (d1_3D,
+            // d2_3D)
+    } else  // n2 is not a pin and E2!=n2
+    {
+      newUpdateNodeLayers(treenodes, edge_n1n2, n2a, lastL);
+    }
 
-      const int newcnt_n1n2 = tailRoom - headRoom + 1;
+    const int newcnt_n1n2 = tailRoom - headRoom + 1;
 
-      // update route for edge (n1, n2) and edge usage
-      if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
-        treeedges[edge_n1n2].route.gridsX.clear();
-        treeedges[edge_n1n2].route.gridsY.clear();
-        treeedges[edge_n1n2].route.gridsL.clear();
-      }
+    // update route for edge (n1, n2) and edge usage
+    if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
+      treeedges[edge_n1n2].route.gridsX.clear();
+      treeedges[edge_n1n2].route.gridsY.clear();
+      treeedges[edge_n1n2].route.gridsL.clear();
+    }
 
-      // avoid resizing vector with negative value.
-      // this may happen when all elements of gridsX and gridsY are the
-      // same.
-      if (newcnt_n1n2 > 0) {
-        treeedges[edge_n1n2].route.gridsX.resize(newcnt_n1n2, 0);
-        treeedges[edge_n1n2].route.gridsY.resize(newcnt_n1n2, 0);
-        treeedges[edge_n1n2].route.gridsL.resize(newcnt_n1n2, 0);
-      }
-      treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
-      treeedges[edge_n1n2].route.routelen = newcnt_n1n2 - 1;
-      treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
-
-      int j = headRoom;
-      for (int i = 0; i < newcnt_n1n2; i++) {
-        treeedges[edge_n1n2].route.gridsX[i] = gridsX[j];
-        treeedges[edge_n1n2].route.gridsY[i] = gridsY[j];
-        treeedges[edge_n1n2].route.gridsL[i] = gridsL[j];
-        j++;
-      }
+    // avoid resizing vector with negative value.
+    // this may happen when all elements of gridsX and gridsY are the
+    // same.
+    if (newcnt_n1n2 > 0) {
+      treeedges[edge_n1n2].route.gridsX.resize(newcnt_n1n2, 0);
+      treeedges[edge_n1n2].route.gridsY.resize(newcnt_n1n2, 0);
+      treeedges[edge_n1n2].route.gridsL.resize(newcnt_n1n2, 0);
+    }
+    treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
+    treeedges[edge_n1n2].route.routelen = newcnt_n1n2 - 1;
+    treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
+
+    int j = headRoom;
+    for (int i = 0; i < newcnt_n1n2; i++) {
+      treeedges[edge_n1n2].route.gridsX[i] = gridsX[j];
+      treeedges[edge_n1n2].route.gridsY[i] = gridsY[j];
+      treeedges[edge_n1n2].route.gridsL[i] = gridsL[j];
+      j++;
+    }
 
-      // update edge usage
-      for (int i = headRoom; i < tailRoom; i++) {
-        if (gridsL[i] == gridsL[i + 1]) {
-          if (gridsX[i] == gridsX[i + 1])  // a vertical edge
-          {
-            const int min_y = std::min(gridsY[i], gridsY[i + 1]);
-            v_edges_[min_y][gridsX[i]].usage += net->getEdgeCost();
-            v_used_ggrid_.insert(std::make_pair(min_y, gridsX[i]));
-            v_edges_3D_[gridsL[i]][min_y][gridsX[i]].usage
-                += net->getLayerEdgeCost(gridsL[i]);
-          } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
-          {
-            const int min_x = std::min(gridsX[i], gridsX[i + 1]);
-            h_edges_[gridsY[i]][min_x].usage += net->getEdgeCost();
-            h_used_ggrid_.insert(std::make_pair(gridsY[i], min_x));
-            h_edges_3D_[gridsL[i]][gridsY[i]][min_x].usage
-                += net->getLayerEdgeCost(gridsL[i]);
-          }
+    // update edge usage
+    for (int i = headRoom; i < tailRoom; i++) {
+      if (gridsL[i] == gridsL[i + 1]) {
+        if (gridsX[i] == gridsX[i + 1])  // a vertical edge
+        {
+          const int min_y = std::min(gridsY[i], gridsY[i + 1]);
+          v_edges_[min_y][gridsX[i]].usage += net->getEdgeCost();
+          scratch.v_used_ggrid.insert(std::make_pair(min_y, gridsX[i]));
+          v_edges_3D_[gridsL[i]][min_y][gridsX[i]].usage
+              += net->getLayerEdgeCost(gridsL[i]);
+        } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
+        {
+          const int min_x = std::min(gridsX[i], gridsX[i + 1]);
+          h_edges_[gridsY[i]][min_x].usage += net->getEdgeCost();
+          scratch.h_used_ggrid.insert(std::make_pair(gridsY[i], min_x));
+          h_edges_3D_[gridsL[i]][gridsY[i]][min_x].usage
+              += net->getLayerEdgeCost(gridsL[i]);
         }
       }
+    }
 
-      if (!n1Shift && !n2Shift) {
-        continue;
+    if (!n1Shift && !n2Shift) {
+      continue;
+    }
+    setTreeNodesVariables(netID);
+  }
+}
+
+// Sizes the 3D maze buffers for the current grid. They are only reallocated
+// when the grid or the number of threads changes. The heaps grow with the
+// routing regions of the edges each thread routes.
+void FastRouteCore::initMazeScratches3D(const int num_scratches)
+{
+  if (d1_3D_.shape()[0] != num_layers_ || d1_3D_.shape()[1] != y_range_
+      || d1_3D_.shape()[2] != x_range_) {
+    directions_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
+    corr_edge_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
+    pr_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
+    d1_3D_.resize(boost::extents[num_layers_][y_range_][x_range_]);
+    d2_3D_.resize(boost::extents[num_layers_][y_range_][x_range_]);
+  }
+
+  maze_scratches_3D_.resize(num_scratches);
+  const int64 grid_count
+      = static_cast<int64>(num_layers_) * y_range_ * x_range_;
+  for (MazeScratch3D& scratch : maze_scratches_3D_) {
+    if (scratch.d1_generation.size() != grid_count) {
+      scratch.pop_heap2.assign(grid_count, false);
+      scratch.d1_generation.assign(grid_count, 0);
+      scratch.generation = 0;
+    }
+  }
+}
+
+void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
+                                         int ripupTHlb,
+                                         int ripupTHub)
+{
+  const int num_scratches = parallel_maze_ ? std::max(num_threads_, 1) : 1;
+  initMazeScratches3D(num_scratches);
+  std::vector<MazeScratch3D>& scratches = maze_scratches_3D_;
+
+  const int endIND = tree_order_pv_.size() * 0.9;
+  std::vector<int> net_order(endIND);
+  for (int orderIndex = 0; orderIndex < endIND; orderIndex++) {
+    net_order[orderIndex] = tree_order_pv_[orderIndex].treeIndex;
+  }
+
+  const auto routeNet = [&](const int netID,
+                            MazeScratch3D& scratch,
+                            const odb::Rect* footprint) {
+    mazeRouteMSMDOrder3DNet(netID,
+                            expand,
+                            ripupTHlb,
+                            ripupTHub,
+                            directions_3D_,
+                            corr_edge_3D_,
+                            pr_3D_,
+                            d1_3D_,
+                            d2_3D_,
+                            scratch,
+                            footprint);
+  };
+
+  if (!parallel_maze_) {
+    for (const int netID : net_order) {
+      routeNet(netID, scratches[0], nullptr);
+    }
+  } else {
+    // The search arrays are shared: the routing regions of a net are kept
+    // inside its footprint, so nets of a batch never touch the same grids.
+    std::vector<odb::Rect> footprints;
+    for (const std::vector<int>& batch :
+         mazeRouteBatches(net_order, expand, footprints)) {
+      const int batch_size = batch.size();
+      utl::ThreadException exception;
+#pragma omp parallel for num_threads(num_scratches) schedule(dynamic)
+      for (int i = 0; i < batch_size; i++) {
+        try {
+          routeNet(batch[i],
+                   scratches[omp_get_thread_num()],
+                   &footprints[batch[i]]);
+        } catch (...) {
+          exception.capture();
+        }
       }
-      setTreeNodesVariables(netID);
+      exception.rethrow();
     }
   }
+
+  for (MazeScratch3D& scratch : scratches) {
+    h_used_ggrid_.insert(scratch.h_used_ggrid.begin(),
+                         scratch.h_used_ggrid.end());
+    v_used_ggrid_.insert(scratch.v_used_ggrid.begin(),
+                         scratch.v_used_ggrid.end());
+    scratch.h_used_ggrid.clear();
+    scratch.v_used_ggrid.clear();
+  }
 }
 
 }  // namespace grt
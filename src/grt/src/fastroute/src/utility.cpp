@@ -30,6 +30,8 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
 #include <fstream>
 #include <queue>
@@ -38,6 +40,7 @@
 #include "FastRoute.h"
 #include "odb/db.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
@@ -832,20 +835,12 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
 
 void FastRouteCore::layerAssignmentV4()
 {
-  int i, k, edgeID, nodeID, routeLen;
-  int n1, n2, connectionCNT;
-
-  int n1a, n2a;
-  std::queue<int> edgeQueue;
-
-  TreeEdge* treeedge;
-
   for (const int& netID : net_ids_) {
     auto& treeedges = sttrees_[netID].edges;
-    for (edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
-      treeedge = &(treeedges[edgeID]);
+    for (int edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
+      TreeEdge* treeedge = &(treeedges[edgeID]);
       if (treeedge->len > 0) {
-        routeLen = treeedge->route.routelen;
+        const int routeLen = treeedge->route.routelen;
         treeedge->route.gridsL.resize(routeLen + 1, 0);
         treeedge->assigned = false;
       }
@@ -853,119 +848,157 @@ void FastRouteCore::layerAssignmentV4()
   }
   netpinOrderInc();
 
-  for (i = 0; i < tree_order_pv_.size(); i++) {
-    int netID = tree_order_pv_[i].treeIndex;
+  std::vector<int> net_order(tree_order_pv_.size());
+  for (int i = 0; i < tree_order_pv_.size(); i++) {
+    net_order[i] = tree_order_pv_[i].treeIndex;
+  }
 
-    auto& treeedges = sttrees_[netID].edges;
-    auto& treenodes = sttrees_[netID].nodes;
-    const int num_terminals = sttrees_[netID].num_terminals;
+  if (!parallel_maze_) {
+    for (const int netID : net_order) {
+      layerAssignmentV4Net(netID);
+    }
+    return;
+  }
 
-    for (nodeID = 0; nodeID < num_terminals; nodeID++) {
-      for (k = 0; k < treenodes[nodeID].conCNT; k++) {
-        edgeID = treenodes[nodeID].eID[k];
-        if (!treeedges[edgeID].assigned) {
-          edgeQueue.push(edgeID);
-          treeedges[edgeID].assigned = true;
-        }
+  // A net only changes the 3D usage of the edges along its routes, so nets
+  // with disjoint route bounding boxes are assigned concurrently.
+  std::vector<odb::Rect> footprints;
+  for (const std::vector<int>& batch :
+       mazeRouteBatches(net_order, 0, footprints)) {
+    const int batch_size = batch.size();
+    utl::ThreadException exception;
+#pragma omp parallel for num_threads(std::max(num_threads_, 1)) \
+    schedule(dynamic)
+    for (int i = 0; i < batch_size; i++) {
+      try {
+        layerAssignmentV4Net(batch[i]);
+      } catch (...) {
+        exception.capture();
       }
     }
+    exception.rethrow();
+  }
+}
 
-    while (!edgeQueue.empty()) {
-      edgeID = edgeQueue.front();
-      edgeQueue.pop();
-      treeedge = &(treeedges[edgeID]);
-      if (treenodes[treeedge->n1a].assigned) {
-        assignEdge(netID, edgeID, 1);
-        treeedge->assigned = true;
-        if (!treenodes[treeedge->n2a].assigned) {
-          for (k = 0; k < treenodes[treeedge->n2a].conCNT; k++) {
-            edgeID = treenodes[treeedge->n2a].eID[k];
-            if (!treeedges[edgeID].assigned) {
-              edgeQueue.push(edgeID);
-              treeedges[edgeID].assigned = true;
-            }
+void FastRouteCore::layerAssignmentV4Net(const int netID)
+{
+  int k, edgeID, nodeID, routeLen;
+  int n1, n2, connectionCNT;
+
+  int n1a, n2a;
+  std::queue<int> edgeQueue;
+
+  TreeEdge* treeedge;
+
+  auto& treeedges = sttrees_[netID].edges;
+  auto& treenodes = sttrees_[netID].nodes;
+  const int num_terminals = sttrees_[netID].num_terminals;
+
+  for (nodeID = 0; nodeID < num_terminals; nodeID++) {
+    for (k = 0; k < treenodes[nodeID].conCNT; k++) {
+      edgeID = treenodes[nodeID].eID[k];
+      if (!treeedges[edgeID].assigned) {
+        edgeQueue.push(edgeID);
+        treeedges[edgeID].assigned = true;
+      }
+    }
+  }
+
+  while (!edgeQueue.empty()) {
+    edgeID = edgeQueue.front();
+    edgeQueue.pop();
+    treeedge = &(treeedges[edgeID]);
+    if (treenodes[treeedge->n1a].assigned) {
+      assignEdge(netID, edgeID, 1);
+      treeedge->assigned = true;
+      if (!treenodes[treeedge->n2a].assigned) {
+        for (k = 0; k < treenodes[treeedge->n2a].conCNT; k++) {
+          edgeID = treenodes[treeedge->n2a].eID[k];
+          if (!treeedges[edgeID].assigned) {
+            edgeQueue.push(edgeID);
+            treeedges[edgeID].assigned = true;
           }
-          treenodes[treeedge->n2a].assigned = true;
         }
-      } else {
-        assignEdge(netID, edgeID, 0);
-        treeedge->assigned = true;
-        if (!treenodes[treeedge->n1a].assigned) {
-          for (k = 0; k < treenodes[treeedge->n1a].conCNT; k++) {
-            edgeID = treenodes[treeedge->n1a].eID[k];
-            if (!treeedges[edgeID].assigned) {
-              edgeQueue.push(edgeID);
-              treeedges[edgeID].assigned = true;
-            }
+        treenodes[treeedge->n2a].assigned = true;
+      }
+    } else {
+      assignEdge(netID, edgeID, 0);
+      treeedge->assigned = true;
+      if (!treenodes[treeedge->n1a].assigned) {
+        for (k = 0; k < treenodes[treeedge->n1a].conCNT; k++) {
+          edgeID = treenodes[treeedge->n1a].eID[k];
+          if (!treeedges[edgeID].assigned) {
+            edgeQueue.push(edgeID);
+            treeedges[edgeID].assigned = true;
           }
-          treenodes[treeedge->n1a].assigned = true;
         }
+        treenodes[treeedge->n1a].assigned = true;
       }
     }
+  }
 
-    for (nodeID = 0; nodeID < sttrees_[netID].num_nodes(); nodeID++) {
-      treenodes[nodeID].topL = -1;
-      treenodes[nodeID].botL = num_layers_;
-      treenodes[nodeID].conCNT = 0;
-      treenodes[nodeID].hID = BIG_INT;
-      treenodes[nodeID].lID = BIG_INT;
-      treenodes[nodeID].status = 0;
-      treenodes[nodeID].assigned = false;
+  for (nodeID = 0; nodeID < sttrees_[netID].num_nodes(); nodeID++) {
+    treenodes[nodeID].topL = -1;
+    treenodes[nodeID].botL = num_layers_;
+    treenodes[nodeID].conCNT = 0;
+    treenodes[nodeID].hID = BIG_INT;
+    treenodes[nodeID].lID = BIG_INT;
+    treenodes[nodeID].status = 0;
+    treenodes[nodeID].assigned = false;
 
-      if (nodeID < num_terminals) {
-        treenodes[nodeID].botL = nets_[netID]->getPinL()[nodeID];
-        treenodes[nodeID].topL = nets_[netID]->getPinL()[nodeID];
-        treenodes[nodeID].assigned = true;
-        treenodes[nodeID].status = 1;
-      }
+    if (nodeID < num_terminals) {
+      treenodes[nodeID].botL = nets_[netID]->getPinL()[nodeID];
+      treenodes[nodeID].topL = nets_[netID]->getPinL()[nodeID];
+      treenodes[nodeID].assigned = true;
+      treenodes[nodeID].status = 1;
     }
+  }
 
-    for (edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
-      treeedge = &(treeedges[edgeID]);
+  for (edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
+    treeedge = &(treeedges[edgeID]);
 
-      if (treeedge->len > 0) {
-        routeLen = treeedge->route.routelen;
+    if (treeedge->len > 0) {
+      routeLen = treeedge->route.routelen;
 
-        n1 = treeedge->n1;
-        n2 = treeedge->n2;
-        const std::vector<short>& gridsL = treeedge->route.gridsL;
+      n1 = treeedge->n1;
+      n2 = treeedge->n2;
+      const std::vector<short>& gridsL = treeedge->route.gridsL;
 
-        n1a = treenodes[n1].stackAlias;
-        n2a = treenodes[n2].stackAlias;
-        connectionCNT = treenodes[n1a].conCNT;
-        treenodes[n1a].heights[connectionCNT] = gridsL[0];
-        treenodes[n1a].eID[connectionCNT] = edgeID;
-        treenodes[n1a].conCNT++;
+      n1a = treenodes[n1].stackAlias;
+      n2a = treenodes[n2].stackAlias;
+      connectionCNT = treenodes[n1a].conCNT;
+      treenodes[n1a].heights[connectionCNT] = gridsL[0];
+      treenodes[n1a].eID[connectionCNT] = edgeID;
+      treenodes[n1a].conCNT++;
 
-        if (gridsL[0] > treenodes[n1a].topL) {
-          treenodes[n1a].hID = edgeID;
-          treenodes[n1a].topL = gridsL[0];
-        }
-        if (gridsL[0] < treenodes[n1a].botL) {
-          treenodes[n1a].lID = edgeID;
-          treenodes[n1a].botL = gridsL[0];
-        }
+      if (gridsL[0] > treenodes[n1a].topL) {
+        treenodes[n1a].hID = edgeID;
+        treenodes[n1a].topL = gridsL[0];
+      }
+      if (gridsL[0] < treenodes[n1a].botL) {
+        treenodes[n1a].lID = edgeID;
+        treenodes[n1a].botL = gridsL[0];
+      }
 
-        treenodes[n1a].assigned = true;
+      treenodes[n1a].assigned = true;
 
-        connectionCNT = treenodes[n2a].conCNT;
-        treenodes[n2a].heights[connectionCNT] = gridsL[routeLen];
-        treenodes[n2a].eID[connectionCNT] = edgeID;
-        treenodes[n2a].conCNT++;
-        if (gridsL[routeLen] > treenodes[n2a].topL) {
-          treenodes[n2a].hID = edgeID;
-          treenodes[n2a].topL = gridsL[routeLen];
-        }
-        if (gridsL[routeLen] < treenodes[n2a].botL) {
-          treenodes[n2a].lID = edgeID;
-          treenodes[n2a].botL = gridsL[routeLen];
-        }
+      connectionCNT = treenodes[n2a].conCNT;
+      treenodes[n2a].heights[connectionCNT] = gridsL[routeLen];
+      treenodes[n2a].eID[connectionCNT] = edgeID;
+      treenodes[n2a].conCNT++;
+      if (gridsL[routeLen] > treenodes[n2a].topL) {
+        treenodes[n2a].hID = edgeID;
+        treenodes[n2a].topL = gridsL[routeLen];
+      }
+      if (gridsL[routeLen] < treenodes[n2a].botL) {
+        treenodes[n2a].lID = edgeID;
+        treenodes[n2a].botL = gridsL[routeLen];
+      }
 
-        treenodes[n2a].assigned = true;
+      treenodes[n2a].assigned = true;
 
-      }  // edge len > 0
-    }    // eunmerating edges
-  }
+    }  // edge len > 0
+  }    // eunmerating edges
 }
 
 void FastRouteCore::layerAssignment()
@@ -1317,7 +1350,10 @@ float FastRouteCore::CalculatePartialSlack()
   return slack_th;
 }
 
-void FastRouteCore::recoverEdge(int netID, int edgeID)
+void FastRouteCore::recoverEdge(int netID,
+                                int edgeID,
+                                std::set<std::pair<int, int>>& h_used_ggrid,
+                                std::set<std::pair<int, int>>& v_used_ggrid)
 {
   int i, ymin, xmin, n1a, n2a;
   int connectionCNT, routeLen;
@@ -1378,14 +1414,14 @@ void FastRouteCore::recoverEdge(int netID, int edgeID)
       {
         ymin = std::min(gridsY[i], gridsY[i + 1]);
         v_edges_[ymin][gridsX[i]].usage += net->getEdgeCost();
-        v_used_ggrid_.insert(std::make_pair(ymin, gridsX[i]));
+        v_used_ggrid.insert(std::make_pair(ymin, gridsX[i]));
         v_edges_3D_[gridsL[i]][ymin][gridsX[i]].usage
             += net->getLayerEdgeCost(gridsL[i]);
       } else if (gridsY[i] == gridsY[i + 1])  // a horizontal edge
       {
         xmin = std::min(gridsX[i], gridsX[i + 1]);
         h_edges_[gridsY[i]][xmin].usage += net->getEdgeCost();
-        h_used_ggrid_.insert(std::make_pair(gridsY[i], xmin));
+        h_used_ggrid.insert(std::make_pair(gridsY[i], xmin));
         h_edges_3D_[gridsL[i]][gridsY[i]][xmin].usage
             += net->getLayerEdgeCost(gridsL[i]);
       }
@@ -1669,20 +1705,21 @@ static bool compareEdgeLen(const OrderNetEdge a, const OrderNetEdge b)
   return a.length > b.length;
 }
 
-void FastRouteCore::netedgeOrderDec(int netID)
+void FastRouteCore::netedgeOrderDec(int netID,
+                                    std::vector<OrderNetEdge>& net_eo)
 {
   const int numTreeedges = sttrees_[netID].num_edges();
 
-  net_eo_.clear();
+  net_eo.clear();
 
   for (int j = 0; j < numTreeedges; j++) {
     OrderNetEdge orderNet;
     orderNet.length = sttrees_[netID].edges[j].route.routelen;
     orderNet.edgeID = j;
-    net_eo_.push_back(orderNet);
+    net_eo.push_back(orderNet);
   }
 
-  std::stable_sort(net_eo_.begin(), net_eo_.end(), compareEdgeLen);
+  std::stable_sort(net_eo.begin(), net_eo.end(), compareEdgeLen);
 }
 
 void FastRouteCore::printEdge2D(int netID, int edgeID)
@@ -2684,6 +2721,11 @@ void FastRouteCore::setTreeNodesVariables(const int netID)
   auto& treeedges = sttrees_[netID].edges;
   auto& treenodes = sttrees_[netID].nodes;
 
+  // Local buffers, as the 3D maze router updates trees from several threads
+  std::vector<int> xcor(treenodes.size());
+  std::vector<int> ycor(treenodes.size());
+  std::vector<int> dcor(treenodes.size());
+
   int routeLen;
   TreeEdge* treeedge;
   // Setting the values needed for each TreeNode
@@ -2703,23 +2745,23 @@ void FastRouteCore::setTreeNodesVariables(const int netID)
       treenodes[d].assigned = true;
       treenodes[d].status = 1;
 
-      xcor_[numpoints] = treenodes[d].x;
-      ycor_[numpoints] = treenodes[d].y;
-      dcor_[numpoints] = d;
+      xcor[numpoints] = treenodes[d].x;
+      ycor[numpoints] = treenodes[d].y;
+      dcor[numpoints] = d;
       numpoints++;
     } else {
       bool redundant = false;
       for (int k = 0; k < numpoints; k++) {
-        if ((treenodes[d].x == xcor_[k]) && (treenodes[d].y == ycor_[k])) {
-          treenodes[d].stackAlias = dcor_[k];
+        if ((treenodes[d].x == xcor[k]) && (treenodes[d].y == ycor[k])) {
+          treenodes[d].stackAlias = dcor[k];
           redundant = true;
           break;
         }
       }
       if (!redundant) {
-        xcor_[numpoints] = treenodes[d].x;
-        ycor_[numpoints] = treenodes[d].y;
-        dcor_[numpoints] = d;
+        xcor[numpoints] = treenodes[d].x;
+        ycor[numpoints] = treenodes[d].y;
+        dcor[numpoints] = d;
         numpoints++;
       }
     }
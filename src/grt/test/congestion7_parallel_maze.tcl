@@ -0,0 +1,28 @@
+# global_route -parallel_maze congestion iterations on 1 and 4 threads
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+set_global_routing_layer_adjustment metal2 0.9
+set_global_routing_layer_adjustment metal3 0.9
+set_global_routing_layer_adjustment metal4-metal10 1
+
+set_routing_layers -signal metal2-metal10
+
+set guide_file1 [make_result_file congestion7_parallel_maze1.guide]
+set_thread_count 1
+global_route -allow_congestion -parallel_maze
+write_guides $guide_file1
+
+set guide_file4 [make_result_file congestion7_parallel_maze4.guide]
+set_thread_count 4
+global_route -allow_congestion -parallel_maze
+write_guides $guide_file4
+
+if { [diff_files $guide_file1 $guide_file4] } {
+  puts "FAIL: guides differ between 1 and 4 threads"
+  exit 1
+}
+
+puts "pass"
+exit 0
@@ -0,0 +1,67 @@
+# global_route -start_incremental/-end_incremental reroutes only moved nets
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+set_routing_layers -signal metal2-metal10
+
+proc net_guides { net } {
+  set guides {}
+  foreach guide [$net getGuides] {
+    set box [$guide getBox]
+    lappend guides [list [[$guide getLayer] getName] \
+                      [$box xMin] [$box yMin] [$box xMax] [$box yMax]]
+  }
+  return [lsort $guides]
+}
+
+global_route
+
+set block [ord::get_db_block]
+foreach net [$block getNets] {
+  set before([$net getName]) [net_guides $net]
+}
+
+global_route -start_incremental
+set inst [$block findInst "_450_"]
+$inst setLocation 140000 60000
+global_route -end_incremental
+
+set moved_nets {}
+foreach iterm [$inst getITerms] {
+  set net [$iterm getNet]
+  if { $net != "NULL" && ![$net isSpecial] } {
+    lappend moved_nets [$net getName]
+  }
+}
+
+set bbox [$inst getBBox]
+foreach name $moved_nets {
+  set reached 0
+  foreach guide [net_guides [$block findNet $name]] {
+    lassign $guide layer x1 y1 x2 y2
+    if { $x1 <= [$bbox xMax] && $x2 >= [$bbox xMin]
+         && $y1 <= [$bbox yMax] && $y2 >= [$bbox yMin] } {
+      set reached 1
+      break
+    }
+  }
+  if { !$reached } {
+    puts "FAIL: net $name was not rerouted to the moved instance"
+    exit 1
+  }
+}
+
+foreach net [$block getNets] {
+  set name [$net getName]
+  if { [lsearch -exact $moved_nets $name] != -1 } {
+    continue
+  }
+  if { [net_guides $net] != $before($name) } {
+    puts "FAIL: untouched net $name changed its guides"
+    exit 1
+  }
+}
+
+puts "pass"
+exit 0
@@ -73,3 +73,9 @@ record_tests {
   #grt_man_tcl_check
   #grt_readme_msgs_check
 }
+
+record_pass_fail_tests {
+  congestion7_parallel_maze
+  gcd_parallel_maze
+  incremental1
+}
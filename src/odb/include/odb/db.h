@@ -390,15 +390,31 @@ class dbDatabase : public dbObject
   ///
   /// Read a database from this stream.
   /// WARNING: This function destroys the data currently in the database.
+  /// Compressed sections are decoded on up to threads threads.
   /// Throws ZIOError..
   ///
-  void read(std::istream& f);
+  void read(std::istream& f, int threads = 1);
+
+  ///
+  /// Read a database from an in-memory image of a db file, such as a
+  /// memory mapped file. Arithmetic arrays are copied in bulk.
+  /// If defer_tables is true the wires, fills and parasitics of the blocks
+  /// are only decoded when first accessed. The data is copied so it does
+  /// not need to outlive this call.
+  /// WARNING: This function destroys the data currently in the database.
+  /// Throws std::ios_base::failure if the data ends early.
+  ///
+  void read(const char* data,
+            size_t size,
+            int threads = 1,
+            bool defer_tables = false);
 
   ///
   /// Write a database to this stream.
+  /// Compressed sections are encoded on up to threads threads.
   /// Throws ZIOError..
   ///
-  void write(std::ostream& file);
+  void write(std::ostream& file, int threads = 1);
 
   ///
   /// ECO - The following methods implement a simple ECO mechanism for capturing
@@ -38,6 +38,7 @@
 #include <istream>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <variant>
 
@@ -67,6 +68,7 @@ class dbOStream
   std::ostream& _f;
   double _lef_area_factor;
   double _lef_dist_factor;
+  int _threads = 1;
   std::vector<Scope> _scopes;
 
   // By default values are written as their string ("255" vs 0xFF)
@@ -270,6 +272,12 @@ class dbOStream
 
   Position pos() const { return _f.tellp(); }
 
+  void write(const char* c, size_t size) { _f.write(c, size); }
+
+  // Number of threads used to encode independent sections of the stream.
+  void setThreads(int threads) { _threads = threads; }
+  int getThreads() const { return _threads; }
+
   void pushScope(const std::string& name);
   void popScope();
 };
@@ -291,13 +299,19 @@ class dbOStreamScope
 
 class dbIStream
 {
-  std::istream& _f;
+  std::istream* _f = nullptr;
+  // Memory input used instead of _f when reading from a mapped file.
+  const char* _data = nullptr;
+  const char* _data_end = nullptr;
   _dbDatabase* _db;
   double _lef_area_factor;
   double _lef_dist_factor;
+  int _threads = 1;
+  bool _defer_sections = false;
 
  public:
   dbIStream(_dbDatabase* db, std::istream& f);
+  dbIStream(_dbDatabase* db, const char* data, size_t size);
 
   _dbDatabase* getDatabase() { return _db; }
 
@@ -311,67 +325,67 @@ class dbIStream
 
   dbIStream& operator>>(char& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(unsigned char& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(int16_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(uint16_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(int& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(uint64_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(unsigned int& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(int8_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(float& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(double& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(long double& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    read(&c, sizeof(c));
     return *this;
   }
 
@@ -384,7 +398,7 @@ class dbIStream
       c = nullptr;
     } else {
       c = (char*) malloc(l);
-      _f.read(reinterpret_cast<char*>(c), l);
+      read(c, l);
     }
 
     return *this;
@@ -392,7 +406,7 @@ class dbIStream
 
   dbIStream& operator>>(dbObjectType& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    read(&c, sizeof(c));
     return *this;
   }
 
@@ -437,11 +451,18 @@ class dbIStream
   {
     uint sz;
     *this >> sz;
-    m.reserve(sz);
-    for (uint i = 0; i < sz; i++) {
-      T1 val;
-      *this >> val;
-      m.push_back(val);
+    if constexpr (isBulkReadable<T1>()) {
+      // Elements are stored as their raw bytes so copy them in one go.
+      const size_t offset = m.size();
+      m.resize(offset + sz);
+      read(m.data() + offset, sz * sizeof(T1));
+    } else {
+      m.reserve(sz);
+      for (uint i = 0; i < sz; i++) {
+        T1 val;
+        *this >> val;
+        m.push_back(val);
+      }
     }
     return *this;
   }
@@ -490,7 +511,41 @@ class dbIStream
 
   double lefdist(int value) { return ((double) value * _lef_dist_factor); }
 
+  // Arithmetic values are streamed as their raw bytes; bool is excluded
+  // since it is written as an unsigned char that must be decoded.
+  template <class T>
+  static constexpr bool isBulkReadable()
+  {
+    return std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+  }
+
+  void read(void* c, size_t size)
+  {
+    if (_f) {
+      _f->read(reinterpret_cast<char*>(c), size);
+      return;
+    }
+    if (size > static_cast<size_t>(_data_end - _data)) {
+      throw std::ios_base::failure("unexpected end of data");
+    }
+    std::memcpy(c, _data, size);
+    _data += size;
+  }
+
+  // Bytes left to read, or SIZE_MAX if the input can't tell.
+  size_t remaining();
+
+  // Number of threads used to decode independent sections of the stream.
+  void setThreads(int threads) { _threads = threads; }
+  int getThreads() const { return _threads; }
+
+  // Leave sections that support it undecoded until they are first used.
+  void setDeferSections(bool defer) { _defer_sections = defer; }
+  bool getDeferSections() const { return _defer_sections; }
+
  private:
+  void initLefFactors(_dbDatabase* db);
+
   template <uint32_t I = 0, typename... Ts>
   dbIStream& variantHelper(uint32_t index, std::variant<Ts...>& v)
   {
@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
 #include "odb.h"
@@ -73,6 +74,10 @@ class defin
   void namesAreDBIDs();
   void setAssemblyMode();
   void useBlockName(const char* name);
+  /// Parse the NETS section of large DEF files on this many threads.
+  void setThreads(int threads);
+  /// Smallest NETS section parsed on threads, in bytes. For testing.
+  static void setParallelNetsMinBytes(size_t bytes);
 
   /// Create a new chip
   dbChip* createChip(std::vector<dbLib*>& search_libs,
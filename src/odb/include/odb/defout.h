@@ -65,7 +65,12 @@ class defout
   void setUseMasterIds(bool value);
   void selectNet(dbNet* net);
   void setVersion(Version v);  // default is 5.8
+  // Format COMPONENTS, SPECIALNETS and NETS on this many threads.
+  void setThreads(int threads);
+  // Objects formatted per chunk on each thread. For testing.
+  static void setChunkSize(size_t objects);
 
+  // Writes gzip compressed DEF when def_file ends in .gz.
   bool writeBlock(dbBlock* block, const char* def_file);
 };
 
@@ -36,9 +36,12 @@
 #include <unistd.h>
 
 #include <fstream>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "dbAccessPoint.h"
 #include "dbArrayTable.h"
@@ -115,6 +118,7 @@
 #include "dbSBoxItr.h"
 #include "dbSWire.h"
 #include "dbSWireItr.h"
+#include "dbSection.h"
 #include "dbTable.h"
 #include "dbTable.hpp"
 #include "dbTech.h"
@@ -666,11 +670,11 @@ _dbBlock::~_dbBlock()
   delete _track_grid_tbl;
   delete _obstruction_tbl;
   delete _blockage_tbl;
-  delete _wire_tbl;
+  delete _wire_tbl.release();
   delete _swire_tbl;
   delete _sbox_tbl;
   delete _row_tbl;
-  delete _fill_tbl;
+  delete _fill_tbl.release();
   delete _region_tbl;
   delete _hier_tbl;
   delete _bpin_tbl;
@@ -678,12 +682,12 @@ _dbBlock::~_dbBlock()
   delete _layer_rule_tbl;
   delete _prop_tbl;
   delete _name_cache;
-  delete _r_val_tbl;
-  delete _c_val_tbl;
-  delete _cc_val_tbl;
-  delete _cap_node_tbl;
-  delete _r_seg_tbl;
-  delete _cc_seg_tbl;
+  delete _r_val_tbl.release();
+  delete _c_val_tbl.release();
+  delete _cc_val_tbl.release();
+  delete _cap_node_tbl.release();
+  delete _r_seg_tbl.release();
+  delete _cc_seg_tbl.release();
   delete _extControl;
   delete _net_bterm_itr;
   delete _net_iterm_itr;
@@ -988,11 +992,38 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   stream << block._component_mask_shift;
   stream << block._currentCcAdjOrder;
 
-  stream << *block._bterm_tbl;
-  stream << *block._iterm_tbl;
-  stream << *block._net_tbl;
+  // The large tables are written as compressed sections in parallel
+  writeSections(
+      stream,
+      {[&](dbOStream& s) { s << NamedTable("bterm_tbl", block._bterm_tbl); },
+       [&](dbOStream& s) { s << NamedTable("iterm_tbl", block._iterm_tbl); },
+       [&](dbOStream& s) { s << NamedTable("net_tbl", block._net_tbl); },
+       [&](dbOStream& s) { s << NamedTable("inst_tbl", block._inst_tbl); },
+       [&](dbOStream& s) { s << NamedTable("box_tbl", block._box_tbl); },
+       [&](dbOStream& s) {
+         s << NamedTable("wire_tbl", block._wire_tbl.get());
+       },
+       [&](dbOStream& s) { s << NamedTable("swire_tbl", block._swire_tbl); },
+       [&](dbOStream& s) { s << NamedTable("sbox_tbl", block._sbox_tbl); },
+       [&](dbOStream& s) {
+         s << *block._r_val_tbl;
+         s << *block._c_val_tbl;
+         s << *block._cc_val_tbl;
+       },
+       [&](dbOStream& s) {
+         s << NamedTable("cap_node_tbl", block._cap_node_tbl.get());
+       },
+       [&](dbOStream& s) {
+         s << NamedTable("r_seg_tbl", block._r_seg_tbl.get());
+       },
+       [&](dbOStream& s) {
+         s << NamedTable("cc_seg_tbl", block._cc_seg_tbl.get());
+       },
+       [&](dbOStream& s) {
+         s << NamedTable("fill_tbl", block._fill_tbl.get());
+       }});
+
   stream << *block._inst_hdr_tbl;
-  stream << *block._inst_tbl;
   stream << *block._module_tbl;
   stream << *block._modinst_tbl;
   if (db->isSchema(db_schema_update_hierarchy)) {
@@ -1010,17 +1041,12 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   stream << *block.global_connect_tbl_;
   stream << *block._guide_tbl;
   stream << *block._net_tracks_tbl;
-  stream << *block._box_tbl;
   stream << *block._via_tbl;
   stream << *block._gcell_grid_tbl;
   stream << *block._track_grid_tbl;
   stream << *block._obstruction_tbl;
   stream << *block._blockage_tbl;
-  stream << *block._wire_tbl;
-  stream << *block._swire_tbl;
-  stream << *block._sbox_tbl;
   stream << *block._row_tbl;
-  stream << *block._fill_tbl;
   stream << *block._region_tbl;
   stream << *block._hier_tbl;
   stream << *block._bpin_tbl;
@@ -1029,12 +1055,6 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   stream << *block._prop_tbl;
 
   stream << *block._name_cache;
-  stream << *block._r_val_tbl;
-  stream << *block._c_val_tbl;
-  stream << *block._cc_val_tbl;
-  stream << NamedTable("cap_node_tbl", block._cap_node_tbl);
-  stream << NamedTable("r_seg_tbl", block._r_seg_tbl);
-  stream << NamedTable("cc_seg_tbl", block._cc_seg_tbl);
   stream << *block._extControl;
   stream << block._dft;
   stream << *block._dft_tbl;
@@ -1056,6 +1076,73 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   return stream;
 }
 
+// The sections written by operator<<. Wires, fills and parasitics can be
+// left undecoded until first used when the stream defers sections.
+static void readBlockSections(dbIStream& stream, _dbBlock& block)
+{
+  _dbDatabase* db = block.getImpl()->getDatabase();
+
+  auto defer = [](auto& table) {
+    return [&table](std::function<void()> decode) {
+      table.setLoader(std::move(decode));
+    };
+  };
+
+  // The parasitic tables refer to one another so they are decoded together
+  // on the first access to any of them.
+  auto parasitics = std::make_shared<std::vector<std::function<void()>>>();
+  auto defer_parasitics = [parasitics](std::function<void()> decode) {
+    parasitics->push_back(std::move(decode));
+  };
+
+  std::vector<dbSectionReader> readers{
+      {[&](dbIStream& s) { s >> *block._bterm_tbl; }},
+      {[&](dbIStream& s) { s >> *block._iterm_tbl; }},
+      {[&](dbIStream& s) { s >> *block._net_tbl; }},
+      {[&](dbIStream& s) { s >> *block._inst_tbl; }},
+      {[&](dbIStream& s) { s >> *block._box_tbl; }},
+      {[&](dbIStream& s) { s >> *block._wire_tbl.unchecked(); },
+       defer(block._wire_tbl)},
+      {[&](dbIStream& s) { s >> *block._swire_tbl; }},
+      {[&](dbIStream& s) { s >> *block._sbox_tbl; }},
+      {[&](dbIStream& s) {
+         s >> *block._r_val_tbl.unchecked();
+         s >> *block._c_val_tbl.unchecked();
+         s >> *block._cc_val_tbl.unchecked();
+       },
+       defer_parasitics},
+      {[&](dbIStream& s) { s >> *block._cap_node_tbl.unchecked(); },
+       defer_parasitics},
+      {[&](dbIStream& s) { s >> *block._r_seg_tbl.unchecked(); },
+       defer_parasitics},
+      {[&](dbIStream& s) { s >> *block._cc_seg_tbl.unchecked(); },
+       defer_parasitics}};
+  if (db->isSchema(db_schema_fill_section)) {
+    readers.emplace_back(
+        [&](dbIStream& s) { s >> *block._fill_tbl.unchecked(); },
+        defer(block._fill_tbl));
+  }
+
+  readSections(stream, readers);
+
+  if (!parasitics->empty()) {
+    auto once = std::make_shared<std::once_flag>();
+    std::function<void()> load = [parasitics, once]() {
+      std::call_once(*once, [&]() {
+        for (const std::function<void()>& decode : *parasitics) {
+          decode();
+        }
+      });
+    };
+    block._r_val_tbl.setLoader(load);
+    block._c_val_tbl.setLoader(load);
+    block._cc_val_tbl.setLoader(load);
+    block._cap_node_tbl.setLoader(load);
+    block._r_seg_tbl.setLoader(load);
+    block._cc_seg_tbl.setLoader(load);
+  }
+}
+
 dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
 {
   _dbDatabase* db = block.getImpl()->getDatabase();
@@ -1117,11 +1204,18 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
     stream >> block._component_mask_shift;
   }
   stream >> block._currentCcAdjOrder;
-  stream >> *block._bterm_tbl;
-  stream >> *block._iterm_tbl;
-  stream >> *block._net_tbl;
+  const bool sections = db->isSchema(db_schema_block_sections);
+  if (sections) {
+    readBlockSections(stream, block);
+  } else {
+    stream >> *block._bterm_tbl;
+    stream >> *block._iterm_tbl;
+    stream >> *block._net_tbl;
+  }
   stream >> *block._inst_hdr_tbl;
-  stream >> *block._inst_tbl;
+  if (!sections) {
+    stream >> *block._inst_tbl;
+  }
   stream >> *block._module_tbl;
   stream >> *block._modinst_tbl;
   if (db->isSchema(db_schema_update_hierarchy)) {
@@ -1145,17 +1239,23 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
   if (db->isSchema(db_schema_net_tracks)) {
     stream >> *block._net_tracks_tbl;
   }
-  stream >> *block._box_tbl;
+  if (!sections) {
+    stream >> *block._box_tbl;
+  }
   stream >> *block._via_tbl;
   stream >> *block._gcell_grid_tbl;
   stream >> *block._track_grid_tbl;
   stream >> *block._obstruction_tbl;
   stream >> *block._blockage_tbl;
-  stream >> *block._wire_tbl;
-  stream >> *block._swire_tbl;
-  stream >> *block._sbox_tbl;
+  if (!sections) {
+    stream >> *block._wire_tbl;
+    stream >> *block._swire_tbl;
+    stream >> *block._sbox_tbl;
+  }
   stream >> *block._row_tbl;
-  stream >> *block._fill_tbl;
+  if (!db->isSchema(db_schema_fill_section)) {
+    stream >> *block._fill_tbl;
+  }
   stream >> *block._region_tbl;
   stream >> *block._hier_tbl;
   stream >> *block._bpin_tbl;
@@ -1163,12 +1263,14 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
   stream >> *block._layer_rule_tbl;
   stream >> *block._prop_tbl;
   stream >> *block._name_cache;
-  stream >> *block._r_val_tbl;
-  stream >> *block._c_val_tbl;
-  stream >> *block._cc_val_tbl;
-  stream >> *block._cap_node_tbl;  // DKF
-  stream >> *block._r_seg_tbl;     // DKF
-  stream >> *block._cc_seg_tbl;
+  if (!sections) {
+    stream >> *block._r_val_tbl;
+    stream >> *block._c_val_tbl;
+    stream >> *block._cc_val_tbl;
+    stream >> *block._cap_node_tbl;  // DKF
+    stream >> *block._r_seg_tbl;     // DKF
+    stream >> *block._cc_seg_tbl;
+  }
   stream >> *block._extControl;
   if (db->isSchema(db_schema_add_scan)) {
     stream >> block._dft;
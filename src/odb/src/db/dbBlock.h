@@ -38,6 +38,7 @@
 #include "dbCore.h"
 #include "dbHashTable.h"
 #include "dbIntHashTable.h"
+#include "dbLazyTable.h"
 #include "dbPagedVector.h"
 #include "dbVector.h"
 #include "odb/dbTransform.h"
@@ -212,11 +213,11 @@ class _dbBlock : public _dbObject
   dbTable<_dbTrackGrid>* _track_grid_tbl;
   dbTable<_dbObstruction>* _obstruction_tbl;
   dbTable<_dbBlockage>* _blockage_tbl;
-  dbTable<_dbWire>* _wire_tbl;
+  dbLazyTable<dbTable<_dbWire>> _wire_tbl;
   dbTable<_dbSWire>* _swire_tbl;
   dbTable<_dbSBox>* _sbox_tbl;
   dbTable<_dbRow>* _row_tbl;
-  dbTable<_dbFill>* _fill_tbl;
+  dbLazyTable<dbTable<_dbFill>> _fill_tbl;
   dbTable<_dbRegion>* _region_tbl;
   dbTable<_dbHier>* _hier_tbl;
   dbTable<_dbBPin>* _bpin_tbl;
@@ -238,18 +239,18 @@ class _dbBlock : public _dbObject
   _dbNameCache* _name_cache;
   dbTable<_dbDft>* _dft_tbl;
 
-  dbPagedVector<float, 4096, 12>* _r_val_tbl;
-  dbPagedVector<float, 4096, 12>* _c_val_tbl;
-  dbPagedVector<float, 4096, 12>* _cc_val_tbl;
+  dbLazyTable<dbPagedVector<float, 4096, 12>> _r_val_tbl;
+  dbLazyTable<dbPagedVector<float, 4096, 12>> _c_val_tbl;
+  dbLazyTable<dbPagedVector<float, 4096, 12>> _cc_val_tbl;
 
   dbTable<_dbModBTerm>* _modbterm_tbl;
   dbTable<_dbModITerm>* _moditerm_tbl;
   dbTable<_dbModNet>* _modnet_tbl;
   dbTable<_dbBusPort>* _busport_tbl;
 
-  dbTable<_dbCapNode>* _cap_node_tbl;
-  dbTable<_dbRSeg>* _r_seg_tbl;
-  dbTable<_dbCCSeg>* _cc_seg_tbl;
+  dbLazyTable<dbTable<_dbCapNode>> _cap_node_tbl;
+  dbLazyTable<dbTable<_dbRSeg>> _r_seg_tbl;
+  dbLazyTable<dbTable<_dbCCSeg>> _cc_seg_tbl;
   dbExtControl* _extControl;
 
   // NON-PERSISTANT-NON-STREAMED-MEMBERS
@@ -502,17 +502,31 @@ dbTech* dbDatabase::getTech()
       utl::ODB, 432, "getTech() is obsolete in a multi-tech db");
 }
 
-void dbDatabase::read(std::istream& file)
+void dbDatabase::read(std::istream& file, const int threads)
 {
   _dbDatabase* db = (_dbDatabase*) this;
   dbIStream stream(db, file);
+  stream.setThreads(threads);
   stream >> *db;
 }
 
-void dbDatabase::write(std::ostream& file)
+void dbDatabase::read(const char* data,
+                      const size_t size,
+                      const int threads,
+                      const bool defer_tables)
+{
+  _dbDatabase* db = (_dbDatabase*) this;
+  dbIStream stream(db, data, size);
+  stream.setThreads(threads);
+  stream.setDeferSections(defer_tables);
+  stream >> *db;
+}
+
+void dbDatabase::write(std::ostream& file, const int threads)
 {
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream stream(db, file);
+  stream.setThreads(threads);
   stream << *db;
   file.flush();
 }
@@ -70,7 +70,13 @@ namespace odb {
 const uint db_schema_major = 0;  // Not used...
 const uint db_schema_initial = 57;
 
-const uint db_schema_minor = 88;  // Current revision number
+const uint db_schema_minor = 90;  // Current revision number
+
+// Revision where the fill table moved to the block sections
+const uint db_schema_fill_section = 90;
+
+// Revision where the large block tables moved to compressed sections
+const uint db_schema_block_sections = 89;
 
 // Revision where odb::Polygon was added
 const uint db_schema_polygon = 88;
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace odb {
+
+//
+// Pointer to a block table that may be decoded on first access instead of
+// when the block is read (see dbDatabase::read). Every access goes through
+// load() so callers use it like the plain table pointer it replaces.
+//
+template <class T>
+class dbLazyTable
+{
+ public:
+  dbLazyTable() = default;
+  dbLazyTable(const dbLazyTable&) = delete;
+  dbLazyTable& operator=(const dbLazyTable&) = delete;
+
+  // Replacing the table drops any pending load of the old one.
+  dbLazyTable& operator=(T* table)
+  {
+    table_ = table;
+    loader_ = nullptr;
+    pending_.store(false, std::memory_order_release);
+    return *this;
+  }
+
+  T* get() const
+  {
+    load();
+    return table_;
+  }
+  T* operator->() const { return get(); }
+  T& operator*() const { return *get(); }
+  operator T*() const { return get(); }
+
+  // The table without triggering the load, for the loader itself.
+  T* unchecked() const { return table_; }
+
+  // Gives up the table without loading it, for the owner to delete.
+  T* release()
+  {
+    T* table = table_;
+    *this = nullptr;
+    return table;
+  }
+
+  // loader fills unchecked() and is called once, on the first access.
+  void setLoader(std::function<void()> loader)
+  {
+    loader_ = std::move(loader);
+    pending_.store(true, std::memory_order_release);
+  }
+
+  bool isLoaded() const { return !pending_.load(std::memory_order_acquire); }
+
+  // Decodes the table now if its load is pending.
+  void load() const
+  {
+    if (isLoaded()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!pending_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    loader_();
+    loader_ = nullptr;
+    pending_.store(false, std::memory_order_release);
+  }
+
+ private:
+  T* table_ = nullptr;
+  mutable std::function<void()> loader_;
+  mutable std::atomic<bool> pending_{false};
+  mutable std::mutex mutex_;
+};
+
+}  // namespace odb
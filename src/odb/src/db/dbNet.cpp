@@ -461,9 +461,12 @@ void _dbNet::differences(dbDiff& diff,
     set_symmetric_diff(diff, lhs_vec, rhs_vec);
   }
 
-  DIFF_OBJECT(_wire, lhs_block->_wire_tbl, rhs_block->_wire_tbl);
-  DIFF_OBJECT(_global_wire, lhs_block->_wire_tbl, rhs_block->_wire_tbl);
+  DIFF_OBJECT(_wire, lhs_block->_wire_tbl.get(), rhs_block->_wire_tbl.get());
+  DIFF_OBJECT(
+      _global_wire, lhs_block->_wire_tbl.get(), rhs_block->_wire_tbl.get());
   DIFF_SET(_swires, lhs_block->_swire_itr, rhs_block->_swire_itr);
+  lhs_block->_cap_node_tbl.load();
+  rhs_block->_cap_node_tbl.load();
   DIFF_SET(_cap_nodes, lhs_block->_cap_node_itr, rhs_block->_cap_node_itr);
   DIFF_SET(_r_segs, lhs_block->_r_seg_itr, rhs_block->_r_seg_itr);
   DIFF_FIELD(_non_default_rule);
@@ -540,9 +543,10 @@ void _dbNet::out(dbDiff& diff, char side, const char* field) const
     diff.end_object();
   }
 
-  DIFF_OUT_OBJECT(_wire, block->_wire_tbl);
-  DIFF_OUT_OBJECT(_global_wire, block->_wire_tbl);
+  DIFF_OUT_OBJECT(_wire, block->_wire_tbl.get());
+  DIFF_OUT_OBJECT(_global_wire, block->_wire_tbl.get());
   DIFF_OUT_SET(_swires, block->_swire_itr);
+  block->_cap_node_tbl.load();
   DIFF_OUT_SET(_cap_nodes, block->_cap_node_itr);
   DIFF_OUT_SET(_r_segs, block->_r_seg_itr);
   DIFF_OUT_FIELD(_non_default_rule);
@@ -2016,6 +2020,8 @@ dbSet<dbRSeg> dbNet::getRSegs()
 {
   _dbNet* net = (_dbNet*) this;
   _dbBlock* block = (_dbBlock*) net->getOwner();
+  // The iterator holds the table directly so it must be loaded first.
+  block->_r_seg_tbl.load();
   return dbSet<dbRSeg>(net, block->_r_seg_itr);
 }
 
@@ -2437,6 +2443,8 @@ dbSet<dbCapNode> dbNet::getCapNodes()
 {
   _dbNet* net = (_dbNet*) this;
   _dbBlock* block = (_dbBlock*) net->getOwner();
+  // The iterator holds the table directly so it must be loaded first.
+  block->_cap_node_tbl.load();
   return dbSet<dbCapNode>(net, block->_cap_node_itr);
 }
 
@@ -0,0 +1,225 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbSection.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <ios>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "dbDatabase.h"
+
+namespace odb {
+
+namespace {
+
+// Upper bound on the deflate compression ratio.
+constexpr uint64_t kMaxCompressionRatio = 1032;
+
+struct Section
+{
+  uint64_t raw_size = 0;
+  std::string compressed;
+};
+
+// Runs func(0..count-1) on up to threads threads. The first exception
+// thrown by any call is rethrown once all the threads have finished.
+template <typename Func>
+void forEachSection(const size_t count, const int threads, Func func)
+{
+  const size_t thread_count
+      = std::min(count, static_cast<size_t>(std::max(threads, 1)));
+  if (thread_count <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next(0);
+  std::vector<std::exception_ptr> errors(count);
+  std::vector<std::thread> workers;
+  workers.reserve(thread_count);
+  for (size_t t = 0; t < thread_count; ++t) {
+    workers.emplace_back([&]() {
+      for (size_t i = next++; i < count; i = next++) {
+        try {
+          func(i);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (const std::exception_ptr& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+void decodeSection(_dbDatabase* db,
+                   const uint64_t raw_size,
+                   const std::string& compressed,
+                   const dbSectionReader::Read& read)
+{
+  std::string raw(raw_size, '\0');
+  uLongf size = raw.size();
+  const int status
+      = uncompress(reinterpret_cast<Bytef*>(raw.data()),
+                   &size,
+                   reinterpret_cast<const Bytef*>(compressed.data()),
+                   compressed.size());
+  if (status != Z_OK || size != raw.size()) {
+    throw std::ios_base::failure("failed to decompress db section");
+  }
+
+  dbIStream section_stream(db, raw.data(), raw.size());
+  read(section_stream);
+}
+
+}  // namespace
+
+void writeSections(dbOStream& stream,
+                   const std::vector<dbSectionWriter>& writers)
+{
+  dbOStreamScope scope(stream, "sections");
+  _dbDatabase* db = stream.getDatabase();
+  std::vector<Section> sections(writers.size());
+
+  forEachSection(writers.size(), stream.getThreads(), [&](const size_t i) {
+    std::ostringstream buffer;
+    dbOStream section_stream(db, buffer);
+    writers[i](section_stream);
+    const std::string raw = buffer.str();
+
+    Section& section = sections[i];
+    section.raw_size = raw.size();
+    uLongf compressed_size = compressBound(raw.size());
+    section.compressed.resize(compressed_size);
+    const int status
+        = compress2(reinterpret_cast<Bytef*>(section.compressed.data()),
+                    &compressed_size,
+                    reinterpret_cast<const Bytef*>(raw.data()),
+                    raw.size(),
+                    Z_BEST_SPEED);
+    if (status != Z_OK) {
+      throw std::ios_base::failure("failed to compress db section");
+    }
+    section.compressed.resize(compressed_size);
+  });
+
+  stream << static_cast<uint32_t>(sections.size());
+  for (const Section& section : sections) {
+    stream << section.raw_size;
+    stream << static_cast<uint64_t>(section.compressed.size());
+  }
+  for (const Section& section : sections) {
+    stream.write(section.compressed.data(), section.compressed.size());
+  }
+}
+
+void readSections(dbIStream& stream,
+                  const std::vector<dbSectionReader>& readers)
+{
+  uint32_t count;
+  stream >> count;
+  if (count != readers.size()) {
+    throw std::ios_base::failure("unexpected number of db sections");
+  }
+
+  std::vector<uint64_t> raw_sizes(count);
+  std::vector<uint64_t> compressed_sizes(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    stream >> raw_sizes[i];
+    stream >> compressed_sizes[i];
+  }
+  // Check the sizes before allocating so a corrupt header fails cleanly.
+  uint64_t remaining = stream.remaining();
+  for (uint32_t i = 0; i < count; ++i) {
+    if (compressed_sizes[i] > remaining) {
+      throw std::ios_base::failure("db section is larger than the file");
+    }
+    remaining -= compressed_sizes[i];
+    if (raw_sizes[i] / kMaxCompressionRatio > compressed_sizes[i]) {
+      throw std::ios_base::failure("db section has an invalid size");
+    }
+  }
+
+  std::vector<std::string> compressed(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    compressed[i].resize(compressed_sizes[i]);
+  }
+  for (std::string& data : compressed) {
+    stream.read(data.data(), data.size());
+  }
+
+  _dbDatabase* db = stream.getDatabase();
+  // A deferred section is decoded against the schema in effect at that
+  // time, so only files of the current schema can be deferred.
+  const bool defer = stream.getDeferSections()
+                     && db->_schema_minor == db_schema_minor;
+
+  std::vector<size_t> now;
+  for (uint32_t i = 0; i < count; ++i) {
+    if (defer && readers[i].defer) {
+      auto data = std::make_shared<std::string>(std::move(compressed[i]));
+      readers[i].defer(
+          [db, raw_size = raw_sizes[i], data, read = readers[i].read]() {
+            decodeSection(db, raw_size, *data, read);
+          });
+    } else {
+      now.push_back(i);
+    }
+  }
+
+  forEachSection(now.size(), stream.getThreads(), [&](const size_t i) {
+    const size_t section = now[i];
+    decodeSection(
+        db, raw_sizes[section], compressed[section], readers[section].read);
+    compressed[section].clear();
+    compressed[section].shrink_to_fit();
+  });
+}
+
+}  // namespace odb
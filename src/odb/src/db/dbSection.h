@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "odb/dbStream.h"
+
+namespace odb {
+
+//
+// Sections are parts of the db stream (typically the large block tables)
+// that are serialized into their own buffer and compressed. They don't
+// depend on one another so they are encoded and decoded concurrently using
+// the stream's thread count. The layout is:
+//
+//   uint32  number of sections
+//   uint64  uncompressed size  \  repeated for each section
+//   uint64  compressed size    /
+//   bytes   compressed data of each section, in order
+//
+using dbSectionWriter = std::function<void(dbOStream&)>;
+
+struct dbSectionReader
+{
+  using Read = std::function<void(dbIStream&)>;
+  using Defer = std::function<void(std::function<void()> decode)>;
+
+  dbSectionReader(Read read, Defer defer = nullptr)
+      : read(std::move(read)), defer(std::move(defer))
+  {
+  }
+
+  Read read;
+  // If set and the stream defers sections, this is handed a function that
+  // decodes the section later instead of decoding it now. The compressed
+  // data is kept until then.
+  Defer defer;
+};
+
+void writeSections(dbOStream& stream,
+                   const std::vector<dbSectionWriter>& writers);
+
+// Throws std::ios_base::failure if the sections don't match the readers
+// or fail to decompress.
+void readSections(dbIStream& stream,
+                  const std::vector<dbSectionReader>& readers);
+
+}  // namespace odb
@@ -33,6 +33,7 @@
 #include "odb/dbStream.h"
 
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 #include "dbDatabase.h"
@@ -139,7 +140,36 @@ dbOStream::dbOStream(_dbDatabase* db, std::ostream& f) : _f(f)
   }
 }
 
-dbIStream::dbIStream(_dbDatabase* db, std::istream& f) : _f(f)
+dbIStream::dbIStream(_dbDatabase* db, std::istream& f) : _f(&f)
+{
+  initLefFactors(db);
+}
+
+dbIStream::dbIStream(_dbDatabase* db, const char* data, size_t size)
+    : _data(data), _data_end(data + size)
+{
+  initLefFactors(db);
+}
+
+size_t dbIStream::remaining()
+{
+  if (!_f) {
+    return _data_end - _data;
+  }
+  const std::streampos pos = _f->tellg();
+  if (pos < 0) {
+    return std::numeric_limits<size_t>::max();
+  }
+  _f->seekg(0, std::ios::end);
+  const std::streampos end = _f->tellg();
+  _f->seekg(pos);
+  if (end < pos) {
+    return std::numeric_limits<size_t>::max();
+  }
+  return end - pos;
+}
+
+void dbIStream::initLefFactors(_dbDatabase* db)
 {
   _db = db;
 
@@ -146,15 +146,19 @@ template <class T>
 inline dbIStream& operator>>(dbIStream& stream, dbVector<T>& v)
 {
   v.clear();
-  unsigned int sz;
-  stream >> sz;
-  v.reserve(sz);
-
-  T t;
-  unsigned int i;
-  for (i = 0; i < sz; ++i) {
-    stream >> t;
-    v.push_back(t);
+  if constexpr (dbIStream::isBulkReadable<T>()) {
+    stream >> static_cast<std::vector<T>&>(v);
+  } else {
+    unsigned int sz;
+    stream >> sz;
+    v.reserve(sz);
+
+    T t;
+    unsigned int i;
+    for (i = 0; i < sz; ++i) {
+      stream >> t;
+      v.push_back(t);
+    }
   }
 
   return stream;
@@ -39,7 +39,7 @@
 
 BEGIN_LEFDEF_PARSER_NAMESPACE
 
-extern defrContext defContext;
+extern thread_local defrContext defContext;
 
 /*******************
  *  Debug flags:
@@ -498,6 +498,6 @@ defrContext::defrContext(int ownConf)
 {
 }
 
-defrContext defContext;
+thread_local defrContext defContext;
 
 END_LEFDEF_PARSER_NAMESPACE
@@ -32,6 +32,7 @@
 
 #include "odb/defin.h"
 
+#include "definParallelNets.h"
 #include "definReader.h"
 #include "odb/db.h"
 
@@ -82,6 +83,16 @@ void defin::continueOnErrors()
   _reader->continueOnErrors();
 }
 
+void defin::setThreads(const int threads)
+{
+  _reader->setThreads(threads);
+}
+
+void defin::setParallelNetsMinBytes(const size_t bytes)
+{
+  definParallelNets::setMinParallelBytes(bytes);
+}
+
 void defin::namesAreDBIDs()
 {
   _reader->namesAreDBIDs();
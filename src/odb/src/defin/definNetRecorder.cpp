@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "definNetRecorder.h"
+
+#include "definNet.h"
+
+namespace odb {
+
+definNetRecorder::Op& definNetRecorder::add(const OpType type)
+{
+  Op& op = ops_.emplace_back();
+  op.type = type;
+  return op;
+}
+
+size_t definNetRecorder::addString(std::string_view str)
+{
+  const size_t offset = strings_.size();
+  strings_.append(str);
+  strings_.push_back('\0');
+  return offset;
+}
+
+void definNetRecorder::begin(const char* name)
+{
+  add(OP_BEGIN).strings[0] = addString(name);
+}
+
+void definNetRecorder::beginMustjoin(const char* iname, const char* pname)
+{
+  Op& op = add(OP_BEGIN_MUSTJOIN);
+  op.strings[0] = addString(iname);
+  op.strings[1] = addString(pname);
+}
+
+void definNetRecorder::connection(const char* iname, const char* pname)
+{
+  Op& op = add(OP_CONNECTION);
+  op.strings[0] = addString(iname);
+  op.strings[1] = addString(pname);
+}
+
+void definNetRecorder::nonDefaultRule(const char* rule)
+{
+  add(OP_NON_DEFAULT_RULE).strings[0] = addString(rule);
+}
+
+void definNetRecorder::use(dbSigType type)
+{
+  add(OP_USE).args[0] = type.getValue();
+}
+
+void definNetRecorder::wire(dbWireType type)
+{
+  add(OP_WIRE).args[0] = type.getValue();
+}
+
+void definNetRecorder::path(const char* layer)
+{
+  add(OP_PATH).strings[0] = addString(layer);
+}
+
+void definNetRecorder::pathTaper(const char* layer)
+{
+  add(OP_PATH_TAPER).strings[0] = addString(layer);
+}
+
+void definNetRecorder::pathTaperRule(const char* layer, const char* rule)
+{
+  Op& op = add(OP_PATH_TAPER_RULE);
+  op.strings[0] = addString(layer);
+  op.strings[1] = addString(rule);
+}
+
+void definNetRecorder::pathPoint(const int x, const int y)
+{
+  Op& op = add(OP_PATH_POINT);
+  op.args[0] = x;
+  op.args[1] = y;
+}
+
+void definNetRecorder::pathPoint(const int x, const int y, const int ext)
+{
+  Op& op = add(OP_PATH_POINT_EXT);
+  op.args[0] = x;
+  op.args[1] = y;
+  op.args[2] = ext;
+}
+
+void definNetRecorder::pathVia(const char* via)
+{
+  add(OP_PATH_VIA).strings[0] = addString(via);
+}
+
+void definNetRecorder::pathVia(const char* via, dbOrientType orient)
+{
+  Op& op = add(OP_PATH_VIA_ORIENT);
+  op.strings[0] = addString(via);
+  op.args[0] = orient.getValue();
+}
+
+void definNetRecorder::pathRect(const int deltaX1,
+                                const int deltaY1,
+                                const int deltaX2,
+                                const int deltaY2)
+{
+  Op& op = add(OP_PATH_RECT);
+  op.args[0] = deltaX1;
+  op.args[1] = deltaY1;
+  op.args[2] = deltaX2;
+  op.args[3] = deltaY2;
+}
+
+void definNetRecorder::pathColor(const int color)
+{
+  add(OP_PATH_COLOR).args[0] = color;
+}
+
+void definNetRecorder::pathViaColor(const int bottom_color,
+                                    const int cut_color,
+                                    const int top_color)
+{
+  Op& op = add(OP_PATH_VIA_COLOR);
+  op.args[0] = bottom_color;
+  op.args[1] = cut_color;
+  op.args[2] = top_color;
+}
+
+void definNetRecorder::pathEnd()
+{
+  add(OP_PATH_END);
+}
+
+void definNetRecorder::wireEnd()
+{
+  add(OP_WIRE_END);
+}
+
+void definNetRecorder::source(dbSourceType source)
+{
+  add(OP_SOURCE).args[0] = source.getValue();
+}
+
+void definNetRecorder::weight(const int weight)
+{
+  add(OP_WEIGHT).args[0] = weight;
+}
+
+void definNetRecorder::fixedbump()
+{
+  add(OP_FIXEDBUMP);
+}
+
+void definNetRecorder::property(const char* name, const char* value)
+{
+  Op& op = add(OP_PROPERTY_STRING);
+  op.strings[0] = addString(name);
+  op.strings[1] = addString(value);
+}
+
+void definNetRecorder::property(const char* name, const int value)
+{
+  Op& op = add(OP_PROPERTY_INT);
+  op.strings[0] = addString(name);
+  op.args[0] = value;
+}
+
+void definNetRecorder::property(const char* name, const double value)
+{
+  Op& op = add(OP_PROPERTY_DOUBLE);
+  op.strings[0] = addString(name);
+  op.value = value;
+}
+
+void definNetRecorder::end()
+{
+  add(OP_END);
+}
+
+void definNetRecorder::error(std::string_view msg)
+{
+  add(OP_ERROR).strings[0] = addString(msg);
+}
+
+void definNetRecorder::message(std::string_view msg)
+{
+  add(OP_MESSAGE).strings[0] = addString(msg);
+}
+
+void definNetRecorder::replay(
+    definNet* net,
+    const std::function<void(std::string_view)>& error,
+    const std::function<void(std::string_view)>& message) const
+{
+  for (const Op& op : ops_) {
+    switch (op.type) {
+      case OP_BEGIN:
+        net->begin(string(op.strings[0]));
+        break;
+      case OP_BEGIN_MUSTJOIN:
+        net->beginMustjoin(string(op.strings[0]), string(op.strings[1]));
+        break;
+      case OP_CONNECTION:
+        net->connection(string(op.strings[0]), string(op.strings[1]));
+        break;
+      case OP_NON_DEFAULT_RULE:
+        net->nonDefaultRule(string(op.strings[0]));
+        break;
+      case OP_USE:
+        net->use(dbSigType(static_cast<dbSigType::Value>(op.args[0])));
+        break;
+      case OP_WIRE:
+        net->wire(dbWireType(static_cast<dbWireType::Value>(op.args[0])));
+        break;
+      case OP_PATH:
+        net->path(string(op.strings[0]));
+        break;
+      case OP_PATH_TAPER:
+        net->pathTaper(string(op.strings[0]));
+        break;
+      case OP_PATH_TAPER_RULE:
+        net->pathTaperRule(string(op.strings[0]), string(op.strings[1]));
+        break;
+      case OP_PATH_POINT:
+        net->pathPoint(op.args[0], op.args[1]);
+        break;
+      case OP_PATH_POINT_EXT:
+        net->pathPoint(op.args[0], op.args[1], op.args[2]);
+        break;
+      case OP_PATH_VIA:
+        net->pathVia(string(op.strings[0]));
+        break;
+      case OP_PATH_VIA_ORIENT: {
+        const auto orient = static_cast<dbOrientType::Value>(op.args[0]);
+        net->pathVia(string(op.strings[0]), dbOrientType(orient));
+        break;
+      }
+      case OP_PATH_RECT:
+        net->pathRect(op.args[0], op.args[1], op.args[2], op.args[3]);
+        break;
+      case OP_PATH_COLOR:
+        net->pathColor(op.args[0]);
+        break;
+      case OP_PATH_VIA_COLOR:
+        net->pathViaColor(op.args[0], op.args[1], op.args[2]);
+        break;
+      case OP_PATH_END:
+        net->pathEnd();
+        break;
+      case OP_WIRE_END:
+        net->wireEnd();
+        break;
+      case OP_SOURCE: {
+        const auto source = static_cast<dbSourceType::Value>(op.args[0]);
+        net->source(dbSourceType(source));
+        break;
+      }
+      case OP_WEIGHT:
+        net->weight(op.args[0]);
+        break;
+      case OP_FIXEDBUMP:
+        net->fixedbump();
+        break;
+      case OP_PROPERTY_STRING:
+        net->property(string(op.strings[0]), string(op.strings[1]));
+        break;
+      case OP_PROPERTY_INT:
+        net->property(string(op.strings[0]), op.args[0]);
+        break;
+      case OP_PROPERTY_DOUBLE:
+        net->property(string(op.strings[0]), op.value);
+        break;
+      case OP_END:
+        net->end();
+        break;
+      case OP_ERROR:
+        error(string(op.strings[0]));
+        break;
+      case OP_MESSAGE:
+        message(string(op.strings[0]));
+        break;
+    }
+  }
+}
+
+void definNetRecorder::clear()
+{
+  ops_.clear();
+  ops_.shrink_to_fit();
+  strings_.clear();
+  strings_.shrink_to_fit();
+}
+
+}  // namespace odb
@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "odb/dbTypes.h"
+
+namespace odb {
+
+class definNet;
+
+//
+// Records the definNet calls made for the nets of one chunk of the NETS
+// section while it is parsed on a worker thread. The calls are replayed
+// into the definNet on the reading thread, in file order, so the database
+// is built exactly as if the chunk had been read serially.
+//
+class definNetRecorder
+{
+ public:
+  void begin(const char* name);
+  void beginMustjoin(const char* iname, const char* pname);
+  void connection(const char* iname, const char* pname);
+  void nonDefaultRule(const char* rule);
+  void use(dbSigType type);
+  void wire(dbWireType type);
+  void path(const char* layer);
+  void pathTaper(const char* layer);
+  void pathTaperRule(const char* layer, const char* rule);
+  void pathPoint(int x, int y);
+  void pathPoint(int x, int y, int ext);
+  void pathVia(const char* via);
+  void pathVia(const char* via, dbOrientType orient);
+  void pathRect(int deltaX1, int deltaY1, int deltaX2, int deltaY2);
+  void pathColor(int color);
+  void pathViaColor(int bottom_color, int cut_color, int top_color);
+  void pathEnd();
+  void wireEnd();
+  void source(dbSourceType source);
+  void weight(int weight);
+  void fixedbump();
+  void property(const char* name, const char* value);
+  void property(const char* name, int value);
+  void property(const char* name, double value);
+  void end();
+  void error(std::string_view msg);
+  // A message from the DEF parser.
+  void message(std::string_view msg);
+
+  // Calls net (and error and message for recorded errors and parser
+  // messages) in the recorded order.
+  void replay(definNet* net,
+              const std::function<void(std::string_view)>& error,
+              const std::function<void(std::string_view)>& message) const;
+
+  void clear();
+
+ private:
+  enum OpType
+  {
+    OP_BEGIN,
+    OP_BEGIN_MUSTJOIN,
+    OP_CONNECTION,
+    OP_NON_DEFAULT_RULE,
+    OP_USE,
+    OP_WIRE,
+    OP_PATH,
+    OP_PATH_TAPER,
+    OP_PATH_TAPER_RULE,
+    OP_PATH_POINT,
+    OP_PATH_POINT_EXT,
+    OP_PATH_VIA,
+    OP_PATH_VIA_ORIENT,
+    OP_PATH_RECT,
+    OP_PATH_COLOR,
+    OP_PATH_VIA_COLOR,
+    OP_PATH_END,
+    OP_WIRE_END,
+    OP_SOURCE,
+    OP_WEIGHT,
+    OP_FIXEDBUMP,
+    OP_PROPERTY_STRING,
+    OP_PROPERTY_INT,
+    OP_PROPERTY_DOUBLE,
+    OP_END,
+    OP_ERROR,
+    OP_MESSAGE
+  };
+
+  struct Op
+  {
+    OpType type;
+    int args[4];
+    double value;
+    // Offsets into strings_ of the string arguments.
+    size_t strings[2];
+  };
+
+  Op& add(OpType type);
+  size_t addString(std::string_view str);
+  const char* string(size_t offset) const { return strings_.data() + offset; }
+
+  std::vector<Op> ops_;
+  std::string strings_;
+};
+
+}  // namespace odb
@@ -0,0 +1,363 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "definParallelNets.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <utility>
+
+namespace odb {
+
+// Sections smaller than this are not worth the extra pass over the file.
+static size_t min_parallel_bytes = 16 << 20;
+constexpr size_t kMinChunkBytes = 4 << 20;
+constexpr size_t kChunksPerThread = 8;
+// The header should only hold a few short statements.
+constexpr size_t kMaxHeaderBytes = 1 << 20;
+
+// Chunks parsed ahead of the replay, per thread; bounds the memory held by
+// recorders that are waiting to be replayed.
+constexpr size_t kChunksAheadPerThread = 2;
+
+static const char kNetsStatement[] = "NETS 1 ;";
+static const char kTrailer[] = "\nEND NETS\nEND DESIGN\n";
+
+definParallelNets::definParallelNets(const char* data,
+                                     const size_t size,
+                                     const char* file_name,
+                                     const int threads,
+                                     RecordFn record)
+    : data_(data),
+      size_(size),
+      file_name_(file_name),
+      threads_(threads),
+      record_(std::move(record))
+{
+}
+
+definParallelNets::~definParallelNets()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+size_t definParallelNets::lineEnd(const size_t pos) const
+{
+  const void* newline = memchr(data_ + pos, '\n', size_ - pos);
+  if (newline == nullptr) {
+    return size_;
+  }
+  return static_cast<const char*>(newline) - data_;
+}
+
+size_t definParallelNets::nextLine(const size_t pos) const
+{
+  return std::min(lineEnd(pos) + 1, size_);
+}
+
+std::string_view definParallelNets::token(size_t& pos, const size_t end) const
+{
+  while (pos < end && isspace(data_[pos])) {
+    ++pos;
+  }
+  const size_t begin = pos;
+  while (pos < end && !isspace(data_[pos])) {
+    ++pos;
+  }
+  return {data_ + begin, pos - begin};
+}
+
+size_t definParallelNets::countLines(const size_t begin, const size_t end) const
+{
+  return std::count(data_ + begin, data_ + end, '\n');
+}
+
+// Returns the start of the first line at or after pos that begins a net:
+// its first token is "-" and the statement before it ended with ';'.
+size_t definParallelNets::netStart(size_t pos) const
+{
+  for (pos = nextLine(pos); pos < body_end_; pos = nextLine(pos)) {
+    size_t next = pos;
+    if (token(next, lineEnd(pos)) != "-") {
+      continue;
+    }
+    size_t prev = pos;
+    while (prev > body_begin_ && isspace(data_[prev - 1])) {
+      --prev;
+    }
+    if (prev > body_begin_ && data_[prev - 1] == ';') {
+      return pos;
+    }
+  }
+  return body_end_;
+}
+
+bool definParallelNets::split()
+{
+  for (size_t line = 0; line < size_; line = nextLine(line)) {
+    const size_t end = lineEnd(line);
+    size_t pos = line;
+    const std::string_view first = token(pos, end);
+    if (first == "DESIGN" && header_end_ == 0) {
+      const void* semi = memchr(data_ + pos, ';', size_ - pos);
+      if (semi == nullptr) {
+        return false;
+      }
+      header_end_ = nextLine(static_cast<const char*>(semi) - data_);
+    } else if (first == "PROPERTYDEFINITIONS" && header_end_ != 0) {
+      props_begin_ = line;
+    } else if (first == "END" && props_begin_ != 0 && props_end_ == 0
+               && token(pos, end) == "PROPERTYDEFINITIONS") {
+      props_end_ = nextLine(line);
+    } else if (first == "NETS") {
+      if (header_end_ == 0 || header_end_ > kMaxHeaderBytes
+          || (props_begin_ != 0 && props_end_ == 0)) {
+        return false;
+      }
+      const void* semi = memchr(data_ + pos, ';', size_ - pos);
+      if (semi == nullptr) {
+        return false;
+      }
+      pos = static_cast<const char*>(semi) - data_ + 1;
+      // A net starting on the statement's line would be read out of order.
+      if (!token(pos, lineEnd(pos)).empty()) {
+        return false;
+      }
+      body_begin_ = nextLine(pos);
+      break;
+    }
+  }
+  if (body_begin_ == 0) {
+    return false;
+  }
+
+  for (size_t line = body_begin_; line < size_; line = nextLine(line)) {
+    const size_t end = lineEnd(line);
+    size_t pos = line;
+    if (token(pos, end) == "END" && token(pos, end) == "NETS") {
+      body_end_ = line;
+      break;
+    }
+  }
+  if (body_end_ == 0 || body_end_ - body_begin_ < min_parallel_bytes) {
+    return false;
+  }
+
+  // Several chunks per thread so a slow chunk doesn't hold up the rest.
+  // Smaller sections, when allowed, get smaller chunks.
+  const size_t min_chunk_bytes
+      = std::clamp<size_t>(min_parallel_bytes / 4, 1, kMinChunkBytes);
+  const size_t body_size = body_end_ - body_begin_;
+  const size_t chunk_size
+      = std::max(min_chunk_bytes, body_size / (threads_ * kChunksPerThread));
+  const size_t body_line = countLines(0, body_begin_) + 1;
+  size_t line = body_line;
+  for (size_t begin = body_begin_; begin < body_end_;) {
+    size_t end = body_end_;
+    if (begin + chunk_size < body_end_) {
+      end = netStart(begin + chunk_size);
+    }
+    Chunk& chunk = chunks_.emplace_back();
+    chunk.begin = begin;
+    chunk.end = end;
+    chunk.line = line;
+    line += countLines(begin, end);
+    chunk.end_line = line;
+    begin = end;
+  }
+  if (chunks_.size() < 2) {
+    chunks_.clear();
+    return false;
+  }
+
+  prelude_lines_ = countLines(0, header_end_);
+  if (props_end_ != 0) {
+    prelude_lines_ += countLines(props_begin_, props_end_);
+  }
+
+  main_.add(data_, body_begin_);
+  main_.addNewlines(line - body_line);
+  main_.add(data_ + body_end_, size_ - body_end_);
+  return true;
+}
+
+void definParallelNets::start()
+{
+  const int count = std::min<int>(threads_, chunks_.size());
+  for (int i = 0; i < count; ++i) {
+    workers_.emplace_back([this] { work(); });
+  }
+}
+
+void definParallelNets::work()
+{
+  const size_t ahead = threads_ * kChunksAheadPerThread;
+  while (true) {
+    size_t index;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] {
+        return stop_ || next_ >= chunks_.size() || next_ < replayed_ + ahead;
+      });
+      if (stop_ || next_ >= chunks_.size()) {
+        return;
+      }
+      index = next_++;
+    }
+    parse(chunks_[index]);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      chunks_[index].done = true;
+    }
+    cv_.notify_all();
+  }
+}
+
+struct definNetTask
+{
+  const definParallelNets::RecordFn* record;
+  definNetRecorder* recorder;
+  size_t line;
+  size_t end_line;
+};
+
+int definParallelNets::netCallback(defrCallbackType_e /* unused: type */,
+                                   defiNet* net,
+                                   defiUserData data)
+{
+  definNetTask* task = (definNetTask*) data;
+  return (*task->record)(net, task->recorder);
+}
+
+// Parser errors and warnings are recorded so they are reported on the
+// reading thread in file order.  Messages for the prelude and trailer are
+// dropped; the reading thread parses the same statements.
+void definParallelNets::logCallback(defiUserData data, const char* msg)
+{
+  definNetTask* task = (definNetTask*) data;
+  const size_t line = defrLineNumber();
+  if (line >= task->line && line < task->end_line) {
+    task->recorder->message(msg);
+  }
+}
+
+void definParallelNets::parse(Chunk& chunk)
+{
+  // Pad with newlines so the parser reports the file's line numbers.
+  Source source;
+  source.add(data_, header_end_);
+  if (props_end_ != 0) {
+    source.add(data_ + props_begin_, props_end_ - props_begin_);
+  }
+  source.add(kNetsStatement, strlen(kNetsStatement));
+  source.addNewlines(chunk.line - prelude_lines_ - 1);
+  source.add(data_ + chunk.begin, chunk.end - chunk.begin);
+  source.add(kTrailer, strlen(kTrailer));
+
+  definNetTask task{&record_, &chunk.recorder, chunk.line, chunk.end_line};
+
+  defrInit();
+  defrReset();
+  defrInitSession();
+  defrSetContextLogFunction(logCallback);
+  defrSetContextWarningLogFunction(logCallback);
+  defrSetNetCbk(netCallback);
+  defrSetAddPathToNet();
+  defrSetReadFunction(read);
+  chunk.status = defrRead(reinterpret_cast<FILE*>(&source),
+                          file_name_,
+                          (defiUserData) &task,
+                          /* case sensitive */ 1);
+  defrClear();
+}
+
+size_t definParallelNets::read(FILE* file, char* buffer, const size_t size)
+{
+  Source* source = reinterpret_cast<Source*>(file);
+  size_t count = 0;
+  while (count < size && source->piece < source->pieces.size()) {
+    const Piece& piece = source->pieces[source->piece];
+    const size_t n = std::min(size - count, piece.size - source->offset);
+    if (piece.data != nullptr) {
+      memcpy(buffer + count, piece.data + source->offset, n);
+    } else {
+      memset(buffer + count, '\n', n);
+    }
+    count += n;
+    source->offset += n;
+    if (source->offset == piece.size) {
+      ++source->piece;
+      source->offset = 0;
+    }
+  }
+  return count;
+}
+
+bool definParallelNets::replay(
+    definNet* net,
+    const std::function<void(std::string_view)>& error,
+    const std::function<void(std::string_view)>& message)
+{
+  for (size_t i = 0; i < chunks_.size(); ++i) {
+    Chunk& chunk = chunks_[i];
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] { return chunk.done; });
+    }
+    chunk.recorder.replay(net, error, message);
+    chunk.recorder.clear();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      replayed_ = i + 1;
+    }
+    cv_.notify_all();
+    if (chunk.status != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void definParallelNets::setMinParallelBytes(const size_t bytes)
+{
+  min_parallel_bytes = bytes;
+}
+
+}  // namespace odb
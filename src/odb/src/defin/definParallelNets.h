@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "definNetRecorder.h"
+#include "defrReader.hpp"
+
+namespace odb {
+
+class definNet;
+
+//
+// Parses the NETS section of a DEF file on worker threads.  The body of
+// the section is split at net boundaries into chunks; each chunk is parsed
+// by its own parser session into a definNetRecorder.  The reading thread
+// parses the rest of the file, with the body of the NETS section blanked
+// out, and replays the chunks in file order when it reaches NETS.
+//
+// SPECIALNETS is not split. Chunks end at net boundaries, and that section
+// usually holds a few power nets with nearly all of its shapes, so it
+// can't be cut into balanced chunks.
+//
+// COMPONENTS is not split either. A component statement is only a few
+// tokens, so parsing it costs little next to dbInst::create, which makes
+// the instance's iterms and has to run on the reading thread. Recording
+// and replaying components would cost about as much as the parsing saved.
+//
+class definParallelNets
+{
+ public:
+  // Translates one parsed net into the recorder; returns a parser status.
+  using RecordFn = std::function<int(defiNet*, definNetRecorder*)>;
+
+  definParallelNets(const char* data,
+                    size_t size,
+                    const char* file_name,
+                    int threads,
+                    RecordFn record);
+  ~definParallelNets();
+
+  // Locates and splits the NETS section.  Returns false when the file
+  // should be read serially (small or missing NETS section, unusual
+  // layout).
+  bool split();
+  int chunkCount() const { return chunks_.size(); }
+
+  // Starts parsing chunks ahead of the replay.
+  void start();
+
+  // The file to hand to defrRead with defrSetReadFunction(read).
+  FILE* mainFile() { return reinterpret_cast<FILE*>(&main_); }
+  static size_t read(FILE* file, char* buffer, size_t size);
+
+  // Replays the parsed chunks into net in file order, waiting for chunks
+  // that are still being parsed.  Returns false if a chunk failed.
+  // Parser messages for the chunks are passed to message.
+  bool replay(definNet* net,
+              const std::function<void(std::string_view)>& error,
+              const std::function<void(std::string_view)>& message);
+
+  // Smallest NETS section body that is parsed in parallel.  For testing.
+  static void setMinParallelBytes(size_t bytes);
+
+ private:
+  // A run of the file, or of newlines when data is null.
+  struct Piece
+  {
+    const char* data;
+    size_t size;
+  };
+
+  struct Source
+  {
+    void add(const char* data, size_t size) { pieces.push_back({data, size}); }
+    void addNewlines(size_t count) { pieces.push_back({nullptr, count}); }
+
+    std::vector<Piece> pieces;
+    size_t piece = 0;
+    size_t offset = 0;
+  };
+
+  struct Chunk
+  {
+    size_t begin = 0;
+    size_t end = 0;
+    size_t line = 0;      // 1-based line of begin
+    size_t end_line = 0;  // 1-based line of end
+    definNetRecorder recorder;
+    int status = 0;
+    bool done = false;
+  };
+
+  size_t lineEnd(size_t pos) const;
+  size_t nextLine(size_t pos) const;
+  std::string_view token(size_t& pos, size_t end) const;
+  size_t netStart(size_t pos) const;
+  size_t countLines(size_t begin, size_t end) const;
+
+  void work();
+  void parse(Chunk& chunk);
+  static int netCallback(defrCallbackType_e type,
+                         defiNet* net,
+                         defiUserData data);
+  static void logCallback(defiUserData data, const char* msg);
+
+  const char* data_;
+  size_t size_;
+  const char* file_name_;
+  int threads_;
+  RecordFn record_;
+
+  // Header (through DESIGN) and PROPERTYDEFINITIONS, which every chunk
+  // needs to be parsed the same way as the full file.
+  size_t header_end_ = 0;
+  size_t props_begin_ = 0;
+  size_t props_end_ = 0;
+  size_t prelude_lines_ = 0;
+  size_t body_begin_ = 0;
+  size_t body_end_ = 0;
+
+  Source main_;
+  std::vector<Chunk> chunks_;
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t next_ = 0;      // next chunk to parse
+  size_t replayed_ = 0;  // chunks already replayed
+  bool stop_ = false;
+};
+
+}  // namespace odb
@@ -37,6 +37,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <string>
+#include <string_view>
 
 #include "definBlockage.h"
 #include "definComponent.h"
@@ -45,7 +46,9 @@
 #include "definGCell.h"
 #include "definGroup.h"
 #include "definNet.h"
+#include "definNetRecorder.h"
 #include "definNonDefaultRule.h"
+#include "definParallelNets.h"
 #include "definPin.h"
 #include "definPinProps.h"
 #include "definPropDefs.h"
@@ -58,6 +61,7 @@
 #include "odb/db.h"
 #include "odb/dbShape.h"
 #include "utl/Logger.h"
+#include "utl/MappedFileHandler.h"
 
 #define UNSUPPORTED(msg)              \
   reader->error((msg));               \
@@ -177,6 +181,8 @@ definReader::definReader(dbDatabase* db, utl::Logger* logger, defin::MODE mode)
   _block_name = nullptr;
   parent_ = nullptr;
   _continue_on_errors = false;
+  _threads = 1;
+  _parallel_nets = nullptr;
   version_ = nullptr;
   hier_delimeter_ = 0;
   left_bus_delimeter_ = 0;
@@ -290,6 +296,11 @@ void definReader::continueOnErrors()
   _continue_on_errors = true;
 }
 
+void definReader::setThreads(const int threads)
+{
+  _threads = threads;
+}
+
 void definReader::replaceWires()
 {
   _netR->replaceWires();
@@ -807,52 +818,50 @@ int definReader::historyCallback(defrCallbackType_e /* unused: type */,
   return PARSE_OK;
 }
 
-int definReader::netCallback(defrCallbackType_e /* unused: type */,
-                             defiNet* net,
-                             defiUserData data)
-{
-  definReader* reader = (definReader*) data;
-  CHECKBLOCK
-  definNet* netR = reader->_netR;
-  if (reader->_mode == defin::FLOORPLAN
-      && reader->_block->findNet(net->name()) == nullptr) {
-    reader->_logger->warn(
-        utl::ODB,
-        275,
-        "skipping undefined net {} encountered in FLOORPLAN DEF",
-        net->name());
-    return PARSE_OK;
+#define NET_UNSUPPORTED(msg) \
+  error((msg));              \
+  if (!continue_on_errors) { \
+    return PARSE_ERROR;      \
   }
+
+// Translates a parsed net into netR, which is either the definNet or a
+// definNetRecorder when the NETS section is read in parallel.
+template <typename NET, typename ERROR_FN>
+static int readNet(defiNet* net,
+                   NET* netR,
+                   const bool continue_on_errors,
+                   ERROR_FN error)
+{
   if (net->numShieldNets() > 0) {
-    UNSUPPORTED("SHIELDNET on net is unsupported");
+    NET_UNSUPPORTED("SHIELDNET on net is unsupported");
   }
 
   if (net->numVpins() > 0) {
-    UNSUPPORTED("VPIN on net is unsupported");
+    NET_UNSUPPORTED("VPIN on net is unsupported");
   }
 
   if (net->hasSubnets()) {
-    UNSUPPORTED("SUBNET on net is unsupported");
+    NET_UNSUPPORTED("SUBNET on net is unsupported");
   }
 
   if (net->hasXTalk()) {
-    UNSUPPORTED("XTALK on net is unsupported");
+    NET_UNSUPPORTED("XTALK on net is unsupported");
   }
 
   if (net->hasFrequency()) {
-    UNSUPPORTED("FREQUENCY on net is unsupported");
+    NET_UNSUPPORTED("FREQUENCY on net is unsupported");
   }
 
   if (net->hasOriginal()) {
-    UNSUPPORTED("ORIGINAL on net is unsupported");
+    NET_UNSUPPORTED("ORIGINAL on net is unsupported");
   }
 
   if (net->hasPattern()) {
-    UNSUPPORTED("PATTERN on net is unsupported");
+    NET_UNSUPPORTED("PATTERN on net is unsupported");
   }
 
   if (net->hasCap()) {
-    UNSUPPORTED("ESTCAP on net is unsupported");
+    NET_UNSUPPORTED("ESTCAP on net is unsupported");
   }
 
   netR->begin(net->name());
@@ -879,7 +888,7 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
 
   for (int i = 0; i < net->numConnections(); ++i) {
     if (net->pinIsSynthesized(i)) {
-      UNSUPPORTED("SYNTHESIZED on net's connection is unsupported");
+      NET_UNSUPPORTED("SYNTHESIZED on net's connection is unsupported");
     }
 
     if (net->pinIsMustJoin(i)) {
@@ -921,8 +930,9 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             const char* viaName = path->getVia();
             int nextId = path->next();
             if (nextId == DEFIPATH_VIAROTATION) {
-              netR->pathVia(viaName,
-                            translate_orientation(path->getViaRotation()));
+              netR->pathVia(
+                  viaName,
+                  definBase::translate_orientation(path->getViaRotation()));
             } else {
               netR->pathVia(viaName);
               path->prev();  // put back the token
@@ -948,7 +958,7 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
           }
 
           case DEFIPATH_STYLE:
-            UNSUPPORTED("styles are not supported on wires");
+            NET_UNSUPPORTED("styles are not supported on wires");
             break;
 
           case DEFIPATH_RECT: {
@@ -962,7 +972,7 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
           }
 
           case DEFIPATH_VIRTUALPOINT:
-            UNSUPPORTED("VIRTUAL in net's routing is unsupported");
+            NET_UNSUPPORTED("VIRTUAL in net's routing is unsupported");
             break;
 
           case DEFIPATH_MASK:
@@ -976,7 +986,8 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             break;
 
           default:
-            UNSUPPORTED("Unknown construct in net's routing is unsupported");
+            NET_UNSUPPORTED(
+                "Unknown construct in net's routing is unsupported");
             break;
         }
       }
@@ -993,6 +1004,45 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
   return PARSE_OK;
 }
 
+#undef NET_UNSUPPORTED
+
+int definReader::netCallback(defrCallbackType_e /* unused: type */,
+                             defiNet* net,
+                             defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  CHECKBLOCK
+  if (reader->_mode == defin::FLOORPLAN
+      && reader->_block->findNet(net->name()) == nullptr) {
+    reader->_logger->warn(
+        utl::ODB,
+        275,
+        "skipping undefined net {} encountered in FLOORPLAN DEF",
+        net->name());
+    return PARSE_OK;
+  }
+  return readNet(net,
+                 reader->_netR,
+                 reader->_continue_on_errors,
+                 [reader](std::string_view msg) { reader->error(msg); });
+}
+
+int definReader::netsStartCallback(defrCallbackType_e /* unused: type */,
+                                   int /* unused: count */,
+                                   defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  CHECKBLOCK
+  // Parser messages go to stderr, where the parser prints its errors.
+  const bool ok = reader->_parallel_nets->replay(
+      reader->_netR,
+      [reader](std::string_view msg) { reader->error(msg); },
+      [](std::string_view msg) {
+        fwrite(msg.data(), 1, msg.size(), stderr);
+      });
+  return ok ? PARSE_OK : PARSE_ERROR;
+}
+
 int definReader::nonDefaultRuleCallback(defrCallbackType_e /* unused: type */,
                                         defiNonDefault* rule,
                                         defiUserData data)
@@ -2115,7 +2165,11 @@ bool definReader::createBlock(const char* file)
       _logger->warn(utl::ODB, 148, "error: Cannot open DEF file {}", file);
       return false;
     }
-    res = defrRead(f, file, (defiUserData) this, /* case sensitive */ 1);
+    if (_threads > 1 && _mode == defin::DEFAULT) {
+      res = readParallelNets(f, file);
+    } else {
+      res = defrRead(f, file, (defiUserData) this, /* case sensitive */ 1);
+    }
     fclose(f);
   } else {
     defrSetGZipReadFunction();
@@ -2143,6 +2197,49 @@ bool definReader::createBlock(const char* file)
   // 1220 return errors() == 0;
 }
 
+int definReader::readParallelNets(FILE* file, const char* file_name)
+{
+  utl::MappedFileHandler mapped(file_name);
+  definParallelNets nets(
+      mapped.data(),
+      mapped.size(),
+      file_name,
+      _threads,
+      [this](defiNet* net, definNetRecorder* recorder) {
+        return readNet(net,
+                       recorder,
+                       _continue_on_errors,
+                       [recorder](std::string_view msg) {
+                         recorder->error(msg);
+                       });
+      });
+  if (!nets.split()) {
+    return defrRead(
+        file, file_name, (defiUserData) this, /* case sensitive */ 1);
+  }
+
+  debugPrint(_logger,
+             utl::ODB,
+             "defin",
+             1,
+             "Parsing NETS in {} chunks on {} threads",
+             nets.chunkCount(),
+             _threads);
+
+  // Nets are built as the chunks are replayed at the start of the section.
+  defrSetNetStartCbk(netsStartCallback);
+  defrSetReadFunction(definParallelNets::read);
+  _parallel_nets = &nets;
+  nets.start();
+  const int res = defrRead(nets.mainFile(),
+                           file_name,
+                           (defiUserData) this,
+                           /* case sensitive */ 1);
+  _parallel_nets = nullptr;
+  defrUnsetReadFunction();
+  return res;
+}
+
 bool definReader::replaceWires(const char* file)
 {
   FILE* f = fopen(file, "r");
@@ -48,6 +48,7 @@ class definComponent;
 class definFill;
 class definGCell;
 class definNet;
+class definParallelNets;
 class definPin;
 class definRow;
 class definSNet;
@@ -82,6 +83,8 @@ class definReader : public definBase
   std::vector<definBase*> _interfaces;
   bool _update;
   bool _continue_on_errors;
+  int _threads;
+  definParallelNets* _parallel_nets;  // set while NETS is read in parallel
   const char* _block_name;
   const char* version_;
   char hier_delimeter_;
@@ -98,6 +101,7 @@ class definReader : public definBase
   void setLogger(utl::Logger* logger);
 
   bool createBlock(const char* file);
+  int readParallelNets(FILE* file, const char* file_name);
   bool replaceWires(const char* file);
   void replaceWires();
   int errors();
@@ -155,6 +159,10 @@ class definReader : public definBase
                          defiNet* net,
                          defiUserData data);
 
+  static int netsStartCallback(defrCallbackType_e type,
+                               int count,
+                               defiUserData data);
+
   static int nonDefaultRuleCallback(defrCallbackType_e type,
                                     defiNonDefault* rule,
                                     defiUserData data);
@@ -258,6 +266,7 @@ class definReader : public definBase
   void skipBlockWires();
   void skipFillWires();
   void continueOnErrors();
+  void setThreads(int threads);
   void useBlockName(const char* name);
   void namesAreDBIDs();
   void setAssemblyMode();
@@ -75,6 +75,16 @@ void defout::setVersion(Version v)
   _writer->setVersion(v);
 }
 
+void defout::setThreads(int threads)
+{
+  _writer->setThreads(threads);
+}
+
+void defout::setChunkSize(size_t objects)
+{
+  defout_impl::setChunkSize(objects);
+}
+
 bool defout::writeBlock(dbBlock* block, const char* def_file)
 {
   return _writer->writeBlock(block, def_file);
@@ -34,12 +34,23 @@
 
 #include <stdio.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdint>
+#include <cstdlib>
+#include <exception>
 #include <limits>
+#include <mutex>
 #include <optional>
 #include <set>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "odb/db.h"
 #include "odb/dbMap.h"
@@ -62,6 +73,19 @@ std::string getPinName(dbITerm* iterm)
 
 static const int max_name_length = 256;
 
+// Objects formatted per chunk when a section is written on several threads.
+size_t chunk_size = 1024;
+// Chunks formatted ahead of the output, per thread; bounds the memory held
+// by buffers waiting to be written.
+constexpr size_t chunks_ahead_per_thread = 4;
+
+// The output could not be written; the partial file is discarded.
+class WriteError : public std::runtime_error
+{
+ public:
+  using std::runtime_error::runtime_error;
+};
+
 template <typename T>
 std::vector<T*> sortedSet(dbSet<T>& to_sort)
 {
@@ -167,7 +191,10 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
 
   _dist_factor
       = (double) block->getDefUnits() / (double) block->getDbUnitsPerMicron();
-  utl::FileHandler fileHandler(def_file);
+  const std::string_view file_name(def_file);
+  const bool compressed = file_name.size() > 3
+                          && file_name.substr(file_name.size() - 3) == ".gz";
+  utl::FileHandler fileHandler(def_file, compressed);
   _out = fileHandler.getFile();
 
   if (_out == nullptr) {
@@ -176,17 +203,85 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
     return false;
   }
 
-  // By default C File*'s are line buffered which means they get dumped on every
-  // newline, which is nominally pretty expensive. This makes it so that the
-  // writes are buffered according to the block size which on modern systems can
-  // be as much as 16kb. DEF's have a lot of newlines, and are large in size
-  // which makes writing them really slow with line buffering.
-  //
-  // The following lines enable IO buffering based on disk block size.
-  struct stat stats;
-  fstat(fileno(_out), &stats);
-  setvbuf(_out, nullptr, _IOFBF, stats.st_blksize);
+  if (compressed) {
+    // Compress into the handler's file so it is still renamed into place
+    // when complete.
+    const int fd = dup(fileno(_out));
+    _gz_file = gzdopen(fd, "wb1");
+    if (_gz_file == nullptr) {
+      close(fd);
+      fileHandler.discard();
+      _logger->warn(
+          utl::ODB, 446, "Cannot open DEF file ({}) for writing", def_file);
+      return false;
+    }
+    _out = open_memstream(&_gz_buffer, &_gz_buffer_size);
+    if (_out == nullptr) {
+      gzclose(_gz_file);
+      _gz_file = nullptr;
+      fileHandler.discard();
+      _logger->warn(utl::ODB,
+                    449,
+                    "Cannot allocate the buffer for DEF file ({})",
+                    def_file);
+      return false;
+    }
+  } else {
+    // By default C File*'s are line buffered which means they get dumped on
+    // every newline, which is nominally pretty expensive. This makes it so
+    // that the writes are buffered according to the block size which on
+    // modern systems can be as much as 16kb. DEF's have a lot of newlines,
+    // and are large in size which makes writing them really slow with line
+    // buffering.
+    //
+    // The following lines enable IO buffering based on disk block size.
+    struct stat stats;
+    fstat(fileno(_out), &stats);
+    setvbuf(_out, nullptr, _IOFBF, stats.st_blksize);
+  }
+
+  try {
+    writeSections(block);
+  } catch (const WriteError& error) {
+    abandonOutput();
+    fileHandler.discard();
+    _logger->warn(utl::ODB,
+                  448,
+                  "Failed to write DEF file ({}): {}",
+                  def_file,
+                  error.what());
+    return false;
+  } catch (...) {
+    abandonOutput();
+    fileHandler.discard();
+    throw;
+  }
+
+  {
+    delete _select_net_map;
+  }
+  {
+    delete _select_inst_map;
+  }
+  if (_gz_file) {
+    fclose(_out);
+    free(_gz_buffer);
+    _out = nullptr;
+    _gz_buffer = nullptr;
+    const int status = gzclose(_gz_file);
+    _gz_file = nullptr;
+    if (status != Z_OK) {
+      fileHandler.discard();
+      _logger->warn(
+          utl::ODB, 447, "Failed to write compressed DEF file ({})", def_file);
+      return false;
+    }
+  }
+  return true;
+}
 
+void defout_impl::writeSections(dbBlock* block)
+{
   if (_version == defout::DEF_5_3) {
     fprintf(_out, "VERSION 5.3 ;\n");
   } else if (_version == defout::DEF_5_4) {
@@ -252,19 +347,198 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
   writeBTerms(block);
   writePinProperties(block);
   writeBlockages(block);
+  flush();
   writeFills(block);
+  flush();
   writeNets(block);
   writeGroups(block);
   writeScanChains(block);
 
   fprintf(_out, "END DESIGN\n");
+  flush();
+  if (_gz_file == nullptr && ferror(_out)) {
+    throw WriteError("write error");
+  }
+}
+
+// Releases the compression state after a failed write.
+void defout_impl::abandonOutput()
+{
+  if (_gz_file == nullptr) {
+    return;
+  }
+  if (_out) {
+    fclose(_out);
+    _out = nullptr;
+  }
+  free(_gz_buffer);
+  _gz_buffer = nullptr;
+  gzclose(_gz_file);
+  _gz_file = nullptr;
+}
+
+// Compresses what has been formatted into the memory buffer so far.
+void defout_impl::flush()
+{
+  if (_gz_file == nullptr) {
+    return;
+  }
+  fclose(_out);
+  _out = nullptr;
+  writeOutput(_gz_buffer, _gz_buffer_size);
+  free(_gz_buffer);
+  _gz_buffer = nullptr;
+  _out = open_memstream(&_gz_buffer, &_gz_buffer_size);
+  if (_out == nullptr) {
+    throw WriteError("cannot allocate the compression buffer");
+  }
+}
+
+void defout_impl::writeOutput(const char* data, size_t size)
+{
+  if (_gz_file == nullptr) {
+    if (fwrite(data, 1, size, _out) != size) {
+      throw WriteError("write error");
+    }
+    return;
+  }
+  // gzwrite takes an unsigned length.
+  while (size > 0) {
+    const unsigned length = std::min<size_t>(size, 1U << 30);
+    if (gzwrite(_gz_file, data, length) != static_cast<int>(length)) {
+      throw WriteError("compression error");
+    }
+    data += length;
+    size -= length;
+  }
+}
+
+void defout_impl::setChunkSize(const size_t objects)
+{
+  chunk_size = std::max<size_t>(objects, 1);
+}
+
+// Calls write for 0..count-1 in order.  With several threads, the calls are
+// made in chunks on worker threads, each formatting with its own copy of
+// the writer into a memory buffer, and the buffers are written in order as
+// they complete.
+void defout_impl::writeChunked(
+    const size_t count,
+    const std::function<void(defout_impl&, size_t)>& write)
+{
+  const size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+  if (_threads <= 1 || chunk_count < 2) {
+    for (size_t i = 0; i < count; ++i) {
+      write(*this, i);
+      // Keep the compressed output's memory buffer to one chunk.
+      if ((i + 1) % chunk_size == 0) {
+        flush();
+      }
+    }
+    return;
+  }
+
+  struct Chunk
   {
-    delete _select_net_map;
+    char* data = nullptr;
+    size_t size = 0;
+    bool done = false;
+    std::exception_ptr error;
+  };
+  std::vector<Chunk> chunks(chunk_count);
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t next = 0;
+  size_t written = 0;
+  bool stop = false;
+  const size_t ahead = _threads * chunks_ahead_per_thread;
+
+  auto work = [&]() {
+    defout_impl writer(*this);
+    while (true) {
+      size_t index;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] {
+          return stop || next >= chunk_count || next < written + ahead;
+        });
+        if (stop || next >= chunk_count) {
+          return;
+        }
+        index = next++;
+      }
+      Chunk& chunk = chunks[index];
+      writer._out = open_memstream(&chunk.data, &chunk.size);
+      if (writer._out == nullptr) {
+        chunk.error = std::make_exception_ptr(
+            WriteError("cannot allocate a chunk buffer"));
+      } else {
+        try {
+          const size_t end = std::min(count, (index + 1) * chunk_size);
+          for (size_t i = index * chunk_size; i < end; ++i) {
+            write(writer, i);
+          }
+        } catch (...) {
+          chunk.error = std::current_exception();
+        }
+        fclose(writer._out);
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        chunk.done = true;
+      }
+      cv.notify_all();
+    }
+  };
+
+  // Whatever precedes the chunks must reach the file first.
+  flush();
+
+  std::vector<std::thread> workers;
+  const size_t thread_count = std::min<size_t>(_threads, chunk_count);
+  for (size_t i = 0; i < thread_count; ++i) {
+    workers.emplace_back(work);
+  }
+
+  std::exception_ptr error;
+  for (size_t i = 0; i < chunk_count && !error; ++i) {
+    Chunk& chunk = chunks[i];
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&] { return chunk.done; });
+    }
+    error = chunk.error;
+    if (!error) {
+      // The workers must be joined before a write error leaves.
+      try {
+        writeOutput(chunk.data, chunk.size);
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+    free(chunk.data);
+    chunk.data = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      written = i + 1;
+    }
+    cv.notify_all();
   }
+
   {
-    delete _select_inst_map;
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  cv.notify_all();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (Chunk& chunk : chunks) {
+    free(chunk.data);
+  }
+  if (error) {
+    std::rethrow_exception(error);
   }
-  return true;
 }
 
 void defout_impl::writeRows(dbBlock* block)
@@ -531,12 +805,16 @@ void defout_impl::writeInsts(dbBlock* block)
   fprintf(_out, "COMPONENTS %u ;\n", insts.size());
 
   // Sort the components for consistent output
+  std::vector<dbInst*> selected;
   for (dbInst* inst : sortedSet(insts)) {
     if (_select_inst_map && !(*_select_inst_map)[inst]) {
       continue;
     }
-    writeInst(inst);
+    selected.push_back(inst);
   }
+  writeChunked(selected.size(), [&selected](defout_impl& writer, size_t i) {
+    writer.writeInst(selected[i]);
+  });
 
   fprintf(_out, "END COMPONENTS\n");
 }
@@ -1411,15 +1689,10 @@ void defout_impl::writeNets(dbBlock* block)
 {
   dbSet<dbNet> nets = block->getNets();
 
-  int net_cnt = 0;
-  int snet_cnt = 0;
+  std::vector<dbNet*> special_nets;
+  std::vector<dbNet*> regular_nets;
 
-  dbSet<dbNet>::iterator itr;
-  dbMap<dbNet, char> regular_net(nets);
-
-  auto sorted_nets = sortedSet(nets);
-
-  for (dbNet* net : sorted_nets) {
+  for (dbNet* net : sortedSet(nets)) {
     if (_select_net_map) {
       if (!(*_select_net_map)[net]) {
         continue;
@@ -1427,49 +1700,37 @@ void defout_impl::writeNets(dbBlock* block)
     }
 
     if (!net->isSpecial()) {
-      regular_net[net] = 1;
-      net_cnt++;
+      regular_nets.push_back(net);
     } else {
-      regular_net[net] = 0;
-      snet_cnt++;
+      special_nets.push_back(net);
 
       // Check for non-special iterms.
       for (dbITerm* iterm : net->getITerms()) {
         if (!iterm->isSpecial()) {
-          regular_net[net] = 1;
-          net_cnt++;
+          regular_nets.push_back(net);
           break;
         }
       }
     }
   }
 
-  if (snet_cnt > 0) {
-    fprintf(_out, "SPECIALNETS %d ;\n", snet_cnt);
+  if (!special_nets.empty()) {
+    fprintf(_out, "SPECIALNETS %zu ;\n", special_nets.size());
 
-    for (dbNet* net : sorted_nets) {
-      if (_select_net_map && !(*_select_net_map)[net]) {
-        continue;
-      }
-      if (net->isSpecial()) {
-        writeSNet(net);
-      }
-    }
+    writeChunked(special_nets.size(),
+                 [&special_nets](defout_impl& writer, size_t i) {
+                   writer.writeSNet(special_nets[i]);
+                 });
 
     fprintf(_out, "END SPECIALNETS\n");
   }
 
-  fprintf(_out, "NETS %d ;\n", net_cnt);
+  fprintf(_out, "NETS %zu ;\n", regular_nets.size());
 
-  for (dbNet* net : sorted_nets) {
-    if (_select_net_map && !(*_select_net_map)[net]) {
-      continue;
-    }
-
-    if (regular_net[net] == 1) {
-      writeNet(net);
-    }
-  }
+  writeChunked(regular_nets.size(),
+               [&regular_nets](defout_impl& writer, size_t i) {
+                 writer.writeNet(regular_nets[i]);
+               });
 
   fprintf(_out, "END NETS\n");
 }
@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <functional>
 #include <list>
 #include <map>
 #include <string>
@@ -44,6 +45,8 @@ namespace utl {
 class Logger;
 }
 
+struct gzFile_s;
+
 namespace odb {
 
 class dbBlock;
@@ -69,6 +72,12 @@ class defout_impl
 
   double _dist_factor;
   FILE* _out;
+  // For .gz files, _out is a memory buffer that flush() compresses into
+  // _gz_file.
+  gzFile_s* _gz_file;
+  char* _gz_buffer;
+  size_t _gz_buffer_size;
+  int _threads;
   bool _use_net_inst_ids;
   bool _use_master_ids;
   bool _use_alias;
@@ -115,12 +124,22 @@ class defout_impl
   void writeProperties(dbObject* object);
   void writePinProperties(dbBlock* block);
   bool hasProperties(dbObject* object, ObjType type);
+  void writeChunked(size_t count,
+                    const std::function<void(defout_impl&, size_t)>& write);
+  void writeSections(dbBlock* block);
+  void writeOutput(const char* data, size_t size);
+  void flush();
+  void abandonOutput();
 
  public:
   defout_impl(utl::Logger* logger)
   {
     _dist_factor = 0;
     _out = nullptr;
+    _gz_file = nullptr;
+    _gz_buffer = nullptr;
+    _gz_buffer_size = 0;
+    _threads = 1;
     _use_net_inst_ids = false;
     _use_master_ids = false;
     _use_alias = false;
@@ -143,6 +162,8 @@ class defout_impl
 
   void selectInst(dbInst* inst);
   void setVersion(int v) { _version = v; }
+  void setThreads(int threads) { _threads = threads; }
+  static void setChunkSize(size_t objects);
 
   bool writeBlock(dbBlock* block, const char* def_file);
 };
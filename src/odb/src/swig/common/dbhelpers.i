@@ -35,6 +35,10 @@ int write_macro_lef(odb::dbLib* lib, const char* path);
 
 odb::dbChip* read_def(odb::dbTech* tech, std::string path);
 
+void set_def_parallel_nets_min_bytes(int bytes);
+
+void set_def_write_chunk_size(int objects);
+
 int write_def(odb::dbBlock* block,
               const char* path,
               odb::defout::Version version = odb::defout::Version::DEF_5_8);
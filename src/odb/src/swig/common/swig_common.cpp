@@ -117,6 +117,16 @@ odb::dbChip* read_def(odb::dbTech* tech, std::string path)
   return defParser.createChip(libs, path.c_str(), tech);
 }
 
+void set_def_parallel_nets_min_bytes(int bytes)
+{
+  odb::defin::setParallelNetsMinBytes(bytes);
+}
+
+void set_def_write_chunk_size(int objects)
+{
+  odb::defout::setChunkSize(objects);
+}
+
 int write_def(odb::dbBlock* block,
               const char* path,
               odb::defout::Version version)
@@ -0,0 +1,58 @@
+# read_db -lazy of a routed design with parasitics and fills
+source "helpers.tcl"
+
+read_lef "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+read_def "data/gcd/gcd_nangate45_route.def"
+
+define_process_corner -ext_model_index 0 X
+extract_parasitics -ext_model_file Nangate45/Nangate45.rcx_rules
+
+set db [ord::get_db]
+set block [ord::get_db_block]
+set metal1 [[$db getTech] findLayer metal1]
+for {set i 0} {$i < 10} {incr i} {
+  set x [expr 10000 + $i * 2000]
+  odb::dbFill_create $block 0 0 $metal1 $x 10000 [expr $x + 1000] 11000
+}
+
+set db_file [make_result_file read_db_lazy.odb]
+write_db $db_file
+
+set full_db [odb::dbDatabase_create]
+odb::read_db $full_db $db_file
+set full_block [[$full_db getChip] getBlock]
+
+odb::dbChip_destroy [$db getChip]
+read_db -lazy $db_file
+set lazy_block [ord::get_db_block]
+
+if { [llength [$lazy_block getFills]] != [llength [$full_block getFills]] } {
+  puts "FAIL: Fill counts differ"
+  exit 1
+}
+set rseg_count 0
+foreach net [$lazy_block getNets] {
+  set full_net [$full_block findNet [$net getName]]
+  set rsegs [llength [$net getRSegs]]
+  if { $rsegs != [llength [$full_net getRSegs]] } {
+    puts "FAIL: RSeg counts differ on [$net getName]"
+    exit 1
+  }
+  if { [llength [$net getCapNodes]] != [llength [$full_net getCapNodes]] } {
+    puts "FAIL: CapNode counts differ on [$net getName]"
+    exit 1
+  }
+  incr rseg_count $rsegs
+}
+if { $rseg_count == 0 } {
+  puts "FAIL: No parasitics were extracted"
+  exit 1
+}
+
+if { [odb::db_diff $full_db [ord::get_db]] } {
+  puts "FAIL: Differences found between the lazy and full reads"
+  exit 1
+}
+
+puts "pass"
+exit 0
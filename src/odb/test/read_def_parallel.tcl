@@ -0,0 +1,16 @@
+# read_def with the NETS section parsed on several threads
+source "helpers.tcl"
+
+read_lef "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+
+# Parse the small NETS section of this design in parallel. The debug
+# message shows that the parallel reader ran.
+odb::set_def_parallel_nets_min_bytes 0
+set_thread_count 4
+set_debug_level ODB defin 1
+read_def "data/gcd/gcd_nangate45_route.def"
+set_debug_level ODB defin 0
+
+# db_def_diff reads the DEF serially into a copy of the db.
+set diff [odb::db_def_diff [ord::get_db] "data/gcd/gcd_nangate45_route.def"]
+puts "parallel and serial reads differ: $diff"
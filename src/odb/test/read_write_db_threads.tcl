@@ -0,0 +1,33 @@
+# write_db/read_db on several threads, starting from an older schema db
+source "helpers.tcl"
+
+# data/design.odb predates the compressed block sections.
+set old_db [odb::dbDatabase_create]
+odb::read_db $old_db "data/design.odb"
+if {[$old_db getChip] == "NULL"} {
+    puts "FAIL: Read of the older schema db failed"
+    exit 1
+}
+
+set serial_file [make_result_file read_write_db_threads1.odb]
+odb::write_db $old_db $serial_file
+
+set_thread_count 4
+read_db $serial_file
+set db [ord::get_db]
+if { [odb::db_diff $old_db $db] } {
+  puts "FAIL: Differences found after the threaded read"
+  exit 1
+}
+
+set threads_file [make_result_file read_write_db_threads4.odb]
+write_db $threads_file
+set new_db [odb::dbDatabase_create]
+odb::read_db $new_db $threads_file
+if { [odb::db_diff $db $new_db] } {
+  puts "FAIL: Differences found after the threaded write"
+  exit 1
+}
+
+puts "pass"
+exit 0
@@ -13,6 +13,7 @@ record_tests {
   dump_via_rules
   dump_vias
   read_def
+  read_def_parallel
   read_def58
   write_def58
   dump_nets
@@ -27,6 +28,7 @@ record_tests {
   edit_via_params
   row_settings
   db_read_write
+  read_write_db_threads
   check_routing_tracks
   polygon
   def_parser
@@ -45,5 +47,8 @@ record_pass_fail_tests {
   dump_netlists
   dump_netlists_withfill
   parser_unit_test
+  read_db_lazy
+  write_def_gz
+  write_def_threads
 }
 
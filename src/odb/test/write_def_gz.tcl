@@ -0,0 +1,17 @@
+# write_def of a compressed DEF read back with read_def
+source "helpers.tcl"
+
+read_lef "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+read_def "data/gcd/gcd_nangate45_route.def"
+
+set def_file [make_result_file write_def_gz.def.gz]
+write_def $def_file
+
+# db_def_diff reads the DEF into a copy of the db.
+if { [odb::db_def_diff [ord::get_db] $def_file] } {
+  puts "FAIL: Differences found after reading back $def_file"
+  exit 1
+}
+
+puts "pass"
+exit 0
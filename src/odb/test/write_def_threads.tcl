@@ -0,0 +1,35 @@
+# write_def on several threads matches the serial write
+source "helpers.tcl"
+
+read_lef "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+read_def "data/gcd/gcd_nangate45_route.def"
+
+# One object per chunk, so even the 2 SPECIALNETS are split across threads.
+odb::set_def_write_chunk_size 1
+
+set serial_file [make_result_file write_def_threads1.def]
+set serial_gz_file [make_result_file write_def_threads1.def.gz]
+set_thread_count 1
+write_def $serial_file
+write_def $serial_gz_file
+
+set threads_file [make_result_file write_def_threads4.def]
+set threads_gz_file [make_result_file write_def_threads4.def.gz]
+set_thread_count 4
+write_def $threads_file
+write_def $threads_gz_file
+
+if { [diff_files $serial_file $threads_file] } {
+  puts "FAIL: Differences found between the serial and threaded writes"
+  exit 1
+}
+
+foreach def_file [list $serial_gz_file $threads_gz_file] {
+  if { [odb::db_def_diff [ord::get_db] $def_file] } {
+    puts "FAIL: Differences found after reading back $def_file"
+    exit 1
+  }
+}
+
+puts "pass"
+exit 0
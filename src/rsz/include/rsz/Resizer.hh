@@ -38,6 +38,7 @@
 #include <array>
 #include <optional>
 #include <string>
+#include <unordered_map>
 
 #include "db_sta/dbSta.hh"
 #include "dpl/Opendp.h"
@@ -164,6 +165,26 @@ struct ParasiticsCapacitance
   double v_cap;
 };
 
+// Wire parasitics of one Steiner tree branch for one corner.
+struct SteinerBranchRc
+{
+  double length;  // meters, zero for branches between coincident points
+  double res;
+  double cap;
+};
+
+// Steiner tree and wire parasitics of a net, built by the estimation worker
+// threads and then written to the parasitics database on the main thread.
+struct SteinerWireRc
+{
+  const Pin* drvr_pin = nullptr;
+  const Net* net = nullptr;
+  bool is_clk = false;
+  SteinerTree* tree = nullptr;
+  // Indexed by corner, then by tree branch.
+  vector<vector<SteinerBranchRc>> branch_rc;
+};
+
 struct BufferData
 {
   // Need to use strings because object pointers may not be persistent after
@@ -236,8 +257,12 @@ class Resizer : public dbStaState
   double wireClkVCapacitance(const Corner* corner) const;
   void estimateParasitics(ParasiticsSrc src);
   void estimateWireParasitics();
-  void estimateWireParasitic(const Net* net);
-  void estimateWireParasitic(const Pin* drvr_pin, const Net* net);
+  // Wires longer than max_wire_length (meters, if non-zero) are estimated
+  // as if they had been split by evenly spaced buffers.
+  void estimateWireParasitic(const Net* net, double max_wire_length = 0.0);
+  void estimateWireParasitic(const Pin* drvr_pin,
+                             const Net* net,
+                             double max_wire_length = 0.0);
   bool haveEstimatedParasitics() const;
   void parasiticsInvalid(const Net* net);
   void parasiticsInvalid(const dbNet* net);
@@ -281,9 +306,12 @@ class Resizer : public dbStaState
                    bool skip_pin_swap,
                    bool skip_gate_cloning,
                    bool skip_buffering,
-                   bool skip_buffer_removal);
+                   bool skip_buffer_removal,
+                   bool speculative_sizing);
   // For testing.
   void repairSetup(const Pin* end_pin);
+  // For testing. Returns the number of instances resized.
+  int repairSetupSpeculative();
   // For testing.
   void reportSwappablePins();
   // Rebuffer one net (for testing).
@@ -377,6 +405,13 @@ class Resizer : public dbStaState
   // resizeSlackPreamble must be called before the first findResizeSlacks.
   void resizeSlackPreamble();
   void findResizeSlacks();
+  // Cheaper alternative to findResizeSlacks that does not touch the netlist.
+  // Long wires are estimated as if repair_design had buffered them and only
+  // nets with pins that moved since the last call are re-estimated.
+  void estimateResizeSlacks();
+  // Re-estimate the parasitics left by estimateResizeSlacks without the
+  // virtual buffers once timing driven placement is done with them.
+  void estimateResizeSlacksEnd();
   // Return nets with worst slack.
   NetSeq& resizeWorstSlackNets();
   // Return net slack, if any (indicated by the bool).
@@ -561,7 +596,13 @@ class Resizer : public dbStaState
   void updateParasitics(bool save_guides = false);
   void ensureWireParasitic(const Pin* drvr_pin);
   void ensureWireParasitic(const Pin* drvr_pin, const Net* net);
-  void estimateWireParasiticSteiner(const Pin* drvr_pin, const Net* net);
+  void estimateWireParasitics(const vector<const Net*>& nets,
+                              double max_wire_length);
+  void estimateWireParasiticSteiner(const Pin* drvr_pin,
+                                    const Net* net,
+                                    double max_wire_length);
+  void findSteinerWireRc(SteinerWireRc& wire_rc, double max_wire_length);
+  void makeSteinerWireParasitic(const SteinerWireRc& wire_rc);
   float totalLoad(SteinerTree* tree) const;
   float subtreeLoad(SteinerTree* tree,
                     float cap_per_micron,
@@ -582,6 +623,7 @@ class Resizer : public dbStaState
                    bool journal);
 
   void findResizeSlacks1();
+  void netPinLocations(const Net* net, vector<Point>& locations) const;
   bool removeBuffer(Instance* buffer,
                     bool honorDontTouchFixed = true,
                     bool recordJournal = false);
@@ -713,6 +755,8 @@ class Resizer : public dbStaState
   float worst_slack_nets_percent_ = 10;
   Map<const Net*, Slack> net_slack_map_;
   NetSeq worst_slack_nets_;
+  // Pin locations of each net at the last estimateResizeSlacks.
+  std::unordered_map<const Net*, vector<Point>> resize_slack_pin_locs_;
 
   // Journal to roll back changes (OpenDB not up to the task).
   Map<Instance*, LibertyCell*> resized_inst_map_;
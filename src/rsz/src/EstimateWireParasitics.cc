@@ -33,6 +33,9 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cmath>
+
 #include "SteinerTree.hh"
 #include "db_sta/dbNetwork.hh"
 #include "grt/GlobalRouter.h"
@@ -44,7 +47,9 @@
 #include "sta/Report.hh"
 #include "sta/Sdc.hh"
 #include "sta/Units.hh"
+#include "stt/flute.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace rsz {
 
@@ -394,29 +399,112 @@ void Resizer::estimateWireParasitics()
     // Make separate parasitics for each corner, same for min/max.
     sta_->setParasiticAnalysisPts(true);
 
+    vector<const Net*> nets;
     NetIterator* net_iter = network_->netIterator(network_->topInstance());
     while (net_iter->hasNext()) {
-      Net* net = net_iter->next();
-      estimateWireParasitic(net);
+      nets.push_back(net_iter->next());
     }
     delete net_iter;
+    estimateWireParasitics(nets, 0.0);
 
     parasitics_src_ = ParasiticsSrc::placement;
     parasitics_invalid_.clear();
   }
 }
 
-void Resizer::estimateWireParasitic(const Net* net)
+// Nets are processed in chunks to bound the number of Steiner trees alive.
+static constexpr int steiner_wire_chunk_size = 16384;
+
+void Resizer::estimateWireParasitics(const vector<const Net*>& nets,
+                                     double max_wire_length)
+{
+  const int thread_count = sta_->threadCount();
+  if (thread_count <= 1) {
+    for (const Net* net : nets) {
+      estimateWireParasitic(net, max_wire_length);
+    }
+    return;
+  }
+
+  // Steiner trees and their RC are independent per net so they are built by
+  // the worker threads. Everything that touches the sta or the parasitics
+  // database stays on this thread.
+  stt::flt::ensureLUT();
+  vector<SteinerWireRc> wire_rcs;
+  for (size_t begin = 0; begin < nets.size();
+       begin += steiner_wire_chunk_size) {
+    const size_t end = std::min(nets.size(), begin + steiner_wire_chunk_size);
+    wire_rcs.clear();
+    for (size_t i = begin; i < end; i++) {
+      const Net* net = nets[i];
+      PinSet* drivers = network_->drivers(net);
+      if (drivers == nullptr || drivers->empty()) {
+        continue;
+      }
+      PinSet::Iterator drvr_iter(drivers);
+      const Pin* drvr_pin = drvr_iter.next();
+      if (network_->isPower(net) || network_->isGround(net)
+          || sta_->isIdealClock(drvr_pin)
+          || db_network_->staToDb(net)->isSpecial()) {
+        continue;
+      }
+      if (isPadNet(net)) {
+        makePadParasitic(net);
+        continue;
+      }
+      SteinerWireRc wire_rc;
+      wire_rc.drvr_pin = drvr_pin;
+      wire_rc.net = net;
+      wire_rc.is_clk
+          = global_router_->isNonLeafClock(db_network_->staToDb(net));
+      wire_rcs.push_back(std::move(wire_rc));
+    }
+
+    // Steiner tree errors are reported with logger errors, which throw.
+    // They are caught in the workers and rethrown on this thread.
+    const int wire_count = wire_rcs.size();
+    utl::ThreadException exception;
+#pragma omp parallel for num_threads(thread_count) schedule(dynamic, 64)
+    for (int i = 0; i < wire_count; i++) {
+      try {
+        SteinerWireRc& wire_rc = wire_rcs[i];
+        wire_rc.tree = makeSteinerTree(wire_rc.drvr_pin);
+        if (wire_rc.tree) {
+          findSteinerWireRc(wire_rc, max_wire_length);
+        }
+      } catch (...) {
+        exception.capture();
+      }
+    }
+    if (exception.hasException()) {
+      for (SteinerWireRc& wire_rc : wire_rcs) {
+        delete wire_rc.tree;
+      }
+      exception.rethrow();
+    }
+
+    for (SteinerWireRc& wire_rc : wire_rcs) {
+      if (wire_rc.tree) {
+        makeSteinerWireParasitic(wire_rc);
+        delete wire_rc.tree;
+      }
+    }
+  }
+}
+
+void Resizer::estimateWireParasitic(const Net* net, double max_wire_length)
 {
   PinSet* drivers = network_->drivers(net);
   if (drivers && !drivers->empty()) {
     PinSet::Iterator drvr_iter(drivers);
     const Pin* drvr_pin = drvr_iter.next();
-    estimateWireParasitic(drvr_pin, net);
+    estimateWireParasitic(drvr_pin, net, max_wire_length);
   }
 }
 
-void Resizer::estimateWireParasitic(const Pin* drvr_pin, const Net* net)
+void Resizer::estimateWireParasitic(const Pin* drvr_pin,
+                                    const Net* net,
+                                    double max_wire_length)
 {
   if (!network_->isPower(net) && !network_->isGround(net)
       && !sta_->isIdealClock(drvr_pin)
@@ -427,7 +515,7 @@ void Resizer::estimateWireParasitic(const Pin* drvr_pin, const Net* net)
       // wire capacitance to prevent wireload model parasitics from being used.
       makePadParasitic(net);
     } else {
-      estimateWireParasiticSteiner(drvr_pin, net);
+      estimateWireParasiticSteiner(drvr_pin, net, max_wire_length);
     }
   }
 }
@@ -463,90 +551,145 @@ void Resizer::makePadParasitic(const Net* net)
   parasitics_->deleteParasiticNetworks(net);
 }
 
-void Resizer::estimateWireParasiticSteiner(const Pin* drvr_pin, const Net* net)
-{
-  SteinerTree* tree = makeSteinerTree(drvr_pin);
-  if (tree) {
-    debugPrint(logger_,
-               RSZ,
-               "resizer_parasitics",
-               1,
-               "estimate wire {}",
-               sdc_network_->pathName(net));
-    for (Corner* corner : *sta_->corners()) {
-      const ParasiticAnalysisPt* parasitics_ap
-          = corner->findParasiticAnalysisPt(max_);
-      Parasitic* parasitic
-          = sta_->makeParasiticNetwork(net, false, parasitics_ap);
-      bool is_clk = global_router_->isNonLeafClock(db_network_->staToDb(net));
-      double wire_cap = 0.0;
-      double wire_res = 0.0;
-      int branch_count = tree->branchCount();
-      size_t resistor_id = 1;
-      for (int i = 0; i < branch_count; i++) {
-        Point pt1, pt2;
-        SteinerPt steiner_pt1, steiner_pt2;
-        int wire_length_dbu;
-        tree->branch(i, pt1, steiner_pt1, pt2, steiner_pt2, wire_length_dbu);
-        if (wire_length_dbu) {
-          double dx = dbuToMeters(abs(pt1.x() - pt2.x()))
-                      / dbuToMeters(wire_length_dbu);
-          double dy = dbuToMeters(abs(pt1.y() - pt2.y()))
-                      / dbuToMeters(wire_length_dbu);
-
-          if (is_clk) {
-            wire_cap = dx * wireClkHCapacitance(corner)
-                       + dy * wireClkVCapacitance(corner);
-            wire_res = dx * wireClkHResistance(corner)
-                       + dy * wireClkVResistance(corner);
-          } else {
-            wire_cap = dx * wireSignalHCapacitance(corner)
-                       + dy * wireSignalVCapacitance(corner);
-            wire_res = dx * wireSignalHResistance(corner)
-                       + dy * wireSignalVResistance(corner);
-          }
-        } else {
-          wire_cap = is_clk ? wireClkCapacitance(corner)
-                            : wireSignalCapacitance(corner);
-          wire_res = is_clk ? wireClkResistance(corner)
-                            : wireSignalResistance(corner);
-        }
-        ParasiticNode* n1 = parasitics_->ensureParasiticNode(
-            parasitic, net, steiner_pt1, network_);
-        ParasiticNode* n2 = parasitics_->ensureParasiticNode(
-            parasitic, net, steiner_pt2, network_);
-        if (wire_length_dbu == 0) {
-          // Use a small resistor to keep the connectivity intact.
-          parasitics_->makeResistor(parasitic, resistor_id++, 1.0e-3, n1, n2);
+void Resizer::estimateWireParasiticSteiner(const Pin* drvr_pin,
+                                           const Net* net,
+                                           double max_wire_length)
+{
+  SteinerWireRc wire_rc;
+  wire_rc.drvr_pin = drvr_pin;
+  wire_rc.net = net;
+  wire_rc.is_clk = global_router_->isNonLeafClock(db_network_->staToDb(net));
+  wire_rc.tree = makeSteinerTree(drvr_pin);
+  if (wire_rc.tree) {
+    findSteinerWireRc(wire_rc, max_wire_length);
+    makeSteinerWireParasitic(wire_rc);
+    delete wire_rc.tree;
+  }
+}
+
+// Only reads the tree and the wire RC so it is safe to call from
+// several threads.
+void Resizer::findSteinerWireRc(SteinerWireRc& wire_rc, double max_wire_length)
+{
+  SteinerTree* tree = wire_rc.tree;
+  const bool is_clk = wire_rc.is_clk;
+  int branch_count = tree->branchCount();
+  // A wire cut into k equal buffered segments sees 1/k of the wire
+  // capacitance at each driver, so the total Elmore delay and the
+  // driver load both drop by k. Buffer intrinsic delay is ignored.
+  double cap_scale = 1.0;
+  if (max_wire_length > 0.0) {
+    int tree_length_dbu = 0;
+    for (int i = 0; i < branch_count; i++) {
+      Point pt1, pt2;
+      SteinerPt steiner_pt1, steiner_pt2;
+      int wire_length_dbu;
+      tree->branch(i, pt1, steiner_pt1, pt2, steiner_pt2, wire_length_dbu);
+      tree_length_dbu += wire_length_dbu;
+    }
+    const double segments
+        = std::ceil(dbuToMeters(tree_length_dbu) / max_wire_length);
+    if (segments > 1.0) {
+      cap_scale = 1.0 / segments;
+    }
+  }
+
+  wire_rc.branch_rc.resize(sta_->corners()->count());
+  for (Corner* corner : *sta_->corners()) {
+    vector<SteinerBranchRc>& branch_rc = wire_rc.branch_rc[corner->index()];
+    branch_rc.resize(branch_count);
+    double wire_cap = 0.0;
+    double wire_res = 0.0;
+    for (int i = 0; i < branch_count; i++) {
+      Point pt1, pt2;
+      SteinerPt steiner_pt1, steiner_pt2;
+      int wire_length_dbu;
+      tree->branch(i, pt1, steiner_pt1, pt2, steiner_pt2, wire_length_dbu);
+      if (wire_length_dbu) {
+        double dx = dbuToMeters(abs(pt1.x() - pt2.x()))
+                    / dbuToMeters(wire_length_dbu);
+        double dy = dbuToMeters(abs(pt1.y() - pt2.y()))
+                    / dbuToMeters(wire_length_dbu);
+
+        if (is_clk) {
+          wire_cap = dx * wireClkHCapacitance(corner)
+                     + dy * wireClkVCapacitance(corner);
+          wire_res = dx * wireClkHResistance(corner)
+                     + dy * wireClkVResistance(corner);
         } else {
-          double length = dbuToMeters(wire_length_dbu);
-          double cap = length * wire_cap;
-          double res = length * wire_res;
-          // Make pi model for the wire.
-          debugPrint(logger_,
-                     RSZ,
-                     "resizer_parasitics",
-                     2,
-                     " pi {} l={} c2={} rpi={} c1={} {}",
-                     parasitics_->name(n1),
-                     units_->distanceUnit()->asString(length),
-                     units_->capacitanceUnit()->asString(cap / 2.0),
-                     units_->resistanceUnit()->asString(res),
-                     units_->capacitanceUnit()->asString(cap / 2.0),
-                     parasitics_->name(n2));
-          parasitics_->incrCap(n1, cap / 2.0);
-          parasitics_->makeResistor(parasitic, resistor_id++, res, n1, n2);
-          parasitics_->incrCap(n2, cap / 2.0);
+          wire_cap = dx * wireSignalHCapacitance(corner)
+                     + dy * wireSignalVCapacitance(corner);
+          wire_res = dx * wireSignalHResistance(corner)
+                     + dy * wireSignalVResistance(corner);
         }
-        parasiticNodeConnectPins(parasitic, n1, tree, steiner_pt1, resistor_id);
-        parasiticNodeConnectPins(parasitic, n2, tree, steiner_pt2, resistor_id);
+        double length = dbuToMeters(wire_length_dbu);
+        branch_rc[i]
+            = {length, length * wire_res, length * wire_cap * cap_scale};
+      } else {
+        branch_rc[i] = {0.0, 0.0, 0.0};
+      }
+    }
+  }
+}
+
+void Resizer::makeSteinerWireParasitic(const SteinerWireRc& wire_rc)
+{
+  const Net* net = wire_rc.net;
+  SteinerTree* tree = wire_rc.tree;
+  debugPrint(logger_,
+             RSZ,
+             "resizer_parasitics",
+             1,
+             "estimate wire {}",
+             sdc_network_->pathName(net));
+  for (Corner* corner : *sta_->corners()) {
+    const ParasiticAnalysisPt* parasitics_ap
+        = corner->findParasiticAnalysisPt(max_);
+    Parasitic* parasitic
+        = sta_->makeParasiticNetwork(net, false, parasitics_ap);
+    const vector<SteinerBranchRc>& branch_rc
+        = wire_rc.branch_rc[corner->index()];
+    int branch_count = tree->branchCount();
+    size_t resistor_id = 1;
+    for (int i = 0; i < branch_count; i++) {
+      Point pt1, pt2;
+      SteinerPt steiner_pt1, steiner_pt2;
+      int wire_length_dbu;
+      tree->branch(i, pt1, steiner_pt1, pt2, steiner_pt2, wire_length_dbu);
+      ParasiticNode* n1 = parasitics_->ensureParasiticNode(
+          parasitic, net, steiner_pt1, network_);
+      ParasiticNode* n2 = parasitics_->ensureParasiticNode(
+          parasitic, net, steiner_pt2, network_);
+      if (wire_length_dbu == 0) {
+        // Use a small resistor to keep the connectivity intact.
+        parasitics_->makeResistor(parasitic, resistor_id++, 1.0e-3, n1, n2);
+      } else {
+        double length = branch_rc[i].length;
+        double cap = branch_rc[i].cap;
+        double res = branch_rc[i].res;
+        // Make pi model for the wire.
+        debugPrint(logger_,
+                   RSZ,
+                   "resizer_parasitics",
+                   2,
+                   " pi {} l={} c2={} rpi={} c1={} {}",
+                   parasitics_->name(n1),
+                   units_->distanceUnit()->asString(length),
+                   units_->capacitanceUnit()->asString(cap / 2.0),
+                   units_->resistanceUnit()->asString(res),
+                   units_->capacitanceUnit()->asString(cap / 2.0),
+                   parasitics_->name(n2));
+        parasitics_->incrCap(n1, cap / 2.0);
+        parasitics_->makeResistor(parasitic, resistor_id++, res, n1, n2);
+        parasitics_->incrCap(n2, cap / 2.0);
       }
-      arc_delay_calc_->reduceParasitic(
-          parasitic, net, corner, sta::MinMaxAll::all());
+      parasiticNodeConnectPins(parasitic, n1, tree, steiner_pt1, resistor_id);
+      parasiticNodeConnectPins(parasitic, n2, tree, steiner_pt2, resistor_id);
     }
-    parasitics_->deleteParasiticNetworks(net);
-    delete tree;
+    arc_delay_calc_->reduceParasitic(
+        parasitic, net, corner, sta::MinMaxAll::all());
   }
+  parasitics_->deleteParasiticNetworks(net);
 }
 
 float Resizer::pinCapacitance(const Pin* pin,
@@ -51,6 +51,8 @@
 #include "sta/Search.hh"
 #include "sta/SearchPred.hh"
 #include "sta/Units.hh"
+#include "stt/flute.h"
+#include "utl/exception.h"
 
 namespace rsz {
 
@@ -168,42 +170,54 @@ void RepairDesign::repairDesign(
     printProgress(print_iteration, false, false, repaired_net_count);
   }
   int max_length = resizer_->metersToDbu(max_wire_length);
-  for (int i = resizer_->level_drvr_vertices_.size() - 1; i >= 0; i--) {
-    print_iteration++;
-    if (verbose) {
-      printProgress(print_iteration, false, false, repaired_net_count);
+  const int thread_count = sta_->threadCount();
+  const int drvr_count = resizer_->level_drvr_vertices_.size();
+  for (int batch_end = drvr_count; batch_end > 0;
+       batch_end -= plan_batch_size_) {
+    const int batch_begin = max(0, batch_end - plan_batch_size_);
+    if (thread_count > 1) {
+      planBufferedNets(batch_begin, batch_end, thread_count);
     }
-    Vertex* drvr = resizer_->level_drvr_vertices_[i];
-    Pin* drvr_pin = drvr->pin();
-    Net* net = network_->isTopLevelPort(drvr_pin)
-                   ? network_->net(network_->term(drvr_pin))
-                   : network_->net(drvr_pin);
-    dbNet* net_db = db_network_->staToDb(net);
-    bool debug = (drvr_pin == resizer_->debug_pin_);
-    if (debug) {
-      logger_->setDebugLevel(RSZ, "repair_net", 3);
-    }
-    if (net && !resizer_->dontTouch(net) && !net_db->isConnectedByAbutment()
-        && !sta_->isClock(drvr_pin)
-        // Exclude tie hi/low cells and supply nets.
-        && !drvr->isConstant()) {
-      repairNet(net,
-                drvr_pin,
-                drvr,
-                true,
-                true,
-                true,
-                max_length,
-                true,
-                repaired_net_count,
-                slew_violations,
-                cap_violations,
-                fanout_violations,
-                length_violations);
-    }
-    if (debug) {
-      logger_->setDebugLevel(RSZ, "repair_net", 0);
+    for (int i = batch_end - 1; i >= batch_begin; i--) {
+      print_iteration++;
+      if (verbose) {
+        printProgress(print_iteration, false, false, repaired_net_count);
+      }
+      Vertex* drvr = resizer_->level_drvr_vertices_[i];
+      Pin* drvr_pin = drvr->pin();
+      Net* net = network_->isTopLevelPort(drvr_pin)
+                     ? network_->net(network_->term(drvr_pin))
+                     : network_->net(drvr_pin);
+      dbNet* net_db = db_network_->staToDb(net);
+      bool debug = (drvr_pin == resizer_->debug_pin_);
+      if (debug) {
+        logger_->setDebugLevel(RSZ, "repair_net", 3);
+      }
+      if (net && !resizer_->dontTouch(net) && !net_db->isConnectedByAbutment()
+          && !sta_->isClock(drvr_pin)
+          // Exclude tie hi/low cells and supply nets.
+          && !drvr->isConstant()) {
+        batch_drvr_insts_.insert(network_->instance(drvr_pin));
+        repairNet(net,
+                  drvr_pin,
+                  drvr,
+                  true,
+                  true,
+                  true,
+                  max_length,
+                  true,
+                  repaired_net_count,
+                  slew_violations,
+                  cap_violations,
+                  fanout_violations,
+                  length_violations);
+      }
+      if (debug) {
+        logger_->setDebugLevel(RSZ, "repair_net", 0);
+      }
     }
+    planned_bnets_.clear();
+    batch_drvr_insts_.clear();
   }
   resizer_->updateParasitics();
   if (verbose) {
@@ -383,12 +397,14 @@ void RepairDesign::repairNet(Net* net,
                sdc_network_->pathName(drvr_pin));
     const Corner* corner = sta_->cmdCorner();
     bool repaired_net = false;
+    bool repaired_fanout = false;
     if (check_fanout) {
       float fanout, max_fanout, fanout_slack;
       sta_->checkFanout(drvr_pin, max_, fanout, max_fanout, fanout_slack);
       if (max_fanout > 0.0 && fanout_slack < 0.0) {
         fanout_violations++;
         repaired_net = true;
+        repaired_fanout = true;
 
         debugPrint(logger_, RSZ, "repair_net", 3, "fanout violation");
         LoadRegion region = findLoadRegions(drvr_pin, max_fanout);
@@ -405,12 +421,17 @@ void RepairDesign::repairNet(Net* net,
     }
 
     // Resize the driver to normalize slews before repairing limit violations.
+    bool resized_drvr = false;
     if (parasitics_src_ == ParasiticsSrc::placement && resize_drvr) {
-      resize_count_ += resizer_->resizeToTargetSlew(drvr_pin);
+      const int resized = resizer_->resizeToTargetSlew(drvr_pin);
+      resize_count_ += resized;
+      resized_drvr = resized > 0;
     }
     // For tristate nets all we can do is resize the driver.
     if (!resizer_->isTristateDriver(drvr_pin)) {
-      BufferedNetPtr bnet = resizer_->makeBufferedNetSteiner(drvr_pin, corner);
+      // A planned buffered net was built for the old driver cell.
+      BufferedNetPtr bnet = findBufferedNet(
+          net, drvr_pin, corner, repaired_fanout || resized_drvr);
       if (bnet) {
         resizer_->ensureWireParasitic(drvr_pin, net);
         graph_delay_calc_->findDelays(drvr);
@@ -473,6 +494,85 @@ void RepairDesign::repairNet(Net* net,
   }
 }
 
+// Building the buffered nets from Steiner trees only reads the netlist, so
+// the trees for a batch of drivers are built by worker threads ahead of the
+// repairs, which still run one net at a time in level order.
+void RepairDesign::planBufferedNets(int batch_begin,
+                                    int batch_end,
+                                    int thread_count)
+{
+  const Corner* corner = sta_->cmdCorner();
+  vector<const Pin*> drvr_pins;
+  for (int i = batch_end - 1; i >= batch_begin; i--) {
+    Vertex* drvr = resizer_->level_drvr_vertices_[i];
+    const Pin* drvr_pin = drvr->pin();
+    Net* net = network_->isTopLevelPort(drvr_pin)
+                   ? network_->net(network_->term(drvr_pin))
+                   : network_->net(drvr_pin);
+    if (net && !resizer_->dontTouch(net) && !sta_->isClock(drvr_pin)
+        && !drvr->isConstant() && !db_network_->isSpecial(net)
+        && !resizer_->isTristateDriver(drvr_pin)) {
+      drvr_pins.push_back(drvr_pin);
+    }
+  }
+
+  stt::flt::ensureLUT();
+  const int drvr_count = drvr_pins.size();
+  vector<BufferedNetPtr> bnets(drvr_count);
+  // Steiner tree errors are logger errors, which throw. They are caught in
+  // the workers and rethrown on this thread.
+  utl::ThreadException exception;
+#pragma omp parallel for num_threads(thread_count) schedule(dynamic, 16)
+  for (int i = 0; i < drvr_count; i++) {
+    try {
+      bnets[i] = resizer_->makeBufferedNetSteiner(drvr_pins[i], corner);
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+  for (int i = 0; i < drvr_count; i++) {
+    planned_bnets_[drvr_pins[i]] = std::move(bnets[i]);
+  }
+}
+
+// Use the buffered net planned for this batch unless the driver or its loads
+// may have changed since it was built.
+BufferedNetPtr RepairDesign::findBufferedNet(const Net* net,
+                                             const Pin* drvr_pin,
+                                             const Corner* corner,
+                                             bool net_changed)
+{
+  auto planned = planned_bnets_.find(drvr_pin);
+  if (planned != planned_bnets_.end()) {
+    BufferedNetPtr bnet = std::move(planned->second);
+    planned_bnets_.erase(planned);
+    if (!net_changed && !hasBatchDrvrLoad(net)) {
+      return bnet;
+    }
+  }
+  return resizer_->makeBufferedNetSteiner(drvr_pin, corner);
+}
+
+// True if a load of net belongs to an instance whose output was repaired
+// in the current batch, so it may have been resized.
+bool RepairDesign::hasBatchDrvrLoad(const Net* net)
+{
+  bool found = false;
+  NetConnectedPinIterator* pin_iter = network_->connectedPinIterator(net);
+  while (pin_iter->hasNext()) {
+    const Pin* pin = pin_iter->next();
+    if (network_->isLoad(pin)
+        && batch_drvr_insts_.find(network_->instance(pin))
+               != batch_drvr_insts_.end()) {
+      found = true;
+      break;
+    }
+  }
+  delete pin_iter;
+  return found;
+}
+
 bool RepairDesign::needRepairSlew(const Pin* drvr_pin,
                                   int& slew_violations,
                                   float& max_cap,
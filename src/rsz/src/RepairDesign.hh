@@ -35,6 +35,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include "BufferedNet.hh"
 #include "PreChecks.hh"
 #include "db_sta/dbSta.hh"
@@ -151,6 +154,12 @@ class RepairDesign : dbStaState
                  float& slack,
                  const Corner*& corner);
   float bufferInputMaxSlew(LibertyCell* buffer, const Corner* corner) const;
+  void planBufferedNets(int batch_begin, int batch_end, int thread_count);
+  BufferedNetPtr findBufferedNet(const Net* net,
+                                 const Pin* drvr_pin,
+                                 const Corner* corner,
+                                 bool net_changed);
+  bool hasBatchDrvrLoad(const Net* net);
   void repairNet(const BufferedNetPtr& bnet,
                  const Pin* drvr_pin,
                  float max_cap,
@@ -263,10 +272,17 @@ class RepairDesign : dbStaState
 
   int print_interval_ = 0;
 
+  // Buffered nets built ahead of the repairs by planBufferedNets.
+  std::unordered_map<const Pin*, BufferedNetPtr> planned_bnets_;
+  // Driver instances of the nets already repaired in the current batch.
+  std::unordered_set<const Instance*> batch_drvr_insts_;
+
   // Elmore factor for 20-80% slew thresholds.
   static constexpr float elmore_skew_factor_ = 1.39;
   static constexpr int min_print_interval_ = 10;
   static constexpr int max_print_interval_ = 100;
+  // Drivers whose buffered nets are planned together.
+  static constexpr int plan_batch_size_ = 4096;
 };
 
 }  // namespace rsz
@@ -93,7 +93,8 @@ void RepairSetup::repairSetup(const float setup_slack_margin,
                               const bool skip_pin_swap,
                               const bool skip_gate_cloning,
                               const bool skip_buffering,
-                              const bool skip_buffer_removal)
+                              const bool skip_buffer_removal,
+                              const bool speculative_sizing)
 {
   init();
   constexpr int digits = 3;
@@ -170,6 +171,11 @@ void RepairSetup::repairSetup(const float setup_slack_margin,
   if (verbose) {
     printProgress(opto_iteration, false, false, false, num_viols);
   }
+  if (speculative_sizing) {
+    OptoParams params(setup_slack_margin, verbose);
+    repairSetupSpeculative(params);
+    prev_tns = sta_->totalNegativeSlack(max_);
+  }
   float fix_rate_threshold = inc_fix_rate_threshold_;
   for (const auto& end_original_slack : violating_ends) {
     Vertex* end = end_original_slack.first;
@@ -420,6 +426,23 @@ void RepairSetup::repairSetup(const float setup_slack_margin,
 }
 
 // For testing.
+int RepairSetup::repairSetupSpeculative()
+{
+  init();
+  inserted_buffer_count_ = 0;
+  resize_count_ = 0;
+  cloned_gate_count_ = 0;
+  removed_buffer_count_ = 0;
+
+  sta_->checkCapacitanceLimitPreamble();
+  resizer_->incrementalParasiticsBegin();
+  repairSetupSpeculative(OptoParams(0.0, false));
+  // Leave the parasitices up to date.
+  resizer_->updateParasitics();
+  resizer_->incrementalParasiticsEnd();
+  return resize_count_;
+}
+
 void RepairSetup::repairSetup(const Pin* end_pin)
 {
   init();
@@ -1880,4 +1903,284 @@ void RepairSetup::repairSetupLastGasp(const OptoParams& params, int& num_viols)
   }  // for each violating endpoint
 }
 
+// Upsize drivers on many violating paths per timing update. Candidate moves
+// are scored with a liberty only delay model that does not touch the timing
+// graph, so the scoring runs on worker threads. The best moves that do not
+// touch each other's fanin or fanout are committed together and kept only if
+// neither the worst slack nor the tns got worse.
+void RepairSetup::repairSetupSpeculative(const OptoParams& params)
+{
+  constexpr int digits = 3;
+  const int thread_count = sta_->threadCount();
+  sta_->checkSlewLimitPreamble();
+  Slack prev_worst_slack = sta_->worstSlack(max_);
+  float prev_tns = sta_->totalNegativeSlack(max_);
+  for (int pass = 1; pass <= max_speculative_passes_; pass++) {
+    vector<pair<Vertex*, Slack>> violating_ends;
+    for (Vertex* end : *sta_->endpoints()) {
+      const Slack end_slack = sta_->vertexSlack(end, max_);
+      if (end_slack < params.setup_slack_margin) {
+        violating_ends.emplace_back(end, end_slack);
+      }
+    }
+    if (violating_ends.empty()) {
+      break;
+    }
+    std::stable_sort(violating_ends.begin(),
+                     violating_ends.end(),
+                     [](const auto& end_slack1, const auto& end_slack2) {
+                       return end_slack1.second < end_slack2.second;
+                     });
+    vector<Vertex*> ends;
+    for (const auto& [end, ignored] : violating_ends) {
+      ends.push_back(end);
+      if (static_cast<int>(ends.size()) == speculative_end_count_) {
+        break;
+      }
+    }
+
+    vector<SizingMove> moves;
+    findSizingMoves(ends, moves);
+    const int move_count = moves.size();
+#pragma omp parallel for num_threads(thread_count) schedule(dynamic)
+    for (int i = 0; i < move_count; i++) {
+      scoreSizingMove(moves[i]);
+    }
+    std::stable_sort(
+        moves.begin(), moves.end(), [](const auto& move1, const auto& move2) {
+          return move1.gain > move2.gain;
+        });
+
+    // Violations that exist before the batch do not make it worse.
+    std::unordered_set<const Pin*> prev_violations;
+    for (const SizingMove& move : moves) {
+      if (move.cell == nullptr) {
+        break;
+      }
+      std::unordered_set<const Pin*> drvr_pins;
+      addSizingDrvrPins(move.drvr, drvr_pins);
+      for (const Pin* drvr_pin : drvr_pins) {
+        if (!checkMaxCapSlew(drvr_pin)) {
+          prev_violations.insert(drvr_pin);
+        }
+      }
+    }
+
+    resizer_->journalBegin();
+    int committed = 0;
+    std::unordered_set<const Instance*> touched;
+    std::unordered_set<const Pin*> committed_drvr_pins;
+    for (const SizingMove& move : moves) {
+      if (move.cell == nullptr) {
+        break;
+      }
+      if (touched.find(move.drvr) != touched.end()) {
+        continue;
+      }
+      if (resizer_->replaceCell(move.drvr, move.cell, true)) {
+        resize_count_++;
+        committed++;
+        addSizingNeighbors(move.drvr, touched);
+        addSizingDrvrPins(move.drvr, committed_drvr_pins);
+      }
+    }
+    if (committed == 0) {
+      break;
+    }
+
+    resizer_->updateParasitics();
+    sta_->findRequireds();
+    const Slack worst_slack = sta_->worstSlack(max_);
+    const float tns = sta_->totalNegativeSlack(max_);
+    // Larger input pins load the fanin drivers, so the batch must not add
+    // max capacitance or max slew violations around the resized gates.
+    bool new_violation = false;
+    for (const Pin* drvr_pin : committed_drvr_pins) {
+      if (prev_violations.find(drvr_pin) == prev_violations.end()
+          && !checkMaxCapSlew(drvr_pin)) {
+        new_violation = true;
+        break;
+      }
+    }
+    const bool worse = fuzzyLess(worst_slack, prev_worst_slack)
+                       || fuzzyLess(tns, prev_tns) || new_violation;
+    debugPrint(logger_,
+               RSZ,
+               "repair_setup",
+               1,
+               "speculative pass {} resized {} worst_slack = {} tns = {}{} {}",
+               pass,
+               committed,
+               delayAsString(worst_slack, sta_, digits),
+               delayAsString(tns, sta_, digits),
+               new_violation ? " max cap/slew violation" : "",
+               worse ? "restore" : "save");
+    if (worse) {
+      resizer_->journalRestore(resize_count_,
+                               inserted_buffer_count_,
+                               cloned_gate_count_,
+                               removed_buffer_count_);
+      resizer_->updateParasitics();
+      sta_->findRequireds();
+      break;
+    }
+    prev_worst_slack = worst_slack;
+    prev_tns = tns;
+  }
+}
+
+// Collect the upsizable drivers on the worst path to each end.
+// Uses the timing graph so it runs on the main thread.
+void RepairSetup::findSizingMoves(const vector<Vertex*>& ends,
+                                  vector<SizingMove>& moves)
+{
+  std::unordered_set<const Instance*> visited;
+  for (Vertex* end : ends) {
+    PathRef end_path = sta_->vertexWorstSlackPath(end, max_);
+    PathExpanded expanded(&end_path, sta_);
+    const int path_length = expanded.size();
+    if (path_length <= 1) {
+      continue;
+    }
+    const DcalcAnalysisPt* dcalc_ap = end_path.dcalcAnalysisPt(sta_);
+    for (int i = expanded.startIndex(); i < path_length; i++) {
+      const Pin* drvr_pin = expanded.path(i)->pin(sta_);
+      if (i < 1 || !network_->isDriver(drvr_pin)
+          || network_->isTopLevelPort(drvr_pin)) {
+        continue;
+      }
+      Instance* drvr = network_->instance(drvr_pin);
+      LibertyPort* drvr_port = network_->libertyPort(drvr_pin);
+      LibertyPort* in_port
+          = network_->libertyPort(expanded.path(i - 1)->pin(sta_));
+      if (drvr_port == nullptr || in_port == nullptr
+          || resizer_->dontTouch(drvr)
+          || !visited.insert(drvr).second) {
+        continue;
+      }
+      LibertyCellSeq* equiv_cells = sta_->equivCells(drvr_port->libertyCell());
+      if (equiv_cells == nullptr) {
+        continue;
+      }
+      float prev_drive = 0.0;
+      if (i >= 2) {
+        LibertyPort* prev_drvr_port
+            = network_->libertyPort(expanded.path(i - 2)->pin(sta_));
+        if (prev_drvr_port) {
+          prev_drive = prev_drvr_port->driveResistance();
+        }
+      }
+      moves.push_back({drvr,
+                       drvr_port,
+                       in_port,
+                       equiv_cells,
+                       graph_delay_calc_->loadCap(drvr_pin, dcalc_ap),
+                       prev_drive,
+                       dcalc_ap->libertyIndex(),
+                       nullptr,
+                       0.0});
+    }
+  }
+}
+
+// Drive resistance times load plus intrinsic delay, with the input
+// capacitance charged to the previous driver. Only reads the liberty
+// library so it is safe to call from several threads.
+void RepairSetup::scoreSizingMove(SizingMove& move) const
+{
+  const char* drvr_port_name = move.drvr_port->name();
+  const char* in_port_name = move.in_port->name();
+  auto stage_delay = [&](const LibertyPort* drvr_port,
+                         const LibertyPort* in_port) {
+    return drvr_port->driveResistance() * move.load_cap
+           + drvr_port->intrinsicDelay(this)
+           + move.prev_drive * in_port->capacitance();
+  };
+  const float delay = stage_delay(move.drvr_port->cornerPort(move.lib_ap),
+                                  move.in_port->cornerPort(move.lib_ap));
+  LibertyCell* cell = move.drvr_port->libertyCell();
+  for (LibertyCell* equiv : *move.equiv_cells) {
+    if (equiv == cell || resizer_->dontUse(equiv)) {
+      continue;
+    }
+    LibertyCell* equiv_corner = equiv->cornerCell(move.lib_ap);
+    const LibertyPort* equiv_drvr
+        = equiv_corner->findLibertyPort(drvr_port_name);
+    const LibertyPort* equiv_input
+        = equiv_corner->findLibertyPort(in_port_name);
+    if (equiv_drvr == nullptr || equiv_input == nullptr) {
+      continue;
+    }
+    const float gain = delay - stage_delay(equiv_drvr, equiv_input);
+    if (gain > move.gain) {
+      move.gain = gain;
+      move.cell = equiv;
+    }
+  }
+}
+
+// Resizing an instance changes the load of its fanin drivers and the input
+// slew of its fanouts, so moves on any of them are left for the next pass.
+void RepairSetup::addSizingNeighbors(
+    Instance* inst,
+    std::unordered_set<const Instance*>& touched)
+{
+  touched.insert(inst);
+  InstancePinIterator* pin_iter = network_->pinIterator(inst);
+  while (pin_iter->hasNext()) {
+    const Pin* pin = pin_iter->next();
+    const Net* net = network_->net(pin);
+    if (net == nullptr) {
+      continue;
+    }
+    NetConnectedPinIterator* net_pin_iter = network_->connectedPinIterator(net);
+    while (net_pin_iter->hasNext()) {
+      touched.insert(network_->instance(net_pin_iter->next()));
+    }
+    delete net_pin_iter;
+  }
+  delete pin_iter;
+}
+
+// Drivers of the nets connected to inst, including its own outputs.
+void RepairSetup::addSizingDrvrPins(Instance* inst,
+                                    std::unordered_set<const Pin*>& drvr_pins)
+{
+  InstancePinIterator* pin_iter = network_->pinIterator(inst);
+  while (pin_iter->hasNext()) {
+    const Pin* pin = pin_iter->next();
+    const Net* net = network_->net(pin);
+    if (net == nullptr) {
+      continue;
+    }
+    NetConnectedPinIterator* net_pin_iter = network_->connectedPinIterator(net);
+    while (net_pin_iter->hasNext()) {
+      const Pin* net_pin = net_pin_iter->next();
+      if (network_->isDriver(net_pin)) {
+        drvr_pins.insert(net_pin);
+      }
+    }
+    delete net_pin_iter;
+  }
+  delete pin_iter;
+}
+
+// Return true if drvr_pin is within its max capacitance and max slew limits.
+bool RepairSetup::checkMaxCapSlew(const Pin* drvr_pin)
+{
+  float cap, limit, slack;
+  const Corner* corner;
+  const RiseFall* tr;
+  sta_->checkCapacitance(
+      drvr_pin, nullptr, max_, corner, tr, cap, limit, slack);
+  if (corner && limit > 0.0 && slack < 0.0) {
+    return false;
+  }
+
+  Slew slew;
+  sta_->checkSlew(
+      drvr_pin, nullptr, max_, false, corner, tr, slew, limit, slack);
+  return !(corner && limit > 0.0 && slack < 0.0);
+}
+
 }  // namespace rsz
@@ -64,6 +64,7 @@ using sta::dbSta;
 using sta::DcalcAnalysisPt;
 using sta::Instance;
 using sta::LibertyCell;
+using sta::LibertyCellSeq;
 using sta::LibertyPort;
 using sta::MinMax;
 using sta::Net;
@@ -105,6 +106,20 @@ struct SlackEstimatorParams
     driver_cell = nullptr;
   }
 };
+// Driver upsize candidate scored by repairSetupSpeculative.
+struct SizingMove
+{
+  Instance* drvr;
+  LibertyPort* drvr_port;
+  LibertyPort* in_port;
+  LibertyCellSeq* equiv_cells;
+  float load_cap;
+  float prev_drive;
+  int lib_ap;
+  // Best replacement and its estimated delay improvement (seconds).
+  LibertyCell* cell;
+  float gain;
+};
 struct OptoParams
 {
   int iteration;
@@ -133,9 +148,13 @@ class RepairSetup : public sta::dbStaState
                    bool skip_pin_swap,
                    bool skip_gate_cloning,
                    bool skip_buffering,
-                   bool skip_buffer_removal);
+                   bool skip_buffer_removal,
+                   bool speculative_sizing);
   // For testing.
   void repairSetup(const Pin* end_pin);
+  // For testing. Runs only the speculative sizing passes and returns the
+  // number of instances they resized.
+  int repairSetupSpeculative();
   // For testing.
   void reportSwappablePins();
   // Rebuffer one net (for testing).
@@ -224,6 +243,15 @@ class RepairSetup : public sta::dbStaState
                          int endpt_index,
                          int num_endpts);
   void repairSetupLastGasp(const OptoParams& params, int& num_viols);
+  void repairSetupSpeculative(const OptoParams& params);
+  void findSizingMoves(const vector<Vertex*>& ends,
+                       vector<SizingMove>& moves);
+  void scoreSizingMove(SizingMove& move) const;
+  void addSizingNeighbors(Instance* inst,
+                          std::unordered_set<const Instance*>& touched);
+  void addSizingDrvrPins(Instance* inst,
+                         std::unordered_set<const Pin*>& drvr_pins);
+  bool checkMaxCapSlew(const Pin* drvr_pin);
 
   Logger* logger_ = nullptr;
   dbNetwork* db_network_ = nullptr;
@@ -258,6 +286,9 @@ class RepairSetup : public sta::dbStaState
   static constexpr float inc_fix_rate_threshold_
       = 0.0001;  // default fix rate threshold = 0.01%
   static constexpr int max_last_gasp_passes_ = 10;
+  static constexpr int max_speculative_passes_ = 10;
+  // Worst endpoints whose paths are searched for moves in each pass.
+  static constexpr int speculative_end_count_ = 64;
 };
 
 }  // namespace rsz
@@ -1260,6 +1260,7 @@ void Resizer::resizeSlackPreamble()
   resizePreamble();
   // Save max_wire_length for multiple repairDesign calls.
   max_wire_length_ = findMaxWireLength1();
+  resize_slack_pin_locs_.clear();
 }
 
 // Run repair_design to repair long wires and max slew, capacitance and fanout
@@ -1286,6 +1287,69 @@ void Resizer::findResizeSlacks()
                  removed_buffer_count_);
 }
 
+// Timing driven placement only needs slacks, so instead of repairing the
+// netlist and rolling it back, estimate long wires as if they had been
+// buffered. Nets whose pins have not moved keep their parasitics.
+void Resizer::estimateResizeSlacks()
+{
+  initBlock();
+  if (!wire_signal_cap_.empty()) {
+    sta_->ensureClkNetwork();
+    // Make separate parasitics for each corner, same for min/max.
+    sta_->setParasiticAnalysisPts(true);
+    if (parasitics_src_ != ParasiticsSrc::placement) {
+      resize_slack_pin_locs_.clear();
+    }
+
+    // Rebuilt on every call so nets deleted since the last one are dropped.
+    std::unordered_map<const Net*, vector<Point>> pin_locs;
+    pin_locs.reserve(resize_slack_pin_locs_.size());
+    vector<const Net*> moved_nets;
+    NetIterator* net_iter = network_->netIterator(network_->topInstance());
+    while (net_iter->hasNext()) {
+      Net* net = net_iter->next();
+      vector<Point>& locations = pin_locs[net];
+      netPinLocations(net, locations);
+      auto it = resize_slack_pin_locs_.find(net);
+      if (it == resize_slack_pin_locs_.end() || it->second != locations
+          || parasitics_invalid_.hasKey(net)) {
+        moved_nets.push_back(net);
+      }
+    }
+    delete net_iter;
+    resize_slack_pin_locs_ = std::move(pin_locs);
+    debugPrint(logger_,
+               RSZ,
+               "resize_slacks",
+               1,
+               "{} nets moved",
+               moved_nets.size());
+    estimateWireParasitics(moved_nets, max_wire_length_);
+
+    parasitics_src_ = ParasiticsSrc::placement;
+    parasitics_invalid_.clear();
+  }
+  findResizeSlacks1();
+}
+
+void Resizer::estimateResizeSlacksEnd()
+{
+  if (!resize_slack_pin_locs_.empty()) {
+    resize_slack_pin_locs_.clear();
+    estimateWireParasitics();
+  }
+}
+
+void Resizer::netPinLocations(const Net* net, vector<Point>& locations) const
+{
+  NetConnectedPinIterator* pin_iter = network_->connectedPinIterator(net);
+  while (pin_iter->hasNext()) {
+    const Pin* pin = pin_iter->next();
+    locations.push_back(db_network_->location(pin));
+  }
+  delete pin_iter;
+}
+
 void Resizer::findResizeSlacks1()
 {
   // Use driver pin slacks rather than Sta::netSlack to save visiting
@@ -2752,7 +2816,8 @@ void Resizer::repairSetup(double setup_margin,
                           bool skip_pin_swap,
                           bool skip_gate_cloning,
                           bool skip_buffering,
-                          bool skip_buffer_removal)
+                          bool skip_buffer_removal,
+                          bool speculative_sizing)
 {
   resizePreamble();
   if (parasitics_src_ == ParasiticsSrc::global_routing) {
@@ -2765,7 +2830,8 @@ void Resizer::repairSetup(double setup_margin,
                              skip_pin_swap,
                              skip_gate_cloning,
                              skip_buffering,
-                             skip_buffer_removal);
+                             skip_buffer_removal,
+                             speculative_sizing);
 }
 
 void Resizer::reportSwappablePins()
@@ -2780,6 +2846,12 @@ void Resizer::repairSetup(const Pin* end_pin)
   repair_setup_->repairSetup(end_pin);
 }
 
+int Resizer::repairSetupSpeculative()
+{
+  resizePreamble();
+  return repair_setup_->repairSetupSpeculative();
+}
+
 void Resizer::rebufferNet(const Pin* drvr_pin)
 {
   resizePreamble();
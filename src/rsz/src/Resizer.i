@@ -550,14 +550,16 @@ repair_setup(double setup_margin,
              int max_passes,
              bool verbose,
              bool skip_pin_swap, bool skip_gate_cloning,
-             bool skip_buffering, bool skip_buffer_removal)
+             bool skip_buffering, bool skip_buffer_removal,
+             bool speculative_sizing)
 {
   ensureLinked();
   Resizer *resizer = getResizer();
   resizer->repairSetup(setup_margin, repair_tns_end_percent,
                        max_passes, verbose,
                        skip_pin_swap, skip_gate_cloning,
-                       skip_buffering, skip_buffer_removal);
+                       skip_buffering, skip_buffer_removal,
+                       speculative_sizing);
 }
 
 void
@@ -568,6 +570,14 @@ repair_setup_pin_cmd(Pin *end_pin)
   resizer->repairSetup(end_pin);
 }
 
+int
+repair_setup_speculative_cmd()
+{
+  ensureLinked();
+  Resizer *resizer = getResizer();
+  return resizer->repairSetupSpeculative();
+}
+
 void
 report_swappable_pins_cmd()
 {
@@ -661,6 +671,20 @@ find_resize_slacks()
   resizer->findResizeSlacks();
 }
 
+void
+estimate_resize_slacks()
+{
+  Resizer *resizer = getResizer();
+  resizer->estimateResizeSlacks();
+}
+
+void
+estimate_resize_slacks_end()
+{
+  Resizer *resizer = getResizer();
+  resizer->estimateResizeSlacksEnd();
+}
+
 NetSeq *
 resize_worst_slack_nets()
 {
@@ -521,6 +521,7 @@ sta::define_cmd_args "repair_timing" {[-setup] [-hold]\
                                         [-skip_gate_cloning]\
                                         [-skip_buffering]\
                                         [-skip_buffer_removal]\
+                                        [-speculative_sizing]\
                                         [-repair_tns tns_end_percent]\
                                         [-max_passes passes]\
                                         [-max_buffer_percent buffer_percent]\
@@ -533,7 +534,7 @@ proc repair_timing { args } {
             -libraries -max_utilization -max_buffer_percent \
             -recover_power -repair_tns -max_passes} \
     flags {-setup -hold -allow_setup_violations -skip_pin_swap -skip_gate_cloning \
-           -skip_buffering -skip_buffer_removal -verbose}
+           -skip_buffering -skip_buffer_removal -speculative_sizing -verbose}
 
   set setup [info exists flags(-setup)]
   set hold [info exists flags(-hold)]
@@ -562,6 +563,7 @@ proc repair_timing { args } {
   set skip_gate_cloning [info exists flags(-skip_gate_cloning)]
   set skip_buffering [info exists flags(-skip_buffering)]
   set skip_buffer_removal [info exists flags(-skip_buffer_removal)]
+  set speculative_sizing [info exists flags(-speculative_sizing)]
   rsz::set_max_utilization [rsz::parse_max_util keys]
 
   set max_buffer_percent 20
@@ -602,7 +604,8 @@ proc repair_timing { args } {
     if { $setup } {
       rsz::repair_setup $setup_margin $repair_tns_end_percent $max_passes \
         $verbose \
-        $skip_pin_swap $skip_gate_cloning $skip_buffering $skip_buffer_removal
+        $skip_pin_swap $skip_gate_cloning $skip_buffering $skip_buffer_removal \
+        $speculative_sizing
     }
     if { $hold } {
       rsz::repair_hold $setup_margin $hold_margin \
@@ -679,6 +682,12 @@ proc repair_setup_pin { end_pin } {
   repair_setup_pin_cmd $end_pin
 }
 
+# for testing; returns the number of instances resized
+proc repair_setup_speculative { } {
+  check_parasitics
+  return [repair_setup_speculative_cmd]
+}
+
 proc report_swappable_pins { } {
   report_swappable_pins_cmd
 }
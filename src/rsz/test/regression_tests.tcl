@@ -37,6 +37,7 @@ record_tests {
   repair_design3
   repair_design4
   repair_design5
+  repair_design_threads
   repair_fanout1
   repair_fanout2
   repair_fanout3
@@ -66,6 +67,7 @@ record_tests {
   repair_setup5
   repair_setup6
   repair_setup7
+  repair_setup_speculative
   repair_slew1
   repair_slew2
   repair_slew3
@@ -0,0 +1,19 @@
+# repair_design with buffered nets planned on 4 threads matches 1 thread
+source "helpers.tcl"
+read_liberty Nangate45/Nangate45_typ.lib
+read_lef Nangate45/Nangate45.lef
+read_def gcd_nangate45_placed.def
+read_sdc gcd_nangate45.sdc
+
+source Nangate45/Nangate45.rc
+set_wire_rc -layer metal3
+estimate_parasitics -placement
+
+report_worst_slack
+
+set_dont_use {AOI211_X1 OAI211_X1}
+
+buffer_ports
+
+set_thread_count 4
+repair_design
@@ -0,0 +1,38 @@
+# repair_timing -setup -speculative_sizing must not make tns or the
+# max slew/capacitance limits worse
+source "helpers.tcl"
+read_liberty Nangate45/Nangate45_typ.lib
+read_lef Nangate45/Nangate45.lef
+read_def repair_setup1.def
+create_clock -period 0.3 clk
+
+source Nangate45/Nangate45.rc
+set_wire_rc -layer metal3
+estimate_parasitics -placement
+
+set tns_before [sta::total_negative_slack -max]
+set slew_before [sta::max_slew_violation_count]
+set cap_before [sta::max_capacitance_violation_count]
+
+# The speculative passes alone must resize something without making tns
+# or the limits worse.
+set resized [rsz::repair_setup_speculative]
+set tns_speculative [sta::total_negative_slack -max]
+puts "speculative passes resized instances: [expr $resized > 0]"
+puts "speculative passes tns not worse: [expr $tns_speculative >= $tns_before]"
+puts "speculative passes new slew violations:\
+  [expr [sta::max_slew_violation_count] > $slew_before]"
+puts "speculative passes new cap violations:\
+  [expr [sta::max_capacitance_violation_count] > $cap_before]"
+
+# Only the limits and tns are checked.
+foreach id {40 41 43 49 59 62 94 98 99} {
+  suppress_message RSZ $id
+}
+repair_timing -setup -speculative_sizing
+
+set tns_after [sta::total_negative_slack -max]
+puts "tns not worse: [expr $tns_after >= $tns_before]"
+puts "new slew violations: [expr [sta::max_slew_violation_count] > $slew_before]"
+puts "new cap violations:\
+  [expr [sta::max_capacitance_violation_count] > $cap_before]"
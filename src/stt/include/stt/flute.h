@@ -59,6 +59,9 @@ using stt::Tree;
 // User-Callable Functions
 // Delete LUT tables for exit so they are not leaked.
 void deleteLUT();
+// The LUT is built lazily by the first calls to flute, which is not thread
+// safe. Build all of it before calling flute from several threads.
+void ensureLUT();
 int flute_wl(int d,
              const std::vector<int>& x,
              const std::vector<int>& y,
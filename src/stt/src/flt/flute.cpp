@@ -376,6 +376,11 @@ static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
   lut_valid_d = to_d;
 }
 
+void ensureLUT()
+{
+  ensureLUT(FLUTE_D);
+}
+
 static void ensureLUT(int d)
 {
   if (LUT == nullptr) {
@@ -88,11 +88,15 @@ class FileHandler
   FileHandler(const char* filename, bool binary = false);
   ~FileHandler();
   FILE* getFile();
+  // Closes and removes the partially written file instead of renaming it
+  // into place.
+  void discard();
 
  private:
   std::string filename_;
   std::string tmp_filename_;
   FILE* file_;
+  bool discarded_ = false;
 };
 
 }  // namespace utl
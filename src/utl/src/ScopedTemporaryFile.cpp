@@ -100,8 +100,10 @@ FileHandler::~FileHandler()
     // Any unwritten buffered data are flushed to the OS.
     std::fclose(file_);
   }
-  // If filename_ exists it will be overwritten.
-  fs::rename(tmp_filename_, filename_);
+  if (!discarded_) {
+    // If filename_ exists it will be overwritten.
+    fs::rename(tmp_filename_, filename_);
+  }
 }
 
 FILE* FileHandler::getFile()
@@ -109,4 +111,15 @@ FILE* FileHandler::getFile()
   return file_;
 }
 
+void FileHandler::discard()
+{
+  if (file_) {
+    std::fclose(file_);
+    file_ = nullptr;
+  }
+  std::error_code error;
+  fs::remove(tmp_filename_, error);
+  discarded_ = true;
+}
+
 }  // namespace utl